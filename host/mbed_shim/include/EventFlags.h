@@ -0,0 +1,10 @@
+/**
+ * @file EventFlags.h
+ * @brief Host shim of the mbed-os header of the same name
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#pragma once
+
+#include "mbed_shim/rtos.hpp"
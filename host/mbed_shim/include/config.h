@@ -0,0 +1,8 @@
+/**
+ * @file config.h
+ * @brief Host shim of the generated mbed configuration header, nothing is configured
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#pragma once
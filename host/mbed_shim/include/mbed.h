@@ -0,0 +1,20 @@
+/**
+ * @file mbed.h
+ * @brief Host shim entry point, stands in for the mbed-os umbrella header
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#include "PinNames.h"
+#include "mbed_shim/platform.hpp"
+#include "mbed_shim/rtos.hpp"
+#include "mbed_shim/drivers.hpp"
+
+using namespace mbed;
+using namespace rtos;
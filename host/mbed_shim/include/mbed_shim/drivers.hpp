@@ -0,0 +1,331 @@
+/**
+ * @file drivers.hpp
+ * @brief Host shim of the mbed drivers used by the firmware
+ *
+ * Pins, serial ports and CAN buses are backed by in-process models that the
+ * host side drives through mbed_shim/host.hpp.
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <sys/types.h>
+
+#include "mbed_shim/platform.hpp"
+
+namespace mbed_shim::detail {
+    struct SerialPort;
+    struct CanNode;
+    struct EventToken;
+} // namespace mbed_shim::detail
+
+// HAL types, global like in mbed-os
+enum CANFormat { CANStandard = 0, CANExtended = 1, CANAny = 2 };
+enum CANType { CANData = 0, CANRemote = 1 };
+
+struct CAN_Message {
+    unsigned int id;
+    unsigned char data[8];
+    unsigned char len;
+    CANFormat format;
+    CANType type;
+};
+
+typedef enum {
+    RESET_REASON_POWER_ON,
+    RESET_REASON_PIN_RESET,
+    RESET_REASON_BROWN_OUT,
+    RESET_REASON_SOFTWARE,
+    RESET_REASON_WATCHDOG,
+    RESET_REASON_LOCKUP,
+    RESET_REASON_WAKE_LOW_POWER,
+    RESET_REASON_ACCESS_ERROR,
+    RESET_REASON_BOOT_ERROR,
+    RESET_REASON_MULTIPLE,
+    RESET_REASON_PLATFORM,
+    RESET_REASON_UNKNOWN
+} reset_reason_t;
+
+struct can_s {
+    mbed_shim::detail::CanNode* node;
+};
+typedef struct can_s can_t;
+
+namespace mbed {
+
+    class DigitalOut {
+    public:
+        explicit DigitalOut(PinName pin, int value = 0);
+        void write(int value);
+        int read();
+        int is_connected() { return m_Pin != NC; }
+        DigitalOut& operator=(int value) { write(value); return *this; }
+        DigitalOut& operator=(DigitalOut& rhs) { write(rhs.read()); return *this; }
+        operator int() { return read(); }
+
+    private:
+        PinName m_Pin;
+    };
+
+    class DigitalIn {
+    public:
+        explicit DigitalIn(PinName pin) : m_Pin(pin) {}
+        int read();
+        int is_connected() { return m_Pin != NC; }
+        operator int() { return read(); }
+
+    private:
+        PinName m_Pin;
+    };
+
+    /**
+     * @brief Edge callbacks on a pin, fired when the host changes its level
+     */
+    class InterruptIn {
+    public:
+        explicit InterruptIn(PinName pin);
+        ~InterruptIn();
+        int read();
+        operator int() { return read(); }
+        void rise(Callback<void()> func);
+        void fall(Callback<void()> func);
+
+    private:
+        PinName m_Pin;
+    };
+
+    /**
+     * @brief Normalized analog input, the value is set by the host (0 by default)
+     */
+    class AnalogIn {
+    public:
+        explicit AnalogIn(PinName pin, float vref = 3.3f) : m_Pin(pin), m_Vref(vref) {}
+        float read();
+        unsigned short read_u16() { return static_cast<unsigned short>(read() * 0xFFFF); }
+        float read_voltage() { return read() * m_Vref; }
+        operator float() { return read(); }
+
+    private:
+        PinName m_Pin;
+        float m_Vref;
+    };
+
+    class Timer {
+    public:
+        void start();
+        void stop();
+        void reset();
+        std::chrono::microseconds elapsed_time() const;
+        float read() const { return elapsed_time().count() / 1e6f; }
+        int read_ms() const { return static_cast<int>(elapsed_time().count() / 1000); }
+        int read_us() const { return static_cast<int>(elapsed_time().count()); }
+
+    private:
+        bool m_Running{false};
+        uint64_t m_StartUs{0};
+        uint64_t m_AccumulatedUs{0};
+    };
+
+    /**
+     * @brief Periodic callback in emulated interrupt context
+     *
+     * Keeps its phase like the hardware ticker: every expiry is scheduled one
+     * period after the previous one, not after the callback ran.
+     */
+    class Ticker {
+    public:
+        Ticker() = default;
+        ~Ticker() { detach(); }
+        Ticker(const Ticker&) = delete;
+        Ticker& operator=(const Ticker&) = delete;
+
+        void attach(Callback<void()> func, std::chrono::microseconds period);
+        void attach_us(Callback<void()> func, uint32_t periodUs) {
+            attach(func, std::chrono::microseconds(periodUs));
+        }
+        void detach();
+
+    protected:
+        bool m_OneShot{false};
+
+    private:
+        std::shared_ptr<mbed_shim::detail::EventToken> m_Token;
+        Callback<void()> m_Func;
+        void Schedule(uint64_t dueUs, std::chrono::microseconds period);
+    };
+
+    class Timeout : public Ticker {
+    public:
+        Timeout() { m_OneShot = true; }
+    };
+
+    /**
+     * @brief UART on an in-memory line model
+     *
+     * Bytes written by the firmware leave at the configured baud rate through a
+     * 16 byte TX FIFO (TxIrq fires once it is half empty), bytes sent by the host
+     * arrive in the RX register immediately and raise RxIrq. The port is keyed by
+     * the TX pin; see mbed_shim::SerialWrite and SetSerialTxListener.
+     */
+    class SerialBase {
+    public:
+        enum IrqType { RxIrq = 0, TxIrq, IrqCnt };
+        enum Parity { None = 0, Odd, Even, Forced1, Forced0 };
+
+        void baud(int baudrate);
+        void format(int bits = 8, Parity parity = None, int stop_bits = 1);
+        int readable();
+        int writeable();
+        int writable() { return writeable(); }
+        void attach(Callback<void()> func, IrqType type = RxIrq);
+
+    protected:
+        SerialBase(PinName tx, PinName rx, int baud);
+        virtual ~SerialBase();
+        int _base_getc();
+        int _base_putc(int c);
+        virtual void lock() {}
+        virtual void unlock() {}
+
+        mbed_shim::detail::SerialPort* m_Port;
+    };
+
+    class FileHandle {
+    public:
+        virtual ~FileHandle() = default;
+    };
+
+    class BufferedSerial : private SerialBase, public FileHandle {
+    public:
+        BufferedSerial(PinName tx, PinName rx, int baud = 9600);
+
+        ssize_t read(void* buffer, size_t length);
+        ssize_t write(const void* buffer, size_t length);
+        bool readable() { return SerialBase::readable(); }
+        bool writable() { return SerialBase::writable(); }
+        void set_baud(int baudrate) { SerialBase::baud(baudrate); }
+        void set_format(int bits = 8, Parity parity = None, int stop_bits = 1) {
+            SerialBase::format(bits, parity, stop_bits);
+        }
+        int set_blocking(bool blocking) { m_Blocking = blocking; return 0; }
+        bool is_blocking() const { return m_Blocking; }
+        int sync() { return 0; }
+        void sigio(Callback<void()> func) { SerialBase::attach(func, RxIrq); }
+
+        using SerialBase::None;
+        using SerialBase::Odd;
+        using SerialBase::Even;
+
+    private:
+        bool m_Blocking{true};
+    };
+
+    class UnbufferedSerial : private SerialBase, public FileHandle {
+    public:
+        UnbufferedSerial(PinName tx, PinName rx, int baud = 9600) : SerialBase(tx, rx, baud) {}
+
+        ssize_t read(void* buffer, size_t length);
+        ssize_t write(const void* buffer, size_t length);
+        using SerialBase::attach;
+        using SerialBase::baud;
+        using SerialBase::format;
+        using SerialBase::readable;
+        using SerialBase::writable;
+    };
+
+    class CANMessage : public CAN_Message {
+    public:
+        CANMessage() : CAN_Message{0, {0}, 8, CANStandard, CANData} {}
+        CANMessage(unsigned int _id, const unsigned char* _data, unsigned char _len = 8,
+                   CANType _type = CANData, CANFormat _format = CANStandard);
+        CANMessage(unsigned int _id, CANFormat _format = CANStandard)
+            : CAN_Message{_id, {0}, 0, _format, CANRemote} {}
+    };
+
+    /**
+     * @brief CAN controller attached to an in-process bus keyed by its RD pin
+     *
+     * Three TX mailboxes, one RX FIFO of three frames and hardware acceptance
+     * filters like bxCAN. Frames take their wire time on the shared bus and
+     * are delivered to every other node and host listener when they complete.
+     */
+    class CAN {
+    public:
+        enum Mode { Reset = 0, Normal, Silent, LocalTest, GlobalTest, SilentTest };
+        enum IrqType { RxIrq = 0, TxIrq, EwIrq, DoIrq, WuIrq, EpIrq, AlIrq, BeIrq, IdIrq, IrqCnt };
+
+        CAN(PinName rd, PinName td, int hz = 500000);
+        virtual ~CAN();
+
+        int frequency(int hz);
+        int write(CANMessage msg);
+        int read(CANMessage& msg, int handle = 0);
+        void reset();
+        void monitor(bool silent) { (void)silent; }
+        int mode(Mode mode) { (void)mode; return 1; }
+        int filter(unsigned int id, unsigned int mask, CANFormat format = CANAny, int handle = 0);
+        unsigned char rderror();
+        unsigned char tderror();
+        void attach(Callback<void()> func, IrqType type = RxIrq);
+
+    protected:
+        virtual void lock() { m_Lock.lock(); }
+        virtual void unlock() { m_Lock.unlock(); }
+
+        can_t _can;
+
+    private:
+        std::recursive_mutex m_Lock;
+    };
+
+    /**
+     * @brief Reason of the last reset, POWER_ON unless set with mbed_shim::SetResetReason
+     */
+    class ResetReason {
+    public:
+        static reset_reason_t get();
+        static uint32_t get_raw() { return static_cast<uint32_t>(get()); }
+    };
+
+    /**
+     * @brief Independent watchdog on the shim clock
+     *
+     * Once started it cannot be stopped, like the IWDG. When it goes
+     * timeout_ms without a kick, an emulated interrupt calls NVIC_SystemReset,
+     * so the handler set with mbed_shim::SetResetHandler sees the expiry.
+     */
+    class Watchdog {
+    public:
+        static Watchdog& get_instance();
+
+        bool start(uint32_t timeout_ms);
+        bool stop() { return false; }
+        void kick();
+        bool is_running() const;
+        uint32_t get_timeout() const;
+        uint32_t get_max_timeout() const { return 32768; }
+
+    private:
+        Watchdog() = default;
+        void Check();
+
+        bool m_Running{false};      // under IrqLock
+        uint32_t m_TimeoutMs{0};
+        uint64_t m_LastKickUs{0};
+    };
+
+} // namespace mbed
+
+// HAL calls used by drivers that service the controller from their own ISRs
+extern "C" {
+    int can_write(can_t* obj, CAN_Message msg, int cc);
+    int can_read(can_t* obj, CAN_Message* msg, int handle);
+    unsigned char can_rderror(can_t* obj);
+    unsigned char can_tderror(can_t* obj);
+}
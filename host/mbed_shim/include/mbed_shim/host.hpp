@@ -0,0 +1,99 @@
+/**
+ * @file host.hpp
+ * @brief Host-side access to the shim's pins, serial ports, CAN buses and interrupts
+ *
+ * This is what a simulator or test drives; firmware code never includes it.
+ * Serial ports are identified by their TX pin and CAN buses by their RD pin,
+ * as passed to the driver constructors.
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include "mbed.h"
+
+namespace mbed_shim {
+
+    /**
+     * @brief Run a function in emulated interrupt context
+     * @param func Function to run, with shim interrupts masked for other threads
+     * @param delayUs Delay before it runs
+     */
+    void RaiseIrq(std::function<void()> func, uint32_t delayUs = 0);
+
+    /**
+     * @brief Replace the default NVIC_SystemReset behaviour (log and exit(3))
+     *
+     * The handler must not return, e.g. throw or exit.
+     */
+    void SetResetHandler(std::function<void()> handler);
+
+    /**
+     * @brief What mbed::ResetReason reports, to emulate the boot after a given reset
+     */
+    void SetResetReason(reset_reason_t reason);
+
+    /**
+     * @brief True once mbed::Watchdog expired, e.g. for the reset handler to tell the causes apart
+     */
+    bool HasWatchdogExpired();
+
+    /**
+     * @brief Context switches of the firmware threads with this name, voluntary and not
+     *
+     * Read from the host kernel, so it counts every time the thread blocked or
+     * was preempted. Names are cut to 15 characters; always 0 off Linux.
+     */
+    uint64_t GetThreadContextSwitches(const char* name);
+
+    // Pins
+    void SetPin(PinName pin, int value);     // drive a DigitalIn/InterruptIn, edges fire the callbacks
+    int GetPin(PinName pin);                 // level of a pin, including DigitalOut
+    void SetAnalogIn(PinName pin, float value);
+
+    // Serial ports
+    using SerialListener = std::function<void(const uint8_t* data, size_t len)>;
+
+    /**
+     * @brief Bytes from the remote end into the port's RX register
+     */
+    void SerialWrite(PinName tx, const uint8_t* data, size_t len);
+
+    /**
+     * @brief Called with every byte the firmware transmits, when it leaves the line
+     */
+    void SetSerialTxListener(PinName tx, SerialListener listener);
+
+    /**
+     * @brief Bridge a port to a new pseudo terminal
+     * @return Path of the terminal to open from another process
+     */
+    std::string OpenSerialPty(PinName tx);
+
+    int GetSerialBaud(PinName tx);
+
+    // CAN buses
+    using CanListener = std::function<void(const CANMessage& msg, uint32_t stampUs)>;
+
+    /**
+     * @brief Queue a frame from a simulated node, delivered after its wire time
+     */
+    void CanInject(PinName rd, const CANMessage& msg);
+
+    /**
+     * @brief Called with every frame completed on the bus, from any node
+     */
+    void SetCanListener(PinName rd, CanListener listener);
+
+    /**
+     * @brief Put every controller on the bus into bus-off and raise BeIrq
+     */
+    void CanForceBusOff(PinName rd);
+
+} // namespace mbed_shim
@@ -0,0 +1,162 @@
+/**
+ * @file platform.hpp
+ * @brief Host shim of the mbed platform layer: callbacks, time base, critical sections
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#include "PinNames.h"
+
+using namespace std::chrono_literals;
+
+#define OS_STACK_SIZE       4096
+#define MBED_ALIGN(n)       alignas(n)
+#define MBED_PACKED(s)      s __attribute__((packed))
+#define PACKED              __attribute__((packed))
+#define MBED_UNUSED         __attribute__((unused))
+#define MBED_NOINLINE       __attribute__((noinline))
+#define MBED_NORETURN       [[noreturn]]
+
+// Same values as CMSIS-RTOS2, only used to label threads on the host
+typedef enum {
+    osPriorityNone = 0,
+    osPriorityIdle = 1,
+    osPriorityLow = 8,
+    osPriorityBelowNormal = 16,
+    osPriorityNormal = 24,
+    osPriorityAboveNormal = 32,
+    osPriorityHigh = 40,
+    osPriorityRealtime = 48,
+    osPriorityISR = 56,
+    osPriorityError = -1,
+} osPriority_t;
+typedef osPriority_t osPriority;
+
+typedef int32_t osStatus_t;
+typedef osStatus_t osStatus;
+constexpr osStatus_t osOK = 0;
+constexpr osStatus_t osError = -1;
+constexpr osStatus_t osErrorTimeout = -2;
+constexpr osStatus_t osErrorResource = -3;
+
+constexpr uint32_t osWaitForever = 0xFFFFFFFFU;
+constexpr uint32_t osFlagsWaitAny = 0x00000000U;
+constexpr uint32_t osFlagsWaitAll = 0x00000001U;
+constexpr uint32_t osFlagsNoClear = 0x00000002U;
+constexpr uint32_t osFlagsError = 0x80000000U;
+constexpr uint32_t osFlagsErrorTimeout = 0xFFFFFFFEU;
+constexpr uint32_t osFlagsErrorResource = 0xFFFFFFFDU;
+
+/**
+ * @brief Microseconds since the shim started, wraps like the target's us ticker
+ */
+extern "C" uint32_t us_ticker_read();
+
+/**
+ * @brief Calls the handler set with mbed_shim::SetResetHandler, exits the process by default
+ */
+MBED_NORETURN void NVIC_SystemReset();
+
+extern "C" void core_util_critical_section_enter();
+extern "C" void core_util_critical_section_exit();
+extern "C" bool core_util_are_interrupts_enabled();
+extern "C" bool core_util_is_isr_active();
+
+namespace mbed {
+
+    namespace chrono {
+        using namespace std::chrono;
+    }
+
+    template <typename F>
+    class Callback;
+
+    /**
+     * @brief Callable like mbed::Callback, backed by std::function
+     */
+    template <typename R, typename... ArgTs>
+    class Callback<R(ArgTs...)> {
+    public:
+        Callback() = default;
+        Callback(std::nullptr_t) {}
+        Callback(R (*func)(ArgTs...)) {
+            if (func != nullptr) {
+                m_Func = func;
+            }
+        }
+
+        template <typename T, typename U>
+        Callback(U* obj, R (T::*method)(ArgTs...))
+            : m_Func([obj, method](ArgTs... args) { return (obj->*method)(args...); }) {}
+
+        template <typename T, typename U>
+        Callback(const U* obj, R (T::*method)(ArgTs...) const)
+            : m_Func([obj, method](ArgTs... args) { return (obj->*method)(args...); }) {}
+
+        template <typename F,
+                  typename = std::enable_if_t<!std::is_same<std::decay_t<F>, Callback>::value &&
+                                              std::is_invocable_r<R, F&, ArgTs...>::value>>
+        Callback(F func) : m_Func(std::move(func)) {}
+
+        R call(ArgTs... args) const { return m_Func(args...); }
+        R operator()(ArgTs... args) const { return m_Func(args...); }
+        explicit operator bool() const { return static_cast<bool>(m_Func); }
+
+    private:
+        std::function<R(ArgTs...)> m_Func;
+    };
+
+    template <typename R, typename... ArgTs>
+    Callback<R(ArgTs...)> callback(R (*func)(ArgTs...) = nullptr) {
+        return Callback<R(ArgTs...)>(func);
+    }
+
+    template <typename T, typename U, typename R, typename... ArgTs>
+    Callback<R(ArgTs...)> callback(U* obj, R (T::*method)(ArgTs...)) {
+        return Callback<R(ArgTs...)>(obj, method);
+    }
+
+    template <typename T, typename U, typename R, typename... ArgTs>
+    Callback<R(ArgTs...)> callback(const U* obj, R (T::*method)(ArgTs...) const) {
+        return Callback<R(ArgTs...)>(obj, method);
+    }
+
+    template <typename R, typename... ArgTs>
+    Callback<R(ArgTs...)> callback(const Callback<R(ArgTs...)>& func) {
+        return func;
+    }
+
+    /**
+     * @brief Masks the emulated interrupts of the shim for its lifetime
+     *
+     * Shim "interrupts" (serial, CAN, tickers, pin edges) all run on one
+     * dispatcher thread that holds the same recursive lock, so a critical
+     * section excludes them exactly like masking IRQs on the single core target.
+     */
+    class CriticalSectionLock {
+    public:
+        CriticalSectionLock() { core_util_critical_section_enter(); }
+        ~CriticalSectionLock() { core_util_critical_section_exit(); }
+        CriticalSectionLock(const CriticalSectionLock&) = delete;
+        CriticalSectionLock& operator=(const CriticalSectionLock&) = delete;
+
+        static void enable() { core_util_critical_section_enter(); }
+        static void disable() { core_util_critical_section_exit(); }
+    };
+
+    inline void wait_us(int us) {
+        const uint32_t start = us_ticker_read();
+        while (static_cast<int32_t>(us_ticker_read() - start) < us) {
+        }
+    }
+
+} // namespace mbed
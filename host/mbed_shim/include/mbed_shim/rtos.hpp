@@ -0,0 +1,209 @@
+/**
+ * @file rtos.hpp
+ * @brief Host shim of the mbed RTOS API on std::thread
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "mbed_shim/platform.hpp"
+
+namespace rtos {
+
+    namespace Kernel {
+
+        /**
+         * @brief RTOS tick clock, milliseconds since the shim started
+         */
+        struct Clock {
+            using rep = int64_t;
+            using period = std::milli;
+            using duration = std::chrono::duration<rep, period>;
+            using time_point = std::chrono::time_point<Clock, duration>;
+            using duration_u32 = std::chrono::duration<uint32_t, std::milli>;
+            static constexpr bool is_steady = true;
+            static time_point now();
+        };
+
+        constexpr Clock::duration_u32 wait_for_u32_forever{osWaitForever};
+
+        uint64_t get_ms_count();
+
+    } // namespace Kernel
+
+    namespace detail {
+
+        /**
+         * @brief 31 event flags with blocking waits, shared by EventFlags and thread flags
+         */
+        class FlagGroup {
+        public:
+            uint32_t Set(uint32_t flags);
+            uint32_t Clear(uint32_t flags);
+            uint32_t Get() const;
+            uint32_t Wait(uint32_t flags, bool all, bool clear, std::chrono::milliseconds timeout);
+
+        private:
+            // Shared with the waiters: a static EventFlags is destroyed at exit
+            // while a firmware thread still waits on it, and destroying a waited
+            // on condition variable blocks
+            struct State {
+                std::mutex lock;
+                std::condition_variable changed;
+                uint32_t flags{0};
+            };
+            std::shared_ptr<State> m_State{std::make_shared<State>()};
+        };
+
+        struct ThreadState;
+
+    } // namespace detail
+
+    class EventFlags {
+    public:
+        EventFlags() = default;
+        explicit EventFlags(const char* /*name*/) {}
+
+        uint32_t set(uint32_t flags) { return m_Group.Set(flags); }
+        uint32_t clear(uint32_t flags = 0x7fffffff) { return m_Group.Clear(flags); }
+        uint32_t get() const { return m_Group.Get(); }
+
+        uint32_t wait_any(uint32_t flags = 0, uint32_t millisec = osWaitForever, bool clear = true);
+        uint32_t wait_all(uint32_t flags = 0, uint32_t millisec = osWaitForever, bool clear = true);
+        uint32_t wait_any_for(uint32_t flags, Kernel::Clock::duration rel_time, bool clear = true);
+        uint32_t wait_all_for(uint32_t flags, Kernel::Clock::duration rel_time, bool clear = true);
+
+    private:
+        detail::FlagGroup m_Group;
+    };
+
+    /**
+     * @brief Recursive mutex, like the RTX mutex behind rtos::Mutex
+     */
+    class Mutex {
+    public:
+        Mutex() = default;
+        explicit Mutex(const char* /*name*/) {}
+
+        void lock() { m_Mutex.lock(); }
+        void unlock() { m_Mutex.unlock(); }
+        bool trylock() { return m_Mutex.try_lock(); }
+        bool trylock_for(Kernel::Clock::duration rel_time) { return m_Mutex.try_lock_for(rel_time); }
+
+    private:
+        std::recursive_timed_mutex m_Mutex;
+    };
+
+    class Semaphore {
+    public:
+        explicit Semaphore(int32_t count = 0, uint16_t max_count = 0xFFFF)
+            : m_Count(count), m_MaxCount(max_count) {}
+
+        void acquire();
+        bool try_acquire();
+        bool try_acquire_for(Kernel::Clock::duration rel_time);
+        osStatus release();
+
+    private:
+        std::mutex m_Lock;
+        std::condition_variable m_Changed;
+        int32_t m_Count;
+        uint16_t m_MaxCount;
+    };
+
+    /**
+     * @brief Bounded pointer queue with the rtos::Queue try_* interface
+     */
+    template <typename T, uint32_t queue_sz>
+    class Queue {
+    public:
+        bool empty() const { std::lock_guard<std::mutex> lock(m_Lock); return m_Items.empty(); }
+        bool full() const { std::lock_guard<std::mutex> lock(m_Lock); return m_Items.size() == queue_sz; }
+        uint32_t count() const { std::lock_guard<std::mutex> lock(m_Lock); return m_Items.size(); }
+
+        bool try_put(T* data) {
+            {
+                std::lock_guard<std::mutex> lock(m_Lock);
+                if (m_Items.size() == queue_sz) {
+                    return false;
+                }
+                m_Items.push_back(data);
+            }
+            m_Changed.notify_one();
+            return true;
+        }
+
+        bool try_get(T** data_out) { return try_get_for(Kernel::Clock::duration::zero(), data_out); }
+
+        bool try_get_for(Kernel::Clock::duration rel_time, T** data_out) {
+            std::unique_lock<std::mutex> lock(m_Lock);
+            if (!m_Changed.wait_for(lock, rel_time, [this] { return !m_Items.empty(); })) {
+                return false;
+            }
+            *data_out = m_Items.front();
+            m_Items.pop_front();
+            return true;
+        }
+
+    private:
+        mutable std::mutex m_Lock;
+        std::condition_variable m_Changed;
+        std::deque<T*> m_Items;
+    };
+
+    /**
+     * @brief Thread with the rtos::Thread interface
+     *
+     * Runs on a detached std::thread; priority and stack size are recorded for
+     * reporting only, the host scheduler and stack are used as they are.
+     */
+    class Thread {
+    public:
+        explicit Thread(osPriority priority = osPriorityNormal, uint32_t stack_size = OS_STACK_SIZE,
+                        unsigned char* stack_mem = nullptr, const char* name = nullptr);
+        ~Thread();
+        Thread(const Thread&) = delete;
+        Thread& operator=(const Thread&) = delete;
+
+        osStatus start(mbed::Callback<void()> task);
+        osStatus join();
+        osStatus set_priority(osPriority priority);
+        osPriority get_priority() const;
+        uint32_t flags_set(uint32_t flags);
+        const char* get_name() const;
+        uint32_t stack_size() const;
+        uint32_t free_stack() const;
+        uint32_t used_stack() const;
+        uint32_t max_stack() const;
+        std::thread::id get_id() const;
+
+    private:
+        std::shared_ptr<detail::ThreadState> m_State;
+    };
+
+    namespace ThisThread {
+
+        uint32_t flags_clear(uint32_t flags);
+        uint32_t flags_get();
+        uint32_t flags_wait_all(uint32_t flags, bool clear = true);
+        uint32_t flags_wait_any(uint32_t flags, bool clear = true);
+        uint32_t flags_wait_all_for(uint32_t flags, Kernel::Clock::duration_u32 rel_time, bool clear = true);
+        uint32_t flags_wait_any_for(uint32_t flags, Kernel::Clock::duration_u32 rel_time, bool clear = true);
+        void sleep_for(Kernel::Clock::duration_u32 rel_time);
+        void sleep_until(Kernel::Clock::time_point abs_time);
+        void yield();
+        std::thread::id get_id();
+        const char* get_name();
+
+    } // namespace ThisThread
+
+} // namespace rtos
@@ -0,0 +1,249 @@
+/**
+ * @file can.cpp
+ * @brief Host shim of the CAN driver on an in-process bus
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <vector>
+
+#include "mbed.h"
+#include "mbed_shim/host.hpp"
+#include "shim_detail.hpp"
+
+namespace mbed_shim::detail {
+
+    constexpr int CAN_TX_MAILBOXES = 3;
+    constexpr size_t CAN_RX_FIFO_SIZE = 3;
+    constexpr int CAN_FILTER_COUNT = 14;
+
+    struct CanBus;
+
+    // Everything is guarded by IrqLock
+    struct CanNode {
+        struct Filter {
+            bool enabled;
+            unsigned int id;
+            unsigned int mask;
+            CANFormat format;
+        };
+
+        CanBus* bus;
+        int busyMailboxes{0};
+        std::deque<CAN_Message> fifo;
+        mbed::Callback<void()> irqs[mbed::CAN::IrqCnt];
+        Filter filters[CAN_FILTER_COUNT]{};
+        bool busOff{false};
+        uint8_t rxErrors{0};
+
+        explicit CanNode(CanBus* owner) : bus(owner) {
+            filters[0] = Filter{true, 0, 0, CANAny}; // accept all until configured
+        }
+
+        bool Accepts(const CAN_Message& msg) const {
+            for (const Filter& filter : filters) {
+                if (filter.enabled &&
+                    (filter.format == CANAny || filter.format == msg.format) &&
+                    (msg.id & filter.mask) == (filter.id & filter.mask)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void Raise(mbed::CAN::IrqType type) {
+            if (irqs[type]) {
+                irqs[type]();
+            }
+        }
+    };
+
+    struct CanBus {
+        int bitrate{500000};
+        double freeAtUs{0.0};
+        std::vector<CanNode*> nodes;
+        CanListener listener;
+
+        // Nominal frame length without bit stuffing, plus the 3 bit intermission
+        double GetFrameUs(const CAN_Message& msg) const {
+            const int bits = (msg.format == CANExtended ? 67 : 47) + 8 * msg.len;
+            return bits * 1e6 / bitrate;
+        }
+
+        void Transmit(CanNode* sender, const CAN_Message& msg) {
+            // Frames go out in request order; arbitration by ID is not modelled
+            const double startUs = std::max(freeAtUs, static_cast<double>(NowUs()));
+            freeAtUs = startUs + GetFrameUs(msg);
+            ScheduleIrq(static_cast<uint64_t>(freeAtUs), [this, sender, msg] { Complete(sender, msg); });
+        }
+
+        void Complete(CanNode* sender, const CAN_Message& msg) {
+            const uint32_t stampUs = static_cast<uint32_t>(NowUs());
+            for (CanNode* node : nodes) {
+                if (node == sender || node->busOff || !node->Accepts(msg)) {
+                    continue;
+                }
+                if (node->fifo.size() == CAN_RX_FIFO_SIZE) {
+                    node->rxErrors++; // overrun, the new frame is lost
+                    continue;
+                }
+                node->fifo.push_back(msg);
+                node->Raise(mbed::CAN::RxIrq);
+            }
+            if (listener) {
+                listener(static_cast<const CANMessage&>(msg), stampUs);
+            }
+            if (sender != nullptr && std::find(nodes.begin(), nodes.end(), sender) != nodes.end()) {
+                sender->busyMailboxes = std::max(sender->busyMailboxes - 1, 0);
+                sender->Raise(mbed::CAN::TxIrq);
+            }
+        }
+    };
+
+    static CanBus& GetCanBus(PinName rd) {
+        static auto* buses = new std::map<int, CanBus*>();
+        std::lock_guard<std::recursive_mutex> lock(IrqLock());
+        CanBus*& bus = (*buses)[rd];
+        if (bus == nullptr) {
+            bus = new CanBus();
+        }
+        return *bus;
+    }
+
+} // namespace mbed_shim::detail
+
+namespace mbed_shim {
+
+    using detail::GetCanBus;
+    using detail::IrqLock;
+
+    void CanInject(PinName rd, const CANMessage& msg) {
+        detail::CanBus& bus = GetCanBus(rd);
+        std::lock_guard<std::recursive_mutex> lock(IrqLock());
+        bus.Transmit(nullptr, msg);
+    }
+
+    void SetCanListener(PinName rd, CanListener listener) {
+        detail::CanBus& bus = GetCanBus(rd);
+        std::lock_guard<std::recursive_mutex> lock(IrqLock());
+        bus.listener = std::move(listener);
+    }
+
+    void CanForceBusOff(PinName rd) {
+        detail::CanBus& bus = GetCanBus(rd);
+        RaiseIrq([&bus] {
+            for (detail::CanNode* node : bus.nodes) {
+                node->busOff = true;
+                node->Raise(CAN::BeIrq);
+            }
+        });
+    }
+
+} // namespace mbed_shim
+
+extern "C" int can_write(can_t* obj, CAN_Message msg, int /*cc*/) {
+    std::lock_guard<std::recursive_mutex> lock(mbed_shim::detail::IrqLock());
+    mbed_shim::detail::CanNode* node = obj->node;
+    if (node->busOff || node->busyMailboxes >= mbed_shim::detail::CAN_TX_MAILBOXES) {
+        return 0;
+    }
+    node->busyMailboxes++;
+    node->bus->Transmit(node, msg);
+    return 1;
+}
+
+extern "C" int can_read(can_t* obj, CAN_Message* msg, int /*handle*/) {
+    std::lock_guard<std::recursive_mutex> lock(mbed_shim::detail::IrqLock());
+    mbed_shim::detail::CanNode* node = obj->node;
+    if (node->fifo.empty()) {
+        return 0;
+    }
+    *msg = node->fifo.front();
+    node->fifo.pop_front();
+    return 1;
+}
+
+extern "C" unsigned char can_rderror(can_t* obj) {
+    std::lock_guard<std::recursive_mutex> lock(mbed_shim::detail::IrqLock());
+    return obj->node->rxErrors;
+}
+
+extern "C" unsigned char can_tderror(can_t* obj) {
+    std::lock_guard<std::recursive_mutex> lock(mbed_shim::detail::IrqLock());
+    return obj->node->busOff ? 255 : 0;
+}
+
+namespace mbed {
+
+    using mbed_shim::detail::IrqLock;
+
+    CANMessage::CANMessage(unsigned int _id, const unsigned char* _data, unsigned char _len,
+                           CANType _type, CANFormat _format)
+        : CAN_Message{_id, {0}, static_cast<unsigned char>(_len > 8 ? 8 : _len), _format, _type}
+    {
+        memcpy(data, _data, len);
+    }
+
+    CAN::CAN(PinName rd, PinName /*td*/, int hz) {
+        mbed_shim::detail::CanBus& bus = mbed_shim::detail::GetCanBus(rd);
+        std::lock_guard<std::recursive_mutex> lock(IrqLock());
+        _can.node = new mbed_shim::detail::CanNode(&bus);
+        bus.nodes.push_back(_can.node);
+        bus.bitrate = hz;
+    }
+
+    CAN::~CAN() {
+        std::lock_guard<std::recursive_mutex> lock(IrqLock());
+        auto& nodes = _can.node->bus->nodes;
+        nodes.erase(std::remove(nodes.begin(), nodes.end(), _can.node), nodes.end());
+        // In-flight frames may still reference the node, so it is never freed
+    }
+
+    int CAN::frequency(int hz) {
+        std::lock_guard<std::recursive_mutex> lock(IrqLock());
+        _can.node->bus->bitrate = hz;
+        return 1;
+    }
+
+    int CAN::write(CANMessage msg) {
+        return can_write(&_can, msg, 0);
+    }
+
+    int CAN::read(CANMessage& msg, int handle) {
+        return can_read(&_can, &msg, handle);
+    }
+
+    void CAN::reset() {
+        std::lock_guard<std::recursive_mutex> lock(IrqLock());
+        _can.node->busOff = false;
+        _can.node->fifo.clear();
+        _can.node->rxErrors = 0;
+    }
+
+    int CAN::filter(unsigned int id, unsigned int mask, CANFormat format, int handle) {
+        if (handle < 0 || handle >= mbed_shim::detail::CAN_FILTER_COUNT) {
+            return 0;
+        }
+        std::lock_guard<std::recursive_mutex> lock(IrqLock());
+        _can.node->filters[handle] = mbed_shim::detail::CanNode::Filter{true, id, mask, format};
+        return handle;
+    }
+
+    unsigned char CAN::rderror() {
+        return can_rderror(&_can);
+    }
+
+    unsigned char CAN::tderror() {
+        return can_tderror(&_can);
+    }
+
+    void CAN::attach(Callback<void()> func, IrqType type) {
+        std::lock_guard<std::recursive_mutex> lock(IrqLock());
+        _can.node->irqs[type] = func;
+    }
+
+} // namespace mbed
@@ -0,0 +1,174 @@
+/**
+ * @file gpio_timer.cpp
+ * @brief Host shim of the pin and timer drivers
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#include <map>
+
+#include "mbed.h"
+#include "mbed_shim/host.hpp"
+#include "shim_detail.hpp"
+
+namespace mbed_shim::detail {
+
+    namespace {
+
+        struct PinState {
+            int level{0};
+            float analog{0.0f};
+            mbed::Callback<void()> rise;
+            mbed::Callback<void()> fall;
+        };
+
+        // Guarded by IrqLock, edge callbacks run in interrupt context anyway
+        std::map<int, PinState>& GetPins() {
+            static auto* pins = new std::map<int, PinState>();
+            return *pins;
+        }
+
+    } // namespace
+
+} // namespace mbed_shim::detail
+
+namespace mbed_shim {
+
+    using detail::GetPins;
+    using detail::IrqLock;
+
+    void SetPin(PinName pin, int value) {
+        RaiseIrq([pin, value] {
+            detail::PinState& state = GetPins()[pin];
+            const int previous = state.level;
+            state.level = value ? 1 : 0;
+            if (!previous && state.level && state.rise) {
+                state.rise();
+            } else if (previous && !state.level && state.fall) {
+                state.fall();
+            }
+        });
+    }
+
+    int GetPin(PinName pin) {
+        std::lock_guard<std::recursive_mutex> lock(IrqLock());
+        return GetPins()[pin].level;
+    }
+
+    void SetAnalogIn(PinName pin, float value) {
+        std::lock_guard<std::recursive_mutex> lock(IrqLock());
+        GetPins()[pin].analog = value;
+    }
+
+} // namespace mbed_shim
+
+namespace mbed {
+
+    using mbed_shim::detail::GetPins;
+    using mbed_shim::detail::IrqLock;
+
+    DigitalOut::DigitalOut(PinName pin, int value) : m_Pin(pin) {
+        write(value);
+    }
+
+    void DigitalOut::write(int value) {
+        std::lock_guard<std::recursive_mutex> lock(IrqLock());
+        GetPins()[m_Pin].level = value ? 1 : 0;
+    }
+
+    int DigitalOut::read() {
+        return mbed_shim::GetPin(m_Pin);
+    }
+
+    int DigitalIn::read() {
+        return mbed_shim::GetPin(m_Pin);
+    }
+
+    InterruptIn::InterruptIn(PinName pin) : m_Pin(pin) {
+    }
+
+    InterruptIn::~InterruptIn() {
+        rise(nullptr);
+        fall(nullptr);
+    }
+
+    int InterruptIn::read() {
+        return mbed_shim::GetPin(m_Pin);
+    }
+
+    void InterruptIn::rise(Callback<void()> func) {
+        std::lock_guard<std::recursive_mutex> lock(IrqLock());
+        GetPins()[m_Pin].rise = func;
+    }
+
+    void InterruptIn::fall(Callback<void()> func) {
+        std::lock_guard<std::recursive_mutex> lock(IrqLock());
+        GetPins()[m_Pin].fall = func;
+    }
+
+    float AnalogIn::read() {
+        std::lock_guard<std::recursive_mutex> lock(IrqLock());
+        return GetPins()[m_Pin].analog;
+    }
+
+    void Timer::start() {
+        if (!m_Running) {
+            m_StartUs = mbed_shim::detail::NowUs();
+            m_Running = true;
+        }
+    }
+
+    void Timer::stop() {
+        if (m_Running) {
+            m_AccumulatedUs += mbed_shim::detail::NowUs() - m_StartUs;
+            m_Running = false;
+        }
+    }
+
+    void Timer::reset() {
+        m_StartUs = mbed_shim::detail::NowUs();
+        m_AccumulatedUs = 0;
+    }
+
+    std::chrono::microseconds Timer::elapsed_time() const {
+        uint64_t elapsedUs = m_AccumulatedUs;
+        if (m_Running) {
+            elapsedUs += mbed_shim::detail::NowUs() - m_StartUs;
+        }
+        return std::chrono::microseconds(elapsedUs);
+    }
+
+    void Ticker::attach(Callback<void()> func, std::chrono::microseconds period) {
+        std::lock_guard<std::recursive_mutex> lock(IrqLock());
+        detach();
+        m_Token = std::make_shared<mbed_shim::detail::EventToken>();
+        m_Func = func;
+        Schedule(mbed_shim::detail::NowUs() + period.count(), period);
+    }
+
+    void Ticker::detach() {
+        std::lock_guard<std::recursive_mutex> lock(IrqLock());
+        if (m_Token) {
+            m_Token->active = false;
+            m_Token.reset();
+        }
+    }
+
+    void Ticker::Schedule(uint64_t dueUs, std::chrono::microseconds period) {
+        mbed_shim::detail::ScheduleIrq(dueUs, [this, token = m_Token, dueUs, period] {
+            if (!token->active) {
+                return;
+            }
+            // The callback may re-attach, which replaces m_Func
+            const Callback<void()> func = m_Func;
+            if (m_OneShot) {
+                token->active = false;
+                m_Token.reset();
+            } else {
+                Schedule(dueUs + period.count(), period);
+            }
+            func();
+        });
+    }
+
+} // namespace mbed
@@ -0,0 +1,152 @@
+/**
+ * @file platform.cpp
+ * @brief Host shim time base, emulated interrupt dispatcher and reset
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "mbed.h"
+#include "mbed_shim/host.hpp"
+#include "shim_detail.hpp"
+
+namespace mbed_shim::detail {
+
+    namespace {
+
+        struct PendingIrq {
+            uint64_t dueUs;
+            uint64_t order;
+            std::function<void()> func;
+
+            bool operator>(const PendingIrq& other) const {
+                return dueUs != other.dueUs ? dueUs > other.dueUs : order > other.order;
+            }
+        };
+
+        // Everything the dispatcher thread touches is leaked on purpose, so
+        // static destruction at exit never pulls state out from under it
+        struct IrqDispatcher {
+            std::mutex lock;
+            std::condition_variable changed;
+            std::priority_queue<PendingIrq, std::vector<PendingIrq>, std::greater<PendingIrq>> pending;
+            uint64_t nextOrder{0};
+
+            IrqDispatcher() { std::thread(&IrqDispatcher::Run, this).detach(); }
+
+            void Run() {
+                std::unique_lock<std::mutex> queueLock(lock);
+                while (true) {
+                    if (pending.empty()) {
+                        changed.wait(queueLock);
+                        continue;
+                    }
+                    const uint64_t now = NowUs();
+                    if (pending.top().dueUs > now) {
+                        changed.wait_for(queueLock, std::chrono::microseconds(pending.top().dueUs - now));
+                        continue;
+                    }
+                    std::function<void()> func = std::move(const_cast<PendingIrq&>(pending.top()).func);
+                    pending.pop();
+                    queueLock.unlock();
+                    {
+                        std::lock_guard<std::recursive_mutex> irqLock(IrqLock());
+                        s_InIsr = true;
+                        func();
+                        s_InIsr = false;
+                    }
+                    queueLock.lock();
+                }
+            }
+
+            static thread_local bool s_InIsr;
+        };
+
+        thread_local bool IrqDispatcher::s_InIsr = false;
+
+        IrqDispatcher& GetDispatcher() {
+            static IrqDispatcher* dispatcher = new IrqDispatcher();
+            return *dispatcher;
+        }
+
+        std::function<void()>& GetResetHandler() {
+            static auto* handler = new std::function<void()>();
+            return *handler;
+        }
+
+    } // namespace
+
+    uint64_t NowUs() {
+        static const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - startTime).count();
+    }
+
+    std::recursive_mutex& IrqLock() {
+        static auto* irqLock = new std::recursive_mutex();
+        return *irqLock;
+    }
+
+    void ScheduleIrq(uint64_t dueUs, std::function<void()> func) {
+        IrqDispatcher& dispatcher = GetDispatcher();
+        {
+            std::lock_guard<std::mutex> queueLock(dispatcher.lock);
+            dispatcher.pending.push(PendingIrq{dueUs, dispatcher.nextOrder++, std::move(func)});
+        }
+        dispatcher.changed.notify_one();
+    }
+
+    bool IsIsrActive() {
+        return IrqDispatcher::s_InIsr;
+    }
+
+} // namespace mbed_shim::detail
+
+namespace mbed_shim {
+
+    void RaiseIrq(std::function<void()> func, uint32_t delayUs) {
+        detail::ScheduleIrq(detail::NowUs() + delayUs, std::move(func));
+    }
+
+    void SetResetHandler(std::function<void()> handler) {
+        detail::GetResetHandler() = std::move(handler);
+    }
+
+} // namespace mbed_shim
+
+extern "C" uint32_t us_ticker_read() {
+    return static_cast<uint32_t>(mbed_shim::detail::NowUs());
+}
+
+void NVIC_SystemReset() {
+    const std::function<void()>& handler = mbed_shim::detail::GetResetHandler();
+    if (handler) {
+        handler();
+    }
+    fprintf(stderr, "[mbed_shim] NVIC_SystemReset\n");
+    fflush(stdout);
+    std::_Exit(3);
+}
+
+extern "C" void core_util_critical_section_enter() {
+    mbed_shim::detail::IrqLock().lock();
+}
+
+extern "C" void core_util_critical_section_exit() {
+    mbed_shim::detail::IrqLock().unlock();
+}
+
+extern "C" bool core_util_are_interrupts_enabled() {
+    return true;
+}
+
+extern "C" bool core_util_is_isr_active() {
+    return mbed_shim::detail::IsIsrActive();
+}
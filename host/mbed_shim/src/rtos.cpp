@@ -0,0 +1,324 @@
+/**
+ * @file rtos.cpp
+ * @brief Host shim of the mbed RTOS API
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#include <fstream>
+#include <string>
+
+#ifdef __linux__
+#include <dirent.h>
+#include <pthread.h>
+#endif
+
+#include "mbed.h"
+#include "mbed_shim/host.hpp"
+#include "shim_detail.hpp"
+
+namespace rtos {
+
+    namespace Kernel {
+
+        Clock::time_point Clock::now() {
+            return time_point(duration(static_cast<rep>(mbed_shim::detail::NowUs() / 1000)));
+        }
+
+        uint64_t get_ms_count() {
+            return mbed_shim::detail::NowUs() / 1000;
+        }
+
+    } // namespace Kernel
+
+    namespace detail {
+
+        uint32_t FlagGroup::Set(uint32_t flags) {
+            uint32_t result;
+            {
+                std::lock_guard<std::mutex> lock(m_State->lock);
+                m_State->flags |= flags & 0x7FFFFFFF;
+                result = m_State->flags;
+            }
+            m_State->changed.notify_all();
+            return result;
+        }
+
+        uint32_t FlagGroup::Clear(uint32_t flags) {
+            std::lock_guard<std::mutex> lock(m_State->lock);
+            const uint32_t previous = m_State->flags;
+            m_State->flags &= ~flags;
+            return previous;
+        }
+
+        uint32_t FlagGroup::Get() const {
+            std::lock_guard<std::mutex> lock(m_State->lock);
+            return m_State->flags;
+        }
+
+        uint32_t FlagGroup::Wait(uint32_t flags, bool all, bool clear, std::chrono::milliseconds timeout) {
+            const std::shared_ptr<State> state = m_State;
+            std::unique_lock<std::mutex> lock(state->lock);
+            // Like RTX, 0 means "any flag" for wait_any
+            const uint32_t wanted = (flags == 0) ? 0x7FFFFFFF : flags;
+            auto satisfied = [&] {
+                return all ? (state->flags & wanted) == wanted : (state->flags & wanted) != 0;
+            };
+
+            if (timeout.count() == osWaitForever) {
+                state->changed.wait(lock, satisfied);
+            } else if (!state->changed.wait_for(lock, timeout, satisfied)) {
+                return (timeout.count() == 0) ? osFlagsErrorResource : osFlagsErrorTimeout;
+            }
+
+            const uint32_t result = state->flags;
+            if (clear) {
+                state->flags &= ~wanted;
+            }
+            return result;
+        }
+
+        struct ThreadState {
+            FlagGroup flags;
+            osPriority priority;
+            uint32_t stackSize;
+            std::string name;
+            mbed::Callback<void()> task;
+            std::thread::id id;
+            std::mutex doneLock;
+            std::condition_variable doneChanged;
+            bool started{false};
+            bool done{false};
+        };
+
+        // Flags of a thread not created through rtos::Thread, e.g. main
+        static thread_local std::shared_ptr<ThreadState> s_Current;
+
+        static ThreadState& GetCurrent() {
+            if (!s_Current) {
+                s_Current = std::make_shared<ThreadState>();
+                s_Current->priority = osPriorityNormal;
+                s_Current->stackSize = 0;
+                s_Current->name = "main";
+                s_Current->id = std::this_thread::get_id();
+            }
+            return *s_Current;
+        }
+
+    } // namespace detail
+
+    uint32_t EventFlags::wait_any(uint32_t flags, uint32_t millisec, bool clear) {
+        return m_Group.Wait(flags, false, clear, std::chrono::milliseconds(millisec));
+    }
+
+    uint32_t EventFlags::wait_all(uint32_t flags, uint32_t millisec, bool clear) {
+        return m_Group.Wait(flags, true, clear, std::chrono::milliseconds(millisec));
+    }
+
+    uint32_t EventFlags::wait_any_for(uint32_t flags, Kernel::Clock::duration rel_time, bool clear) {
+        return m_Group.Wait(flags, false, clear, rel_time);
+    }
+
+    uint32_t EventFlags::wait_all_for(uint32_t flags, Kernel::Clock::duration rel_time, bool clear) {
+        return m_Group.Wait(flags, true, clear, rel_time);
+    }
+
+    void Semaphore::acquire() {
+        std::unique_lock<std::mutex> lock(m_Lock);
+        m_Changed.wait(lock, [this] { return m_Count > 0; });
+        m_Count--;
+    }
+
+    bool Semaphore::try_acquire() {
+        return try_acquire_for(Kernel::Clock::duration::zero());
+    }
+
+    bool Semaphore::try_acquire_for(Kernel::Clock::duration rel_time) {
+        std::unique_lock<std::mutex> lock(m_Lock);
+        if (!m_Changed.wait_for(lock, rel_time, [this] { return m_Count > 0; })) {
+            return false;
+        }
+        m_Count--;
+        return true;
+    }
+
+    osStatus Semaphore::release() {
+        {
+            std::lock_guard<std::mutex> lock(m_Lock);
+            if (m_Count >= m_MaxCount) {
+                return osErrorResource;
+            }
+            m_Count++;
+        }
+        m_Changed.notify_one();
+        return osOK;
+    }
+
+    Thread::Thread(osPriority priority, uint32_t stack_size, unsigned char* /*stack_mem*/, const char* name)
+        : m_State(std::make_shared<detail::ThreadState>())
+    {
+        m_State->priority = priority;
+        m_State->stackSize = stack_size;
+        m_State->name = (name != nullptr) ? name : "";
+    }
+
+    Thread::~Thread() {
+        // A host thread cannot be killed; it keeps its state alive and runs on
+        // until the process exits, firmware threads never return anyway
+    }
+
+    osStatus Thread::start(mbed::Callback<void()> task) {
+        if (m_State->started) {
+            return osErrorResource;
+        }
+        m_State->started = true;
+        m_State->task = task;
+
+        std::thread thread([state = m_State] {
+            detail::s_Current = state;
+#ifdef __linux__
+            // Shows in top and gdb, and lets GetThreadContextSwitches find the thread
+            pthread_setname_np(pthread_self(), state->name.substr(0, 15).c_str());
+#endif
+            state->task();
+            std::lock_guard<std::mutex> lock(state->doneLock);
+            state->done = true;
+            state->doneChanged.notify_all();
+        });
+        m_State->id = thread.get_id();
+        thread.detach();
+        return osOK;
+    }
+
+    osStatus Thread::join() {
+        std::unique_lock<std::mutex> lock(m_State->doneLock);
+        m_State->doneChanged.wait(lock, [this] { return m_State->done; });
+        return osOK;
+    }
+
+    osStatus Thread::set_priority(osPriority priority) {
+        m_State->priority = priority;
+        return osOK;
+    }
+
+    osPriority Thread::get_priority() const {
+        return m_State->priority;
+    }
+
+    uint32_t Thread::flags_set(uint32_t flags) {
+        return m_State->flags.Set(flags);
+    }
+
+    const char* Thread::get_name() const {
+        return m_State->name.c_str();
+    }
+
+    // Host stacks are not the target's, so only the configured size is known
+    uint32_t Thread::stack_size() const {
+        return m_State->stackSize;
+    }
+
+    uint32_t Thread::free_stack() const {
+        return m_State->stackSize;
+    }
+
+    uint32_t Thread::used_stack() const {
+        return 0;
+    }
+
+    uint32_t Thread::max_stack() const {
+        return 0;
+    }
+
+    std::thread::id Thread::get_id() const {
+        return m_State->id;
+    }
+
+    namespace ThisThread {
+
+        uint32_t flags_clear(uint32_t flags) {
+            return detail::GetCurrent().flags.Clear(flags);
+        }
+
+        uint32_t flags_get() {
+            return detail::GetCurrent().flags.Get();
+        }
+
+        uint32_t flags_wait_all(uint32_t flags, bool clear) {
+            return detail::GetCurrent().flags.Wait(flags, true, clear, std::chrono::milliseconds(osWaitForever));
+        }
+
+        uint32_t flags_wait_any(uint32_t flags, bool clear) {
+            return detail::GetCurrent().flags.Wait(flags, false, clear, std::chrono::milliseconds(osWaitForever));
+        }
+
+        uint32_t flags_wait_all_for(uint32_t flags, Kernel::Clock::duration_u32 rel_time, bool clear) {
+            return detail::GetCurrent().flags.Wait(flags, true, clear, rel_time);
+        }
+
+        uint32_t flags_wait_any_for(uint32_t flags, Kernel::Clock::duration_u32 rel_time, bool clear) {
+            return detail::GetCurrent().flags.Wait(flags, false, clear, rel_time);
+        }
+
+        void sleep_for(Kernel::Clock::duration_u32 rel_time) {
+            std::this_thread::sleep_for(rel_time);
+        }
+
+        void sleep_until(Kernel::Clock::time_point abs_time) {
+            const Kernel::Clock::duration remaining = abs_time - Kernel::Clock::now();
+            if (remaining.count() > 0) {
+                std::this_thread::sleep_for(remaining);
+            }
+        }
+
+        void yield() {
+            std::this_thread::yield();
+        }
+
+        std::thread::id get_id() {
+            return std::this_thread::get_id();
+        }
+
+        const char* get_name() {
+            return detail::GetCurrent().name.c_str();
+        }
+
+    } // namespace ThisThread
+
+} // namespace rtos
+
+namespace mbed_shim {
+
+    uint64_t GetThreadContextSwitches(const char* name) {
+        uint64_t switches = 0;
+#ifdef __linux__
+        const std::string comm = std::string(name).substr(0, 15);
+        DIR* tasks = opendir("/proc/self/task");
+        if (tasks == nullptr) {
+            return 0;
+        }
+        while (dirent* entry = readdir(tasks)) {
+            const std::string task = std::string("/proc/self/task/") + entry->d_name;
+            std::string taskName;
+            std::ifstream commFile(task + "/comm");
+            if (!std::getline(commFile, taskName) || taskName != comm) {
+                continue;
+            }
+            std::ifstream status(task + "/status");
+            std::string line;
+            while (std::getline(status, line)) {
+                // voluntary_ctxt_switches and nonvoluntary_ctxt_switches
+                const size_t colon = line.find(':');
+                if (line.find("ctxt_switches") != std::string::npos && colon != std::string::npos) {
+                    switches += std::stoull(line.substr(colon + 1));
+                }
+            }
+        }
+        closedir(tasks);
+#else
+        (void)name;
+#endif
+        return switches;
+    }
+
+} // namespace mbed_shim
@@ -0,0 +1,304 @@
+/**
+ * @file serial.cpp
+ * @brief Host shim of the serial drivers on an in-memory line model
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <deque>
+#include <fcntl.h>
+#include <map>
+#include <termios.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "mbed.h"
+#include "mbed_shim/host.hpp"
+#include "shim_detail.hpp"
+
+namespace mbed_shim::detail {
+
+    constexpr size_t SERIAL_TX_FIFO_SIZE = 16; // STM32H7 USART FIFO
+    constexpr int SERIAL_DEFAULT_BAUD = 9600;
+
+    // Everything is guarded by IrqLock
+    struct SerialPort {
+        int baud{SERIAL_DEFAULT_BAUD};
+        std::deque<uint8_t> rx;
+        mbed::Callback<void()> rxIrq;
+        mbed::Callback<void()> txIrq;
+        bool txServiceScheduled{false};
+
+        // Transmit line: bytes leave one byte time apart (8N1)
+        double txFreeAtUs{0.0};
+        struct TxByte {
+            uint64_t doneUs;
+            uint8_t value;
+        };
+        std::deque<TxByte> onLine;
+        bool deliveryScheduled{false};
+        SerialListener listener;
+        int ptyFd{-1};
+
+        double GetByteUs() const { return 10e6 / baud; }
+
+        size_t GetTxFifoLevel() const {
+            const double pendingUs = txFreeAtUs - static_cast<double>(NowUs());
+            return pendingUs > 0.0 ? static_cast<size_t>(std::ceil(pendingUs / GetByteUs())) : 0;
+        }
+
+        void Putc(uint8_t value) {
+            const double startUs = std::max(txFreeAtUs, static_cast<double>(NowUs()));
+            txFreeAtUs = startUs + GetByteUs();
+            onLine.push_back(TxByte{static_cast<uint64_t>(txFreeAtUs), value});
+            if (!deliveryScheduled) {
+                deliveryScheduled = true;
+                ScheduleIrq(onLine.front().doneUs, [this] { Deliver(); });
+            }
+        }
+
+        void Deliver() {
+            std::vector<uint8_t> done;
+            const uint64_t now = NowUs();
+            while (!onLine.empty() && onLine.front().doneUs <= now) {
+                done.push_back(onLine.front().value);
+                onLine.pop_front();
+            }
+            if (!done.empty()) {
+                if (listener) {
+                    listener(done.data(), done.size());
+                }
+                if (ptyFd >= 0 && write(ptyFd, done.data(), done.size()) < 0) {
+                    // Nobody has the terminal open, the bytes are lost like on a loose wire
+                }
+            }
+
+            deliveryScheduled = !onLine.empty();
+            if (deliveryScheduled) {
+                ScheduleIrq(onLine.front().doneUs, [this] { Deliver(); });
+            }
+        }
+
+        void ScheduleTxService(uint64_t dueUs) {
+            if (!txServiceScheduled) {
+                txServiceScheduled = true;
+                ScheduleIrq(dueUs, [this] { ServiceTx(); });
+            }
+        }
+
+        // Level-triggered like the TXE/TXFT interrupt: fires while enabled and
+        // the FIFO has room
+        void ServiceTx() {
+            txServiceScheduled = false;
+            if (!txIrq) {
+                return;
+            }
+            txIrq();
+            if (!txIrq) {
+                return;
+            }
+            const double halfEmptyUs = txFreeAtUs - GetByteUs() * SERIAL_TX_FIFO_SIZE / 2;
+            const double nextUs = std::max(halfEmptyUs, static_cast<double>(NowUs()) + GetByteUs());
+            ScheduleTxService(static_cast<uint64_t>(nextUs));
+        }
+    };
+
+    static SerialPort& GetSerialPort(PinName tx) {
+        static auto* ports = new std::map<int, SerialPort*>();
+        std::lock_guard<std::recursive_mutex> lock(IrqLock());
+        SerialPort*& port = (*ports)[tx];
+        if (port == nullptr) {
+            port = new SerialPort();
+        }
+        return *port;
+    }
+
+} // namespace mbed_shim::detail
+
+namespace mbed_shim {
+
+    using detail::GetSerialPort;
+    using detail::IrqLock;
+
+    void SerialWrite(PinName tx, const uint8_t* data, size_t len) {
+        detail::SerialPort& port = GetSerialPort(tx);
+        std::vector<uint8_t> bytes(data, data + len);
+        RaiseIrq([&port, bytes = std::move(bytes)] {
+            port.rx.insert(port.rx.end(), bytes.begin(), bytes.end());
+            if (port.rxIrq) {
+                port.rxIrq();
+            }
+        });
+    }
+
+    void SetSerialTxListener(PinName tx, SerialListener listener) {
+        detail::SerialPort& port = GetSerialPort(tx);
+        std::lock_guard<std::recursive_mutex> lock(IrqLock());
+        port.listener = std::move(listener);
+    }
+
+    std::string OpenSerialPty(PinName tx) {
+        const int master = posix_openpt(O_RDWR | O_NOCTTY);
+        if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0) {
+            return "";
+        }
+        const std::string path = ptsname(master);
+
+        // Raw line, and keep the slave open so the master never sees a hangup
+        const int slave = open(path.c_str(), O_RDWR | O_NOCTTY);
+        termios settings;
+        if (slave >= 0 && tcgetattr(slave, &settings) == 0) {
+            cfmakeraw(&settings);
+            tcsetattr(slave, TCSANOW, &settings);
+        }
+
+        detail::SerialPort& port = GetSerialPort(tx);
+        {
+            std::lock_guard<std::recursive_mutex> lock(IrqLock());
+            port.ptyFd = master;
+        }
+        std::thread([tx, master] {
+            uint8_t buffer[256];
+            while (true) {
+                const ssize_t count = read(master, buffer, sizeof(buffer));
+                if (count > 0) {
+                    SerialWrite(tx, buffer, static_cast<size_t>(count));
+                } else if (count < 0 && errno != EINTR && errno != EAGAIN) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                }
+            }
+        }).detach();
+        return path;
+    }
+
+    int GetSerialBaud(PinName tx) {
+        detail::SerialPort& port = GetSerialPort(tx);
+        std::lock_guard<std::recursive_mutex> lock(IrqLock());
+        return port.baud;
+    }
+
+} // namespace mbed_shim
+
+namespace mbed {
+
+    using mbed_shim::detail::IrqLock;
+
+    SerialBase::SerialBase(PinName tx, PinName /*rx*/, int baud)
+        : m_Port(&mbed_shim::detail::GetSerialPort(tx))
+    {
+        this->baud(baud);
+
+        static const bool usePty = getenv("MBED_SHIM_PTY") != nullptr;
+        if (usePty && m_Port->ptyFd < 0) {
+            fprintf(stderr, "[mbed_shim] serial TX pin 0x%02X on %s\n", static_cast<unsigned>(tx),
+                    mbed_shim::OpenSerialPty(tx).c_str());
+        }
+    }
+
+    SerialBase::~SerialBase() {
+        std::lock_guard<std::recursive_mutex> lock(IrqLock());
+        m_Port->rxIrq = nullptr;
+        m_Port->txIrq = nullptr;
+    }
+
+    void SerialBase::baud(int baudrate) {
+        std::lock_guard<std::recursive_mutex> lock(IrqLock());
+        m_Port->baud = baudrate > 0 ? baudrate : mbed_shim::detail::SERIAL_DEFAULT_BAUD;
+    }
+
+    void SerialBase::format(int /*bits*/, Parity /*parity*/, int /*stop_bits*/) {
+    }
+
+    int SerialBase::readable() {
+        std::lock_guard<std::recursive_mutex> lock(IrqLock());
+        return !m_Port->rx.empty();
+    }
+
+    int SerialBase::writeable() {
+        std::lock_guard<std::recursive_mutex> lock(IrqLock());
+        return m_Port->GetTxFifoLevel() < mbed_shim::detail::SERIAL_TX_FIFO_SIZE;
+    }
+
+    void SerialBase::attach(Callback<void()> func, IrqType type) {
+        std::lock_guard<std::recursive_mutex> lock(IrqLock());
+        if (type == RxIrq) {
+            m_Port->rxIrq = func;
+        } else {
+            m_Port->txIrq = func;
+            if (func) {
+                m_Port->ScheduleTxService(mbed_shim::detail::NowUs());
+            }
+        }
+    }
+
+    int SerialBase::_base_getc() {
+        std::lock_guard<std::recursive_mutex> lock(IrqLock());
+        if (m_Port->rx.empty()) {
+            return -1;
+        }
+        const uint8_t value = m_Port->rx.front();
+        m_Port->rx.pop_front();
+        return value;
+    }
+
+    int SerialBase::_base_putc(int c) {
+        std::lock_guard<std::recursive_mutex> lock(IrqLock());
+        m_Port->Putc(static_cast<uint8_t>(c));
+        return c;
+    }
+
+    BufferedSerial::BufferedSerial(PinName tx, PinName rx, int baud)
+        : SerialBase(tx, rx, baud)
+    {
+    }
+
+    ssize_t BufferedSerial::read(void* buffer, size_t length) {
+        uint8_t* bytes = static_cast<uint8_t*>(buffer);
+        while (m_Blocking && !SerialBase::readable()) {
+            ThisThread::sleep_for(1ms);
+        }
+
+        std::lock_guard<std::recursive_mutex> lock(IrqLock());
+        size_t count = 0;
+        while (count < length && !m_Port->rx.empty()) {
+            bytes[count++] = m_Port->rx.front();
+            m_Port->rx.pop_front();
+        }
+        return count > 0 ? static_cast<ssize_t>(count) : -EAGAIN;
+    }
+
+    ssize_t BufferedSerial::write(const void* buffer, size_t length) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(buffer);
+        for (size_t i = 0; i < length; i++) {
+            while (!SerialBase::writable()) {
+                ThisThread::sleep_for(1ms);
+            }
+            _base_putc(bytes[i]);
+        }
+        return static_cast<ssize_t>(length);
+    }
+
+    ssize_t UnbufferedSerial::read(void* buffer, size_t length) {
+        uint8_t* bytes = static_cast<uint8_t*>(buffer);
+        size_t count = 0;
+        while (count < length && SerialBase::readable()) {
+            bytes[count++] = static_cast<uint8_t>(_base_getc());
+        }
+        return static_cast<ssize_t>(count);
+    }
+
+    ssize_t UnbufferedSerial::write(const void* buffer, size_t length) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(buffer);
+        for (size_t i = 0; i < length; i++) {
+            while (!SerialBase::writable()) {
+            }
+            _base_putc(bytes[i]);
+        }
+        return static_cast<ssize_t>(length);
+    }
+
+} // namespace mbed
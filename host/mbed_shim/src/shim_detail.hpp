@@ -0,0 +1,43 @@
+/**
+ * @file shim_detail.hpp
+ * @brief Internals shared by the shim translation units
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+namespace mbed_shim::detail {
+
+    /**
+     * @brief Microseconds since the shim started, 64 bit
+     */
+    uint64_t NowUs();
+
+    /**
+     * @brief The lock held by emulated interrupts and critical sections
+     */
+    std::recursive_mutex& IrqLock();
+
+    /**
+     * @brief Run func in interrupt context once the shim clock reaches dueUs
+     */
+    void ScheduleIrq(uint64_t dueUs, std::function<void()> func);
+
+    /**
+     * @brief True on the dispatcher thread while it runs an emulated interrupt
+     */
+    bool IsIsrActive();
+
+    /**
+     * @brief Cancellation handle of scheduled events owned by a driver object
+     */
+    struct EventToken {
+        bool active{true}; // read and written under IrqLock only
+    };
+
+} // namespace mbed_shim::detail
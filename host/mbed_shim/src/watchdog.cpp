@@ -0,0 +1,86 @@
+/**
+ * @file watchdog.cpp
+ * @brief Host shim of the independent watchdog and the reset reason
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#include <atomic>
+#include <cstdio>
+
+#include "mbed.h"
+#include "mbed_shim/host.hpp"
+#include "shim_detail.hpp"
+
+namespace mbed_shim {
+
+    namespace {
+
+        std::atomic<reset_reason_t> s_ResetReason{RESET_REASON_POWER_ON};
+        std::atomic<bool> s_WatchdogExpired{false};
+
+    } // namespace
+
+    void SetResetReason(reset_reason_t reason) {
+        s_ResetReason = reason;
+    }
+
+    bool HasWatchdogExpired() {
+        return s_WatchdogExpired;
+    }
+
+} // namespace mbed_shim
+
+namespace mbed {
+
+    using mbed_shim::detail::IrqLock;
+
+    reset_reason_t ResetReason::get() {
+        return mbed_shim::s_ResetReason;
+    }
+
+    Watchdog& Watchdog::get_instance() {
+        static auto* watchdog = new Watchdog(); // leaked, the dispatcher may check it during exit
+        return *watchdog;
+    }
+
+    bool Watchdog::start(uint32_t timeout_ms) {
+        std::lock_guard<std::recursive_mutex> lock(IrqLock());
+        if (m_Running || timeout_ms == 0 || timeout_ms > get_max_timeout()) {
+            return false;
+        }
+        m_Running = true;
+        m_TimeoutMs = timeout_ms;
+        m_LastKickUs = mbed_shim::detail::NowUs();
+        mbed_shim::detail::ScheduleIrq(m_LastKickUs + m_TimeoutMs * 1000ull, [this] { Check(); });
+        return true;
+    }
+
+    void Watchdog::kick() {
+        std::lock_guard<std::recursive_mutex> lock(IrqLock());
+        m_LastKickUs = mbed_shim::detail::NowUs();
+    }
+
+    bool Watchdog::is_running() const {
+        std::lock_guard<std::recursive_mutex> lock(IrqLock());
+        return m_Running;
+    }
+
+    uint32_t Watchdog::get_timeout() const {
+        std::lock_guard<std::recursive_mutex> lock(IrqLock());
+        return m_TimeoutMs;
+    }
+
+    void Watchdog::Check() {
+        // One pending check at a time, moved to the expiry of the latest kick
+        const uint64_t expiryUs = m_LastKickUs + m_TimeoutMs * 1000ull;
+        if (mbed_shim::detail::NowUs() < expiryUs) {
+            mbed_shim::detail::ScheduleIrq(expiryUs, [this] { Check(); });
+            return;
+        }
+        mbed_shim::s_WatchdogExpired = true;
+        fprintf(stderr, "[mbed_shim] Watchdog expired, %u ms without a kick\n", static_cast<unsigned>(m_TimeoutMs));
+        NVIC_SystemReset();
+    }
+
+} // namespace mbed
@@ -0,0 +1,129 @@
+/**
+ * @file autonomy_client.cpp
+ * @brief Implementation of the scripted onboard computer
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#include "autonomy_client.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#include "mbed_shim/host.hpp"
+
+namespace tritonai::gkc::sim {
+
+    static size_t AppendU32(uint8_t* out, uint32_t value) {
+        for (size_t i = 0; i < 4; i++) {
+            out[i] = (value >> (8 * i)) & 0xFF;
+        }
+        return 4;
+    }
+
+    static size_t AppendFloat(uint8_t* out, float value) {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        return AppendU32(out, bits);
+    }
+
+    static uint32_t GetU32(const uint8_t* data) {
+        return static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8) |
+               (static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24);
+    }
+
+    AutonomyClient::AutonomyClient(PinName port) : m_Port(port) {
+        mbed_shim::SetSerialTxListener(port, [this](const uint8_t* data, size_t len) {
+            OnBytes(data, len);
+        });
+    }
+
+    void AutonomyClient::Start() {
+        std::thread(&AutonomyClient::HeartbeatLoop, this).detach();
+    }
+
+    uint32_t AutonomyClient::SendPayload(const uint8_t* payload, size_t len) {
+        uint8_t frame[GKC_FRAME_MAX_PAYLOAD + GKC_FRAME_OVERHEAD];
+        const size_t size = EncodeFrame(payload, len, frame, sizeof(frame));
+
+        std::lock_guard<std::mutex> lock(m_SendLock);
+        const uint32_t stampUs = us_ticker_read();
+        mbed_shim::SerialWrite(m_Port, frame, size);
+        return stampUs;
+    }
+
+    uint32_t AutonomyClient::SendHandshake() {
+        uint8_t payload[5] = {GKC_ID_HANDSHAKE1};
+        AppendU32(payload + 1, ++m_Sequence & 0x00FFFFFF);
+        return SendPayload(payload, sizeof(payload));
+    }
+
+    uint32_t AutonomyClient::SendStateTransition(uint8_t state) {
+        const uint8_t payload[2] = {GKC_ID_STATE_TRANSITION, state};
+        return SendPayload(payload, sizeof(payload));
+    }
+
+    uint32_t AutonomyClient::SendControl(float throttle, float steering, float brake) {
+        uint8_t payload[13] = {GKC_ID_CONTROL};
+        size_t index = 1;
+        index += AppendFloat(payload + index, throttle);
+        index += AppendFloat(payload + index, steering);
+        index += AppendFloat(payload + index, brake);
+        return SendPayload(payload, index);
+    }
+
+    uint32_t AutonomyClient::SendLogConfig(uint8_t severity) {
+        const uint8_t payload[2] = {GKC_ID_LOG_CONFIG, severity};
+        return SendPayload(payload, sizeof(payload));
+    }
+
+    void AutonomyClient::OnBytes(const uint8_t* data, size_t len) {
+        const uint32_t stampUs = us_ticker_read();
+        for (size_t i = 0; i < len; i++) {
+            if (m_Parser.Push(data[i])) {
+                m_FrameCount++;
+                OnPayload(m_Parser.GetPayload(), m_Parser.GetPayloadSize(), stampUs);
+            }
+        }
+    }
+
+    void AutonomyClient::OnPayload(const uint8_t* payload, size_t len, uint32_t stampUs) {
+        switch (payload[0]) {
+        case GKC_ID_HEARTBEAT:
+            // ID, rolling counter, state
+            if (len >= 3) {
+                m_Heartbeats.Add(stampUs, payload[2]);
+            }
+            break;
+        case GKC_ID_HANDSHAKE2:
+            if (len >= 5) {
+                m_Handshakes.Add(stampUs, GetU32(payload + 1));
+            }
+            break;
+        case GKC_ID_SENSOR_AGE:
+            if (len >= 13) {
+                m_SensorAges.Add(stampUs, SensorAges{GetU32(payload + 1), GetU32(payload + 5), GetU32(payload + 9)});
+            }
+            break;
+        case GKC_ID_LOG:
+        case GKC_ID_BINARY_LOG:
+            m_LogBytes += static_cast<uint32_t>(len + GKC_FRAME_OVERHEAD);
+            break;
+        default:
+            break;
+        }
+    }
+
+    void AutonomyClient::HeartbeatLoop() {
+        auto next = std::chrono::steady_clock::now();
+        while (true) {
+            next += std::chrono::milliseconds(CLIENT_HEARTBEAT_PERIOD_MS);
+            std::this_thread::sleep_until(next);
+
+            const uint8_t payload[3] = {GKC_ID_HEARTBEAT, m_RollingCounter++, GKC_STATE_ACTIVE};
+            SendPayload(payload, sizeof(payload));
+        }
+    }
+
+} // namespace tritonai::gkc::sim
@@ -0,0 +1,99 @@
+/**
+ * @file autonomy_client.hpp
+ * @brief Scripted stand-in for the onboard computer on the firmware's main UART
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+#include "mbed.h"
+
+#include "Comm/gkc_frame.hpp"
+#include "event_log.hpp"
+
+namespace tritonai::gkc::sim {
+
+    constexpr uint32_t CLIENT_HEARTBEAT_PERIOD_MS = 100;
+
+    // Lifecycle codes carried in heartbeats and state transition requests
+    constexpr uint8_t GKC_STATE_UNINITIALIZED = 0;
+    constexpr uint8_t GKC_STATE_INACTIVE = 2;
+    constexpr uint8_t GKC_STATE_ACTIVE = 3;
+    constexpr uint8_t GKC_STATE_EMERGENCY = 255;
+
+    // Payload of GKC_ID_SENSOR_AGE, UINT32_MAX for a field never captured
+    struct SensorAges {
+        uint32_t steeringUs;
+        uint32_t speedUs;
+        uint32_t brakePressureUs;
+    };
+
+    /**
+     * @class AutonomyClient
+     * @brief Speaks the GKC serial protocol like serial_test.py does
+     *
+     * Requests are framed and written to the port in one piece. Heartbeats,
+     * handshake replies and sensor ages from the firmware are decoded and
+     * logged with the time their last byte left the firmware's UART.
+     *
+     * Threading: Send* from any thread; the logs are filled from shim
+     * interrupt context.
+     */
+    class AutonomyClient {
+    public:
+        /**
+         * @param port TX pin of the firmware's main UART
+         */
+        explicit AutonomyClient(PinName port);
+
+        /**
+         * @brief Start the periodic heartbeat
+         */
+        void Start();
+
+        // Each returns the us_ticker_read() time the complete request was written
+        uint32_t SendHandshake();
+        uint32_t SendStateTransition(uint8_t state);
+        uint32_t SendControl(float throttle, float steering, float brake);
+        uint32_t SendLogConfig(uint8_t severity);
+
+        const EventLog<uint8_t>& GetHeartbeats() const { return m_Heartbeats; }     // lifecycle state
+        const EventLog<uint32_t>& GetHandshakes() const { return m_Handshakes; }    // reply sequence number
+        const EventLog<SensorAges>& GetSensorAges() const { return m_SensorAges; }
+
+        /**
+         * @brief Number of valid frames received from the firmware, of any packet ID
+         */
+        uint32_t GetFrameCount() const { return m_FrameCount.load(); }
+
+        /**
+         * @brief Bytes of LogPacket and binary log frames received, framing included
+         */
+        uint32_t GetLogBytes() const { return m_LogBytes.load(); }
+
+    private:
+        uint32_t SendPayload(const uint8_t* payload, size_t len);
+        void OnBytes(const uint8_t* data, size_t len);
+        void OnPayload(const uint8_t* payload, size_t len, uint32_t stampUs);
+        void HeartbeatLoop();
+
+        PinName m_Port;
+        std::mutex m_SendLock;
+        uint32_t m_Sequence{0};
+        uint8_t m_RollingCounter{0};
+
+        GkcFrameParser m_Parser; // shim interrupt context only
+        EventLog<uint8_t> m_Heartbeats;
+        EventLog<uint32_t> m_Handshakes;
+        EventLog<SensorAges> m_SensorAges;
+        std::atomic<uint32_t> m_FrameCount{0};
+        std::atomic<uint32_t> m_LogBytes{0};
+    };
+
+} // namespace tritonai::gkc::sim
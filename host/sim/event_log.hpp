@@ -0,0 +1,135 @@
+/**
+ * @file event_log.hpp
+ * @brief Timestamped event history and latency statistics for the simulator
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace tritonai::gkc::sim {
+
+    /**
+     * @class EventLog
+     * @brief Append-only history of events stamped with us_ticker_read() time
+     *
+     * Events are appended from shim interrupt context and searched from the
+     * scenario thread. Stamps are compared with unsigned differences, so a run
+     * must stay well below the 71 minute wrap of the microsecond counter.
+     *
+     * @tparam T Event payload
+     */
+    template <typename T>
+    class EventLog {
+    public:
+        void Add(uint32_t stampUs, const T& value) {
+            {
+                std::lock_guard<std::mutex> lock(m_Lock);
+                m_Events.emplace_back(stampUs, value);
+            }
+            m_Added.notify_all();
+        }
+
+        /**
+         * @brief Stamp of the first event at or after sinceUs that matches pred
+         */
+        template <typename Pred>
+        std::optional<uint32_t> Find(uint32_t sinceUs, Pred pred) const {
+            std::lock_guard<std::mutex> lock(m_Lock);
+            return FindLocked(sinceUs, pred);
+        }
+
+        /**
+         * @brief Like Find, but waits up to timeoutMs for a matching event to be added
+         */
+        template <typename Pred>
+        std::optional<uint32_t> WaitFor(uint32_t sinceUs, uint32_t timeoutMs, Pred pred) const {
+            std::unique_lock<std::mutex> lock(m_Lock);
+            std::optional<uint32_t> found;
+            m_Added.wait_for(lock, std::chrono::milliseconds(timeoutMs), [&] {
+                found = FindLocked(sinceUs, pred);
+                return found.has_value();
+            });
+            return found;
+        }
+
+        /**
+         * @brief Copy of every event at or after sinceUs
+         */
+        std::vector<std::pair<uint32_t, T>> Since(uint32_t sinceUs) const {
+            std::lock_guard<std::mutex> lock(m_Lock);
+            std::vector<std::pair<uint32_t, T>> events;
+            for (const auto& event : m_Events) {
+                if (IsAtOrAfter(event.first, sinceUs)) {
+                    events.push_back(event);
+                }
+            }
+            return events;
+        }
+
+        static bool IsAtOrAfter(uint32_t stampUs, uint32_t sinceUs) {
+            return static_cast<int32_t>(stampUs - sinceUs) >= 0;
+        }
+
+    private:
+        template <typename Pred>
+        std::optional<uint32_t> FindLocked(uint32_t sinceUs, Pred& pred) const {
+            for (const auto& event : m_Events) {
+                if (IsAtOrAfter(event.first, sinceUs) && pred(event.second)) {
+                    return event.first;
+                }
+            }
+            return std::nullopt;
+        }
+
+        mutable std::mutex m_Lock;
+        mutable std::condition_variable m_Added;
+        std::vector<std::pair<uint32_t, T>> m_Events;
+    };
+
+    /**
+     * @class SampleSet
+     * @brief Collected durations with order statistics, not thread safe
+     */
+    class SampleSet {
+    public:
+        void Add(uint32_t valueUs) {
+            m_Values.push_back(valueUs);
+            m_Sorted = false;
+        }
+
+        size_t GetCount() const { return m_Values.size(); }
+
+        /**
+         * @brief Nearest-rank percentile, 0 when empty
+         */
+        uint32_t GetPercentile(double percent) {
+            if (m_Values.empty()) {
+                return 0;
+            }
+            if (!m_Sorted) {
+                std::sort(m_Values.begin(), m_Values.end());
+                m_Sorted = true;
+            }
+            const size_t rank = static_cast<size_t>(percent / 100.0 * (m_Values.size() - 1) + 0.5);
+            return m_Values[std::min(rank, m_Values.size() - 1)];
+        }
+
+        uint32_t GetMax() { return GetPercentile(100.0); }
+
+    private:
+        std::vector<uint32_t> m_Values;
+        bool m_Sorted{true};
+    };
+
+} // namespace tritonai::gkc::sim
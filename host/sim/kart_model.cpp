@@ -0,0 +1,189 @@
+/**
+ * @file kart_model.cpp
+ * @brief Implementation of the simulated actuators and vehicle dynamics
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#include "kart_model.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+#include "mbed_shim/host.hpp"
+
+#include "config.hpp"
+#include "Actuation/vesc_can_tools.hpp"
+
+namespace tritonai::gkc::sim {
+
+    // Same conversion as CommCanSetSpeed
+    static constexpr float ERPM_PER_MS = NUM_MOTOR_POLES * GEAR_RATIO / WHEEL_CIRCUMFERENCE_M * 60.0;
+
+    static constexpr float RAD_TO_DEG = 180.0f / static_cast<float>(M_PI);
+
+    // Moves value toward zero by at most step, never past it
+    static float TowardZero(float value, float step) {
+        return value > 0.0f ? std::max(0.0f, value - step) : std::min(0.0f, value + step);
+    }
+
+    KartModel::KartModel() {
+        // Centered steering reads as zero through the firmware's encoder offset
+        m_MotorDeg.store(ENCODER_OFFSET * RAD_TO_DEG);
+
+        mbed_shim::SetCanListener(CAN2_RX, [this](const CANMessage& msg, uint32_t stampUs) {
+            OnFrame(msg, stampUs);
+        });
+    }
+
+    void KartModel::SetFrameObserver(FrameObserver observer) {
+        std::lock_guard<std::mutex> lock(m_Lock);
+        m_Observer = std::move(observer);
+    }
+
+    void KartModel::Start() {
+        std::thread(&KartModel::PlantLoop, this).detach();
+    }
+
+    void KartModel::OnFrame(const CANMessage& msg, uint32_t stampUs) {
+        if (msg.format != CANExtended) {
+            return;
+        }
+
+        const uint32_t packetId = msg.id >> 8;
+        const uint8_t controllerId = msg.id & 0xFF;
+        if (packetId == CAN_PACKET_STATUS || packetId == CAN_PACKET_STATUS_4) {
+            return; // our own broadcasts
+        }
+
+        std::lock_guard<std::mutex> lock(m_Lock);
+        int32_t index = 0;
+        if (msg.id == BRAKE_CAN_ID && msg.len >= 4) {
+            const uint32_t pos = msg.data[2] | ((msg.data[3] & 0x1F) << 8);
+            m_Commands.brakeTarget = Clamp((static_cast<float>(pos) - MIN_BRAKE_VAL) /
+                                           (MAX_BRAKE_VAL - MIN_BRAKE_VAL), 0.0f, 1.0f);
+        } else if (controllerId == THROTTLE_CAN_ID && packetId == CAN_PACKET_SET_RPM && msg.len >= 4) {
+            m_Commands.driveMode = DriveMode::RPM;
+            m_Commands.targetErpm = static_cast<float>(BufferGetInt32(msg.data, &index));
+            m_Commands.driveStampUs = stampUs;
+        } else if (controllerId == THROTTLE_CAN_ID && packetId == CAN_PACKET_SET_CURRENT_BRAKE_REL && msg.len >= 4) {
+            m_Commands.driveMode = DriveMode::REGEN;
+            m_Commands.regenRel = Clamp(BufferGetFloat32(msg.data, 1e5, &index), 0.0f, 1.0f);
+            m_Commands.driveStampUs = stampUs;
+        } else if (controllerId == STEER_CAN_ID && packetId == CAN_PACKET_SET_POS && msg.len >= 4) {
+            // CommCanSetPos sends the motor angle negated, in millionths of a degree
+            m_Commands.steerTargetDeg = -BufferGetInt32(msg.data, &index) / 1e6f;
+            m_Commands.hasSteerTarget = true;
+        }
+
+        if (m_Observer) {
+            m_Observer(msg, stampUs);
+        }
+    }
+
+    void KartModel::PlantLoop() {
+        const float dtS = PLANT_STEP_US / 1e6f;
+        auto next = std::chrono::steady_clock::now();
+        uint32_t elapsedUs = 0;
+
+        while (true) {
+            next += std::chrono::microseconds(PLANT_STEP_US);
+            std::this_thread::sleep_until(next);
+
+            Commands commands;
+            {
+                std::lock_guard<std::mutex> lock(m_Lock);
+                commands = m_Commands;
+            }
+            Step(commands, us_ticker_read(), dtS);
+
+            // Stagger the two VESCs like independently clocked controllers
+            elapsedUs += PLANT_STEP_US;
+            const uint32_t phaseUs = elapsedUs % VESC_STATUS_PERIOD_US;
+            const float erpm = m_Speed.load() * ERPM_PER_MS;
+            if (phaseUs == 0) {
+                SendStatus(THROTTLE_CAN_ID, erpm, m_LastAccel * 10.0f, Clamp(erpm / 30000.0f, -1.0f, 1.0f), 0.0f);
+            } else if (phaseUs == VESC_STATUS_PERIOD_US / 2) {
+                const float motorDeg = std::round(m_MotorDeg.load() / STEER_ENCODER_RESOLUTION_DEG) *
+                                       STEER_ENCODER_RESOLUTION_DEG;
+                // The VESC reports its own position, the negated firmware angle in [0, 360)
+                float pidPos = std::fmod(-motorDeg, 360.0f);
+                if (pidPos < 0.0f) {
+                    pidPos += 360.0f;
+                }
+                SendStatus(STEER_CAN_ID, 0.0f, std::fabs(m_SteerRateDegS) * 0.01f, 0.0f, pidPos);
+            }
+        }
+    }
+
+    void KartModel::Step(const Commands& commands, uint32_t nowUs, float dtS) {
+        // Drive motor
+        float speed = m_Speed.load();
+        DriveMode mode = commands.driveMode;
+        if (nowUs - commands.driveStampUs > VESC_COMMAND_TIMEOUT_US) {
+            mode = DriveMode::COAST;
+        }
+
+        float accel = 0.0f;
+        switch (mode) {
+        case DriveMode::RPM:
+            accel = Clamp((commands.targetErpm / ERPM_PER_MS - speed) / DRIVE_TIME_CONSTANT_S,
+                          -DRIVE_MAX_ACCEL, DRIVE_MAX_ACCEL);
+            speed += accel * dtS;
+            break;
+        case DriveMode::REGEN:
+            accel = -DRIVE_REGEN_DECEL * commands.regenRel;
+            speed = TowardZero(speed, -accel * dtS);
+            break;
+        case DriveMode::COAST:
+            accel = -DRIVE_COAST_DECEL;
+            speed = TowardZero(speed, DRIVE_COAST_DECEL * dtS);
+            break;
+        }
+
+        // Brake actuator and the pads, which only ever slow the kart down
+        float brake = m_Brake.load();
+        const float travel = BRAKE_TRAVEL_RATE * dtS;
+        brake = Clamp(commands.brakeTarget, brake - travel, brake + travel);
+        const float pressure = std::max(0.0f, (brake - BRAKE_FREE_TRAVEL) / (1.0f - BRAKE_FREE_TRAVEL));
+        speed = TowardZero(speed, pressure * BRAKE_MAX_DECEL * dtS);
+        mbed_shim::SetAnalogIn(BRAKE_PRESSURE_SENSOR_PIN, pressure * BRAKE_SENSOR_FULL_SCALE);
+
+        // Steering position loop, holds its position until the first SET_POS
+        float motorDeg = m_MotorDeg.load();
+        if (commands.hasSteerTarget) {
+            const float steerAccel = STEER_NATURAL_FREQ * STEER_NATURAL_FREQ * (commands.steerTargetDeg - motorDeg) -
+                                     2.0f * STEER_DAMPING * STEER_NATURAL_FREQ * m_SteerRateDegS;
+            m_SteerRateDegS += steerAccel * dtS;
+            motorDeg += m_SteerRateDegS * dtS;
+        }
+
+        m_LastAccel = accel;
+        m_Speed.store(speed);
+        m_Brake.store(brake);
+        m_MotorDeg.store(motorDeg);
+    }
+
+    void KartModel::SendStatus(uint8_t controllerId, float erpm, float currentA, float duty, float pidPosDeg) {
+        // Current and duty are rough, the firmware only uses ERPM and position
+        uint8_t status[8];
+        int32_t index = 0;
+        BufferAppendInt32(status, static_cast<int32_t>(erpm), &index);
+        BufferAppendFloat16(status, currentA, 1e1, &index);
+        BufferAppendFloat16(status, duty, 1e3, &index);
+        mbed_shim::CanInject(CAN2_RX, CANMessage(controllerId | (CAN_PACKET_STATUS << 8),
+                                                 status, sizeof(status), CANData, CANExtended));
+
+        uint8_t status4[8];
+        index = 0;
+        BufferAppendFloat16(status4, 35.0f, 1e1, &index); // FET temperature
+        BufferAppendFloat16(status4, 40.0f, 1e1, &index); // motor temperature
+        BufferAppendFloat16(status4, currentA, 1e1, &index);
+        BufferAppendFloat16(status4, pidPosDeg, 50.0, &index);
+        mbed_shim::CanInject(CAN2_RX, CANMessage(controllerId | (CAN_PACKET_STATUS_4 << 8),
+                                                 status4, sizeof(status4), CANData, CANExtended));
+    }
+
+} // namespace tritonai::gkc::sim
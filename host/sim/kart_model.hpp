@@ -0,0 +1,105 @@
+/**
+ * @file kart_model.hpp
+ * @brief Simulated VESCs, brake actuator and vehicle dynamics on the shim CAN bus
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+#include "mbed.h"
+
+namespace tritonai::gkc::sim {
+
+    // Plant step and the VESC status broadcast rate (VESC Tool default 50 Hz)
+    constexpr uint32_t PLANT_STEP_US = 1000;
+    constexpr uint32_t VESC_STATUS_PERIOD_US = 20000;
+
+    // Drive: first-order speed response to SET_RPM, VESC command timeout
+    constexpr float DRIVE_TIME_CONSTANT_S = 0.3f;
+    constexpr float DRIVE_MAX_ACCEL = 4.0f;           // m/s^2
+    constexpr float DRIVE_REGEN_DECEL = 6.0f;         // m/s^2 at full CURRENT_BRAKE_REL
+    constexpr float DRIVE_COAST_DECEL = 0.3f;         // m/s^2 rolling resistance
+    constexpr uint32_t VESC_COMMAND_TIMEOUT_US = 1000000;
+
+    // Steering: the VESC position loop as a second-order system, 0.02 deg encoder
+    constexpr float STEER_NATURAL_FREQ = 30.0f;       // rad/s
+    constexpr float STEER_DAMPING = 0.45f;
+    constexpr float STEER_ENCODER_RESOLUTION_DEG = 0.02f;
+
+    // Brake: rate-limited linear actuator, pads engage after the free travel
+    constexpr float BRAKE_TRAVEL_RATE = 5.0f;         // full travel per second
+    constexpr float BRAKE_FREE_TRAVEL = 0.05f;
+    constexpr float BRAKE_MAX_DECEL = 8.0f;           // m/s^2 at full pressure
+    constexpr float BRAKE_SENSOR_FULL_SCALE = 0.8f;   // AnalogIn reading at full pressure
+
+    /**
+     * @class KartModel
+     * @brief Answers the firmware's CAN commands like the real actuators do
+     *
+     * The throttle VESC follows SET_RPM and CURRENT_BRAKE_REL, the steering
+     * VESC follows SET_POS, and the brake actuator on BRAKE_CAN_ID moves
+     * toward its commanded position. Both VESCs broadcast STATUS and STATUS_4
+     * every VESC_STATUS_PERIOD_US, the brake pressure is fed to the firmware's
+     * AnalogIn on BRAKE_PRESSURE_SENSOR_PIN.
+     *
+     * Threading: the plant runs on its own thread, commands arrive from shim
+     * interrupt context, getters from any thread.
+     */
+    class KartModel {
+    public:
+        // Every frame the firmware puts on the bus, with its completion time
+        using FrameObserver = std::function<void(const CANMessage& msg, uint32_t stampUs)>;
+
+        KartModel();
+
+        /**
+         * @brief Start stepping the plant and broadcasting status frames
+         */
+        void Start();
+
+        /**
+         * @brief Observe the firmware's frames, call before Start
+         */
+        void SetFrameObserver(FrameObserver observer);
+
+        float GetSpeed() const { return m_Speed.load(); }            // m/s
+        float GetMotorAngleDeg() const { return m_MotorDeg.load(); } // steering motor, firmware frame
+        float GetBrakePosition() const { return m_Brake.load(); }    // 0 to 1
+
+    private:
+        enum class DriveMode : uint8_t { COAST, RPM, REGEN };
+
+        struct Commands {
+            DriveMode driveMode{DriveMode::COAST};
+            float targetErpm{0.0f};
+            float regenRel{0.0f};
+            uint32_t driveStampUs{0};
+            bool hasSteerTarget{false};
+            float steerTargetDeg{0.0f};
+            float brakeTarget{0.0f};
+        };
+
+        void OnFrame(const CANMessage& msg, uint32_t stampUs);
+        void PlantLoop();
+        void Step(const Commands& commands, uint32_t nowUs, float dtS);
+        void SendStatus(uint8_t controllerId, float erpm, float currentA, float duty, float pidPosDeg);
+
+        std::mutex m_Lock;
+        Commands m_Commands;
+        FrameObserver m_Observer;
+
+        // Plant state, plant thread only except for the atomics
+        float m_SteerRateDegS{0.0f};
+        float m_LastAccel{0.0f};
+        std::atomic<float> m_Speed{0.0f};
+        std::atomic<float> m_MotorDeg{0.0f};
+        std::atomic<float> m_Brake{0.0f};
+    };
+
+} // namespace tritonai::gkc::sim
@@ -0,0 +1,93 @@
+/**
+ * @file rc_transmitter.cpp
+ * @brief Implementation of the simulated ELRS receiver
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#include "rc_transmitter.hpp"
+
+#include <chrono>
+#include <thread>
+
+#include "mbed_shim/host.hpp"
+
+#include "config.hpp"
+
+namespace tritonai::gkc::sim {
+
+    static constexpr uint8_t CRSF_SYNC = 0xC8;
+    static constexpr uint8_t CRSF_TYPE_RC_CHANNELS = 0x16;
+    static constexpr size_t CRSF_CHANNEL_COUNT = 16;
+    static constexpr size_t CRSF_CHANNELS_SIZE = 22; // 16 channels of 11 bits
+
+    // CRC8 with polynomial 0xD5 over the type and payload
+    static uint8_t CalcCrsfCrc8(const uint8_t* data, size_t len) {
+        uint8_t crc = 0;
+        for (size_t i = 0; i < len; i++) {
+            crc ^= data[i];
+            for (int bit = 0; bit < 8; bit++) {
+                crc = (crc & 0x80) ? static_cast<uint8_t>((crc << 1) ^ 0xD5) : static_cast<uint8_t>(crc << 1);
+            }
+        }
+        return crc;
+    }
+
+    RcTransmitter::RcTransmitter(PinName port) : m_Port(port) {}
+
+    void RcTransmitter::Start() {
+        std::thread(&RcTransmitter::TransmitLoop, this).detach();
+    }
+
+    uint32_t RcTransmitter::SetArmed(bool armed) {
+        std::lock_guard<std::mutex> lock(m_Lock);
+        m_Armed.store(armed);
+        const uint32_t stampUs = us_ticker_read();
+        SendFrame();
+        return stampUs;
+    }
+
+    uint32_t RcTransmitter::SetSilent(bool silent) {
+        std::lock_guard<std::mutex> lock(m_Lock);
+        m_Silent = silent;
+        return m_LastFrameUs;
+    }
+
+    void RcTransmitter::SendFrame() {
+        uint16_t channels[CRSF_CHANNEL_COUNT];
+        for (uint16_t& channel : channels) {
+            channel = CRSF_CHANNEL_MID;
+        }
+        const uint16_t estop = m_Armed.load() ? CRSF_CHANNEL_LOW : CRSF_CHANNEL_HIGH;
+        channels[ELRS_EMERGENCY_STOP_LEFT] = estop;
+        channels[ELRS_EMERGENCY_STOP_RIGHT] = estop;
+        channels[ELRS_TRI_SWITCH_RIGHT] = CRSF_CHANNEL_LOW; // AUTONOMOUS
+
+        // Sync, length of type + payload + CRC, type, packed channels LSB first, CRC
+        uint8_t frame[3 + CRSF_CHANNELS_SIZE + 1] = {CRSF_SYNC, CRSF_CHANNELS_SIZE + 2, CRSF_TYPE_RC_CHANNELS};
+        for (size_t i = 0; i < CRSF_CHANNEL_COUNT; i++) {
+            for (size_t bit = 0; bit < 11; bit++) {
+                if (channels[i] & (1 << bit)) {
+                    const size_t position = i * 11 + bit;
+                    frame[3 + position / 8] |= 1 << (position % 8);
+                }
+            }
+        }
+        frame[sizeof(frame) - 1] = CalcCrsfCrc8(frame + 2, CRSF_CHANNELS_SIZE + 1);
+        m_LastFrameUs = us_ticker_read();
+        mbed_shim::SerialWrite(m_Port, frame, sizeof(frame));
+    }
+
+    void RcTransmitter::TransmitLoop() {
+        auto next = std::chrono::steady_clock::now();
+        while (true) {
+            next += std::chrono::milliseconds(RC_FRAME_PERIOD_MS);
+            std::this_thread::sleep_until(next);
+            std::lock_guard<std::mutex> lock(m_Lock);
+            if (!m_Silent) {
+                SendFrame();
+            }
+        }
+    }
+
+} // namespace tritonai::gkc::sim
@@ -0,0 +1,70 @@
+/**
+ * @file rc_transmitter.hpp
+ * @brief Simulated ELRS receiver output on the firmware's remote UART
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+#include "mbed.h"
+
+namespace tritonai::gkc::sim {
+
+    constexpr uint32_t RC_FRAME_PERIOD_MS = 20; // 50 Hz ELRS packet rate
+
+    // CRSF stick and switch positions as seen by RCController
+    constexpr uint16_t CRSF_CHANNEL_LOW = 174;
+    constexpr uint16_t CRSF_CHANNEL_MID = 992;
+    constexpr uint16_t CRSF_CHANNEL_HIGH = 1811;
+
+    /**
+     * @class RcTransmitter
+     * @brief Sends CRSF RC channel frames with centered sticks in AUTONOMOUS mode
+     *
+     * The only control is the pair of emergency stop switches. Disarmed (the
+     * initial state) both are in the stop position, armed both allow driving.
+     * The link can also go silent, like a receiver out of range.
+     *
+     * Threading: SetArmed from any thread.
+     */
+    class RcTransmitter {
+    public:
+        /**
+         * @param port TX pin the firmware's receiver serial port was created with
+         */
+        explicit RcTransmitter(PinName port);
+
+        /**
+         * @brief Start the periodic frames
+         */
+        void Start();
+
+        /**
+         * @brief Flip the emergency stop switches and send a frame right away
+         * @return us_ticker_read() time the frame with the new state was written
+         */
+        uint32_t SetArmed(bool armed);
+
+        /**
+         * @brief Stop or resume the periodic frames
+         * @return us_ticker_read() time the last frame was written
+         */
+        uint32_t SetSilent(bool silent);
+
+    private:
+        void SendFrame();
+        void TransmitLoop();
+
+        PinName m_Port;
+        std::mutex m_Lock;
+        std::atomic<bool> m_Armed{false};
+        bool m_Silent{false};       // under m_Lock
+        uint32_t m_LastFrameUs{0};  // under m_Lock
+    };
+
+} // namespace tritonai::gkc::sim
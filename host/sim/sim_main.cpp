@@ -0,0 +1,361 @@
+/**
+ * @file sim_main.cpp
+ * @brief Closed-loop simulation of the real Controller and latency report
+ *
+ * Runs the firmware's Controller against KartModel on CAN, RcTransmitter on
+ * the ELRS UART and AutonomyClient on the main UART. Every cycle arms the RC,
+ * streams control packets and ends with an emergency stop, taking turns
+ * between the autonomy client, the RC switches and a silent RC link as its
+ * source.
+ *
+ * Usage: program [--cycles N] [--control-s S] [--max-control-p99-us US] [--log-flood]
+ * --log-flood lowers the firmware's log threshold to DEBUG, so every log site
+ * competes with the heartbeat for the link.
+ * Exit code 0 when every expected event was seen and the control latency p99
+ * is within budget, 1 otherwise, 2 if the firmware reset itself.
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "mbed.h"
+#include "mbed_shim/host.hpp"
+
+#include "config.hpp"
+#include "Actuation/vesc_can_tools.hpp"
+#include "Controller/controller.hpp"
+
+#include "autonomy_client.hpp"
+#include "event_log.hpp"
+#include "kart_model.hpp"
+#include "rc_transmitter.hpp"
+
+using namespace tritonai::gkc;
+using namespace tritonai::gkc::sim;
+
+namespace {
+
+    constexpr uint32_t CONTROL_PACKET_PERIOD_MS = 20;  // 50 Hz autonomy stack
+    constexpr uint32_t CONTROL_PHASE_STEP_US = 1237;   // walks the send time across the control tick
+    constexpr size_t BRAKE_TAG_COUNT = 20;             // distinct brake values cycled through
+    constexpr float BRAKE_TAG_STEP = 0.001f;           // stays inside the brake's free travel
+    constexpr uint32_t EVENT_TIMEOUT_MS = 1000;
+    constexpr uint32_t SETTLE_MS = 500;
+    constexpr uint32_t FIRMWARE_HEARTBEAT_PERIOD_MS = 100; // Controller's main loop
+
+    struct Options {
+        int cycles{3};
+        float controlS{3.0f};
+        uint32_t maxControlP99Us{0}; // 0 = no budget
+        bool logFlood{false};
+    };
+
+    // Firmware transmit load over the control phases, to compare COMM_TX_AGGREGATION builds
+    struct TxStats {
+        uint64_t frames{0};
+        uint64_t sendThreadSwitches{0};
+        uint64_t logBytes{0};
+        uint64_t us{0};
+    };
+
+    struct SentControl {
+        uint32_t stampUs;
+        uint16_t brakePos;
+    };
+
+    // Same conversion as CommCanSetBrakePosition
+    uint16_t ToBrakePos(float brake) {
+        return static_cast<uint16_t>(static_cast<unsigned int>(brake * (MAX_BRAKE_VAL - MIN_BRAKE_VAL)) + MIN_BRAKE_VAL);
+    }
+
+    Options ParseOptions(int argc, char** argv) {
+        Options options;
+        for (int i = 1; i < argc; i++) {
+            const bool hasValue = i + 1 < argc;
+            if (strcmp(argv[i], "--log-flood") == 0) {
+                options.logFlood = true;
+            } else if (hasValue && strcmp(argv[i], "--cycles") == 0) {
+                options.cycles = atoi(argv[++i]);
+            } else if (hasValue && strcmp(argv[i], "--control-s") == 0) {
+                options.controlS = static_cast<float>(atof(argv[++i]));
+            } else if (hasValue && strcmp(argv[i], "--max-control-p99-us") == 0) {
+                options.maxControlP99Us = static_cast<uint32_t>(atoi(argv[++i]));
+            } else {
+                fprintf(stderr, "Unknown option %s\n", argv[i]);
+                exit(1);
+            }
+        }
+        return options;
+    }
+
+    class Report {
+    public:
+        SampleSet& Get(const std::string& name) {
+            for (auto& entry : m_Entries) {
+                if (entry.name == name) {
+                    return entry.samples;
+                }
+            }
+            m_Entries.push_back(Entry{name, SampleSet{}, 0});
+            return m_Entries.back().samples;
+        }
+
+        /**
+         * @brief Record one start to event time, a missing event fails the run if required
+         */
+        void Add(const std::string& name, uint32_t startUs, std::optional<uint32_t> endUs, bool required = true) {
+            SampleSet& samples = Get(name);
+            if (endUs) {
+                samples.Add(*endUs - startUs);
+                return;
+            }
+            for (auto& entry : m_Entries) {
+                if (entry.name == name) {
+                    entry.missed++;
+                }
+            }
+            m_Failed |= required;
+        }
+
+        bool HasFailed() const { return m_Failed; }
+        void Fail() { m_Failed = true; }
+
+        void Print() {
+            for (auto& entry : m_Entries) {
+                SampleSet& samples = entry.samples;
+                printf("  %-43s n=%-5zu p50 %8.2f ms  p99 %8.2f ms  max %8.2f ms", entry.name.c_str(),
+                       samples.GetCount(), samples.GetPercentile(50) / 1e3, samples.GetPercentile(99) / 1e3,
+                       samples.GetMax() / 1e3);
+                if (entry.missed > 0) {
+                    printf("  missed %u", entry.missed);
+                }
+                printf("\n");
+            }
+        }
+
+    private:
+        struct Entry {
+            std::string name;
+            SampleSet samples;
+            uint32_t missed;
+        };
+        std::vector<Entry> m_Entries; // in insertion order
+        bool m_Failed{false};
+    };
+
+    // Streams control packets with a unique brake value each, so the first
+    // brake frame carrying that value marks the packet's way to the bus
+    std::vector<SentControl> RunControlPhase(AutonomyClient& client, float durationS) {
+        std::vector<SentControl> sent;
+        const auto start = std::chrono::steady_clock::now();
+        const size_t count = static_cast<size_t>(durationS * 1000 / CONTROL_PACKET_PERIOD_MS);
+        for (size_t i = 0; i < count; i++) {
+            // Spread the packets over the control tick phase, the two clocks are
+            // not synchronized on the kart either
+            const uint32_t phaseUs = (i * CONTROL_PHASE_STEP_US) % CONTROL_LOOP_PERIOD_US;
+            std::this_thread::sleep_until(start + std::chrono::milliseconds(i * CONTROL_PACKET_PERIOD_MS) +
+                                          std::chrono::microseconds(phaseUs));
+
+            const float t = i * CONTROL_PACKET_PERIOD_MS / 1e3f;
+            const float throttle = 2.0f * std::min(1.0f, t);
+            const float steering = 0.15f * std::sin(2.0f * static_cast<float>(M_PI) * 0.5f * t);
+            const float brake = BRAKE_TAG_STEP * (i % BRAKE_TAG_COUNT);
+            sent.push_back(SentControl{client.SendControl(throttle, steering, brake), ToBrakePos(brake)});
+        }
+        return sent;
+    }
+
+    void AddSensorAges(Report& report, const AutonomyClient& client, uint32_t sinceUs) {
+        for (const auto& event : client.GetSensorAges().Since(sinceUs)) {
+            const SensorAges& ages = event.second;
+            if (ages.steeringUs != UINT32_MAX) {
+                report.Get("sensor age at send: steering").Add(ages.steeringUs);
+            }
+            if (ages.speedUs != UINT32_MAX) {
+                report.Get("sensor age at send: speed").Add(ages.speedUs);
+            }
+            if (ages.brakePressureUs != UINT32_MAX) {
+                report.Get("sensor age at send: brake pressure").Add(ages.brakePressureUs);
+            }
+        }
+    }
+
+    // How far each firmware heartbeat interval strays from the loop period,
+    // the queueing delay it met on the link shows up here
+    void AddHeartbeatJitter(Report& report, const AutonomyClient& client, uint32_t sinceUs, uint32_t untilUs) {
+        std::optional<uint32_t> lastUs;
+        for (const auto& event : client.GetHeartbeats().Since(sinceUs)) {
+            if (EventLog<uint8_t>::IsAtOrAfter(event.first, untilUs)) {
+                break;
+            }
+            if (lastUs) {
+                const int32_t deviationUs =
+                    static_cast<int32_t>(event.first - *lastUs) - static_cast<int32_t>(FIRMWARE_HEARTBEAT_PERIOD_MS * 1000);
+                report.Get("heartbeat interval - 100 ms period").Add(static_cast<uint32_t>(std::abs(deviationUs)));
+            }
+            lastUs = event.first;
+        }
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const Options options = ParseOptions(argc, argv);
+
+    mbed_shim::SetResetHandler([] {
+        printf("FAIL: firmware reset itself%s\n",
+               mbed_shim::HasWatchdogExpired() ? ", hardware watchdog expired" : "");
+        fflush(stdout);
+        std::_Exit(2);
+    });
+
+    KartModel kart;
+    RcTransmitter rc(REMOTE_UART_RX_PIN);
+    AutonomyClient client(UART_TX_PIN);
+
+    EventLog<uint16_t> brakeFrames; // brake position
+    EventLog<uint32_t> driveFrames; // VESC packet ID sent to the throttle VESC
+    kart.SetFrameObserver([&](const CANMessage& msg, uint32_t stampUs) {
+        if (msg.id == BRAKE_CAN_ID) {
+            brakeFrames.Add(stampUs, msg.data[2] | ((msg.data[3] & 0x1F) << 8));
+        } else if ((msg.id & 0xFF) == THROTTLE_CAN_ID) {
+            driveFrames.Add(stampUs, msg.id >> 8);
+        }
+    });
+
+    kart.Start();
+    rc.Start();
+    client.Start();
+
+    Report report;
+    TxStats txStats;
+    const uint32_t bootUs = us_ticker_read();
+    new Controller();
+
+    report.Add("boot -> Inactive heartbeat", bootUs,
+               client.GetHeartbeats().WaitFor(bootUs, EVENT_TIMEOUT_MS,
+                                              [](uint8_t state) { return state == GKC_STATE_INACTIVE; }));
+
+    const uint32_t handshakeUs = client.SendHandshake();
+    report.Add("handshake round trip", handshakeUs,
+               client.GetHandshakes().WaitFor(handshakeUs, EVENT_TIMEOUT_MS, [](uint32_t) { return true; }));
+    if (options.logFlood) {
+        client.SendLogConfig(static_cast<uint8_t>(LogPacket::Severity::DEBUG));
+    }
+
+    for (int cycle = 0; cycle < options.cycles; cycle++) {
+        const uint32_t armUs = rc.SetArmed(true);
+        report.Add("RC arm -> Active heartbeat", armUs,
+                   client.GetHeartbeats().WaitFor(armUs, EVENT_TIMEOUT_MS,
+                                                  [](uint8_t state) { return state == GKC_STATE_ACTIVE; }));
+        report.Add("RC arm -> first SET_RPM frame", armUs,
+                   driveFrames.WaitFor(armUs, EVENT_TIMEOUT_MS,
+                                       [](uint32_t packetId) { return packetId == CAN_PACKET_SET_RPM; }));
+
+        const uint32_t controlUs = us_ticker_read();
+        const uint32_t framesBefore = client.GetFrameCount();
+        const uint64_t switchesBefore = mbed_shim::GetThreadContextSwitches("send_thread");
+        const uint32_t logBytesBefore = client.GetLogBytes();
+        const std::vector<SentControl> sent = RunControlPhase(client, options.controlS);
+        const uint32_t controlEndUs = us_ticker_read();
+        txStats.frames += client.GetFrameCount() - framesBefore;
+        txStats.sendThreadSwitches += mbed_shim::GetThreadContextSwitches("send_thread") - switchesBefore;
+        txStats.logBytes += client.GetLogBytes() - logBytesBefore;
+        txStats.us += controlEndUs - controlUs;
+        AddHeartbeatJitter(report, client, controlUs, controlEndUs);
+        ThisThread::sleep_for(std::chrono::milliseconds(EVENT_TIMEOUT_MS / 10));
+        for (const SentControl& control : sent) {
+            const std::optional<uint32_t> frameUs =
+                brakeFrames.Find(control.stampUs, [&](uint16_t pos) { return pos == control.brakePos; });
+            // A match a full tag cycle later belongs to a later packet
+            const bool inTime = frameUs && *frameUs - control.stampUs < BRAKE_TAG_COUNT * CONTROL_PACKET_PERIOD_MS * 1000;
+            report.Add("control packet -> brake frame", control.stampUs,
+                       inTime ? frameUs : std::nullopt);
+        }
+        AddSensorAges(report, client, controlUs);
+
+        // A client stop ends in Inactive and the next frame of the still armed
+        // RC reactivates, sometimes before the control loop ticked, so its
+        // events are reported but not required
+        const bool fromClient = cycle % 3 == 0;
+        const bool rcLost = cycle % 3 == 2;
+        std::string source;
+        uint32_t stopUs = 0;
+        uint32_t searchUs = 0;
+        if (fromClient) {
+            source = "client e-stop";
+            stopUs = searchUs = client.SendStateTransition(GKC_STATE_EMERGENCY);
+        } else if (!rcLost) {
+            source = "RC e-stop";
+            stopUs = searchUs = rc.SetArmed(false);
+        } else {
+            // Timed from the heartbeat deadline after the last frame. The
+            // firmware re-arms its deadline timer when its RC thread picks the
+            // frame up, so the times include up to one RC poll period.
+            source = "RC loss deadline";
+            searchUs = rc.SetSilent(true);
+            stopUs = searchUs + DEFAULT_RC_HEARTBEAT_LOST_TOLERANCE_MS * 1000;
+        }
+        const auto sinceStop = [stopUs](std::optional<uint32_t> eventUs) -> std::optional<uint32_t> {
+            if (eventUs && static_cast<int32_t>(*eventUs - stopUs) < 0) {
+                return stopUs;
+            }
+            return eventUs;
+        };
+        const uint32_t waitMs = EVENT_TIMEOUT_MS + (stopUs - searchUs) / 1000;
+        report.Add(source + " -> full brake frame", stopUs,
+                   sinceStop(brakeFrames.WaitFor(searchUs, waitMs,
+                                                 [](uint16_t pos) { return pos == MAX_BRAKE_VAL; })),
+                   !fromClient);
+        report.Add(source + " -> CURRENT_BRAKE_REL frame", stopUs,
+                   sinceStop(driveFrames.WaitFor(searchUs, waitMs, [](uint32_t packetId) {
+                       return packetId == CAN_PACKET_SET_CURRENT_BRAKE_REL;
+                   })),
+                   !fromClient);
+        if (!fromClient) {
+            report.Add(source + " -> non-Active heartbeat", stopUs,
+                       sinceStop(client.GetHeartbeats().WaitFor(searchUs, waitMs,
+                                                                [](uint8_t state) { return state != GKC_STATE_ACTIVE; })));
+        }
+
+        rc.SetSilent(false);
+        rc.SetArmed(false);
+        ThisThread::sleep_for(std::chrono::milliseconds(SETTLE_MS));
+    }
+
+    printf("\nClosed-loop simulation: %d cycles, %.1f s of control each, %d baud%s\n", options.cycles,
+           options.controlS, mbed_shim::GetSerialBaud(UART_TX_PIN), options.logFlood ? ", DEBUG log flood" : "");
+    printf("Times from the request leaving the simulated peer to the frame completing on the bus;\n"
+           "heartbeat times include up to one 100 ms heartbeat period.\n");
+    report.Print();
+    printf("  final speed %.2f m/s, brake %.2f\n", kart.GetSpeed(), kart.GetBrakePosition());
+    if (txStats.us > 0) {
+        printf("  serial TX while streaming control: %.0f packets/s, %.0f log B/s, send_thread %.0f context switches/s\n",
+               txStats.frames * 1e6 / txStats.us, txStats.logBytes * 1e6 / txStats.us,
+               txStats.sendThreadSwitches * 1e6 / txStats.us);
+    }
+
+    if (options.maxControlP99Us != 0) {
+        const uint32_t p99 = report.Get("control packet -> brake frame").GetPercentile(99);
+        if (p99 > options.maxControlP99Us) {
+            printf("FAIL: control latency p99 %u us over budget %u us\n", p99, options.maxControlP99Us);
+            report.Fail();
+        }
+    }
+    if (report.HasFailed()) {
+        printf("FAIL\n");
+    }
+    fflush(stdout);
+
+    // The firmware's threads never exit, skip static destructors
+    std::_Exit(report.HasFailed() ? 1 : 0);
+}
@@ -14,6 +14,17 @@
 // USB Passthrough Feature - Comment out to disable USB joystick passthrough
 // #define ENABLE_USB_PASSTHROUGH
 
+// Event-driven sensors - Uncomment to publish sensor packets as soon as CAN
+// feedback arrives (capped at SENSOR_SEND_MIN_INTERVAL_MS) instead of on a timer
+// #define SENSOR_EVENT_DRIVEN
+
+// Serial TX aggregation - Uncomment to send every ready packet in one UART burst
+// #define COMM_TX_AGGREGATION
+
+// Steering calibration - Uncomment to interpolate STEERING_MAPPING with a monotone
+// cubic instead of straight line segments
+// #define STEERING_LUT_CUBIC
+
 // ============================================================================
 // Communication Interfaces
 // ============================================================================
@@ -23,15 +34,59 @@
 #define UART_RX_PIN                    PB_12   // Brake-out board
 #define UART_TX_PIN                    PB_13   // Brake-out board
 
+// Link speed negotiation: the top byte of the Handshake1 sequence number selects
+// an entry of LINK_BAUD_RATES (1-based, 0 keeps the current rate)
+#define LINK_BAUD_RATES                { BAUD_RATE, 921600, 2000000 }
+#define LINK_BAUD_CONFIRM_TIMEOUT_MS   500     // host must handshake again at the new rate
+#define LINK_IDLE_FALLBACK_MS          2000    // silent fast link falls back to BAUD_RATE
+#define LINK_UTILIZATION_WINDOW_MS     1000    // link utilization averaging window
+
 // Remote UART (ELRS receiver)
 #define REMOTE_UART_TX_PIN             PE_7    // 14th pin, 1st pin on DuraClik, UART7_RX, ELRS_TX
 #define REMOTE_UART_RX_PIN             PE_8    // 16th pin, 2nd pin on DuraClik, UART7_TX, ELRS_RX
 
 // Communication buffers and timing
-#define RECV_BUFFER_SIZE               32      // inbound packet buffer
-#define WAIT_READ_MS                   5       // ms between reads
-#define SEND_QUEUE_SIZE                10      // outbound packet queue depth
+#define RECV_BUFFER_SIZE               256     // inbound UART ring, power of two
+#define SEND_BUFFER_SIZE               512     // outbound UART ring, power of two
+#define WAIT_READ_MS                   100     // max ms the receive thread sleeps without data
+#define UART_WRITE_TIMEOUT_MS          50      // max ms a write waits for outbound ring space
+#define SEND_QUEUE_SIZE                20      // outbound packet buffer pool size
+#define SEND_FRAME_MAX_SIZE            260     // largest framed packet: 255 B payload + 5 B framing
 #define SEND_SENSOR_INTERVAL_MS        20      // sensor packet send interval
+#define SENSOR_SEND_MIN_INTERVAL_MS    5       // SENSOR_EVENT_DRIVEN max publish rate
+
+// Outbound scheduler, per-class queue depths (sum + 1 in flight must fit SEND_QUEUE_SIZE)
+#define TX_QUEUE_DEPTH_SAFETY          4       // heartbeat, state transitions
+#define TX_QUEUE_DEPTH_CONTROL         4       // handshake and other replies
+#define TX_QUEUE_DEPTH_SENSOR          2       // latest sensor reading and its age packet
+#define TX_QUEUE_DEPTH_LOG             6       // log messages
+#define TX_PACING_BURST_BYTES          64      // bytes allowed ahead of the line rate
+#define TX_BURST_MAX_BYTES             512     // COMM_TX_AGGREGATION burst size, <= SEND_BUFFER_SIZE
+
+// Binary log (Tools/binary_log.hpp)
+#define BINARY_LOG_RING_SIZE           64      // pending records, power of two, 32 B each
+#define BINARY_LOG_DRAIN_INTERVAL_MS   50      // log thread formats and sends pending records
+#define BINARY_LOG_MIN_SEVERITY        LogPacket::Severity::WARNING // lower records are skipped at the call site
+
+// Log forwarding to the host (Comm/log_forwarder.hpp), threshold settable with GKC_ID_LOG_CONFIG
+#define LOG_FORWARD_MIN_SEVERITY       LogPacket::Severity::INFO // lower messages are not sent
+#define LOG_FORWARD_MAX_BYTES_PER_S    1500    // link share of LogPackets and binary log packets, ~13% at BAUD_RATE
+#define LOG_FORWARD_BATCH_SIZE         120     // text per LogPacket, bounds the frame a heartbeat waits for
+#define LOG_FORWARD_BATCH_COUNT        4       // pending LogPackets, further messages are counted as dropped
+#define LOG_FORWARD_SITE_COUNT         32      // call sites with their own rate limit and de-duplication
+#define LOG_FORWARD_SITE_TEXT_SIZE     64      // message prefix kept for "repeated N times"
+#define LOG_FORWARD_REPEAT_REPORT_MS   1000    // ongoing repeats are reported at this interval
+#define LOG_RATE_LIMIT_BURST           5       // messages a call site may send back to back
+#define LOG_RATE_LIMIT_PER_S           2       // sustained messages per second per call site
+
+// Thread statistics (Tools/thread_monitor.hpp), GKC_ID_THREAD_STATS and GKC_ID_THREAD_INFO
+#define THREAD_MONITOR_MAX_THREADS     16      // registered threads, later ones count as "other"
+#define THREAD_MONITOR_SAMPLE_PERIOD_US 1003   // CPU sampling, not a multiple of the 1 ms RTOS tick
+#define THREAD_STATS_REPORT_MS         1000    // GKC_ID_THREAD_STATS interval
+
+// Profilers (Tools/profiler.hpp)
+#define PROFILER_SUB_BUCKET_BITS       3       // histogram buckets per octave = 2^bits, 240 buckets of 4 B per profiler
+#define PROFILER_REPORT_MS             1000    // GKC_ID_PROFILER_REPORT interval, 0 = on request only
 
 // Tower light indicators
 #define TOWER_LIGHT_RED                PD_15
@@ -48,9 +103,13 @@
 // ============================================================================
 
 // Generic watchdog
-#define DEFAULT_WD_INTERVAL_MS             1000  // wake-up frequency
+#define DEFAULT_WD_INTERVAL_MS             1000  // re-trigger interval of a component that stays silent
 #define DEFAULT_WD_MAX_INACTIVITY_MS       3000  // trigger threshold
-#define DEFAULT_WD_WAKEUP_INTERVAL_MS      2     // internal wake period
+
+// Hardware watchdog (IWDG), fed by the watch thread once the watchdog is armed
+#define HARDWARE_WATCHDOG_TIMEOUT_MS       2000  // reset when the watch thread stops feeding it, 0 = disabled
+#define HARDWARE_WATCHDOG_FEED_MS          250   // feed interval, well below the timeout
+#define RESET_RECORD_NAME_SIZE             24    // watchable name kept in backup SRAM, with terminator
 
 // Component watchdog intervals
 #define DEFAULT_SENSOR_POLL_INTERVAL_MS                 1000
@@ -61,6 +120,8 @@
 #define DEFAULT_CONTROLLER_POLL_LOST_TOLERANCE_MS       3000
 #define DEFAULT_RC_CONTROLLER_POLL_INTERVAL_MS          100
 #define DEFAULT_RC_CONTROLLER_POLL_LOST_TOLERANCE_MS    3000
+#define DEFAULT_CONTROL_LOOP_POLL_INTERVAL_MS           100
+#define DEFAULT_CONTROL_LOOP_POLL_LOST_TOLERANCE_MS     500
 
 // RC heartbeat monitoring
 #define DEFAULT_RC_HEARTBEAT_INTERVAL_MS        100
@@ -81,6 +142,8 @@
 #define CAN2_RX                     PB_5
 #define CAN2_TX                     PB_6
 #define CAN2_BAUDRATE               500000
+#define CAN_RX_RING_SIZE            32      // frames buffered between the RX interrupt and dispatcher, power of two
+#define CAN_TX_SLOT_COUNT           8       // distinct CAN IDs waiting for a TX mailbox
 
 // Brake pressure limits (PSI)
 #define MIN_BRAKE_VAL               600
@@ -91,16 +154,36 @@
 #define THROTTLE_CAN_ID             1
 #define STEER_CAN_ID                2
 #define BRAKE_CAN_ID                0x00FF0000
+#define CAN_FEEDBACK_TIMEOUT_MS     100     // VESC feedback older than this is stale
+#define VESC_CONTROLLER_IDS         { THROTTLE_CAN_ID, STEER_CAN_ID } // VESCs whose status frames are decoded
 
 // Throttle speed limits (m/s)
 #define THROTTLE_MAX_FORWARD_SPEED  20.0f
 #define THROTTLE_MAX_REVERSE_SPEED  20.0f
 
+// Setpoint shaping between control ticks, 0 disables a limit
+#define THROTTLE_SLEW_RATE          4.0f  // m/s^2, max change of the speed setpoint
+#define THROTTLE_JERK_LIMIT         10.0f // m/s^3
+#define STEERING_SLEW_RATE          2.0f  // rad/s
+#define STEERING_JERK_LIMIT         20.0f // rad/s^2
+
 // RC override speed limits
 #define RC_MAX_SPEED_FORWARD        5.0f
 #define RC_MAX_SPEED_REVERSE        5.0f
 
 
+// ============================================================================
+// Control Loop
+// ============================================================================
+
+#define CONTROL_LOOP_PERIOD_US                  5000    // 200 Hz actuation tick
+#define CONTROL_AUTONOMY_SETPOINT_TIMEOUT_MS    200     // older autonomy setpoints are ignored
+#define CONTROL_RC_SETPOINT_TIMEOUT_MS          DEFAULT_RC_HEARTBEAT_LOST_TOLERANCE_MS
+#define CONTROL_JITTER_BUCKETS_US               { 10, 25, 50, 100, 250, 500, 1000 } // upper edges, one more bucket above
+#define CONTROL_JITTER_REPORT_MS                10000   // jitter histogram log interval
+#define CONTROL_STOP_RESEND_MS                  100     // stop frames refresh while not Active, well below the VESC timeout
+
+
 // ============================================================================
 // Sensors
 // ============================================================================
@@ -114,7 +197,7 @@
 #define NUM_MOTOR_POLES             5.0
 #define GEAR_RATIO                  59.0/22.0
 
-// Steering mapping (deg->rad pairs)
+// Steering mapping ({motor angle, wheel steer angle} pairs in rad)
 #define STEERING_MAPPING { \
     {0.0f,      0.0f    }, \
     {0.523599f, 0.15708f}, \
@@ -129,6 +212,17 @@
 #define MAX_WHEEL_STEER_DEG         15
 #define ENCODER_OFFSET              0.3f
 #define STEERING_RATIO              4.0f // for steering to encoder angle in radians
+#define STEERING_LUT_SIZE           64   // samples of the resampled STEERING_MAPPING
+
+// Steering position loop (SteeringMode), the mode and gains can be changed per run
+// with the GKC_ID_STEERING_CONFIG packet
+#define STEERING_CONTROL_MODE       0     // 0 = VESC position loop only, 1 = MCU PID on STATUS_4 feedback
+#define STEERING_PID_KP             1.2f  // correction per wheel rad of error
+#define STEERING_PID_KI             4.0f  // 1/s
+#define STEERING_PID_KD             0.05f // s, on the measured angle
+#define STEERING_PID_KFF            1.0f  // feedforward scale of the mapped setpoint
+#define STEERING_PID_I_LIMIT        0.08f // rad, max integral correction at the wheel
+#define STEERING_PID_OUTPUT_LIMIT   0.15f // rad, max total correction at the wheel
 
 // ELRS radio channel mapping
 #define ELRS_THROTTLE               1
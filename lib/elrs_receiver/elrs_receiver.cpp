@@ -20,8 +20,9 @@ bool elrc_receiver::gatherData(){
     void* channelsPointer = (void*)(&structuredChannel);
     messageAvailable = false;
 
-    bool hasRead = serial_port.read(payload,256);
-    if(!hasRead)return messageAvailable;
+    // Non-blocking: -EAGAIN without new bytes, which must not re-parse the last frame
+    ssize_t hasRead = serial_port.read(payload,256);
+    if(hasRead <= 0)return messageAvailable;
     // printf("%x %x %x ", payload[0], payload[1], payload[2]);
     // printf("%x %x %x ", payload[3], payload[4], payload[5]);
     // printf("%x %x %x\n", payload[6], payload[7], payload[8]);
@@ -0,0 +1,125 @@
+#!/usr/bin/env python3
+"""Decoder for the firmware's binary log packets (GKC_ID_BINARY_LOG, 0xB2).
+
+The firmware sends format IDs and raw arguments instead of text. The format
+strings are read from src/Tools/log_formats.hpp, so this tool must be run
+against the same source tree the firmware was built from.
+
+    python3 log_decode.py --port /dev/ttyUSB0
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+import time
+
+import serial
+
+BINARY_LOG_ID = 0xB2
+DEFAULT_FORMATS = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                               'src', 'Tools', 'log_formats.hpp')
+
+ENTRY_PATTERN = re.compile(r'X\(\s*(\w+)\s*,\s*(\w+)\s*,\s*((?:"(?:[^"\\]|\\.)*"\s*(?:\\\s*)?)+)\)')
+LITERAL_PATTERN = re.compile(r'"((?:[^"\\]|\\.)*)"')
+CONVERSION_PATTERN = re.compile(r'%[-+ #0-9.]*([diuxXcfeg%])')
+
+
+def load_formats(path=DEFAULT_FORMATS):
+    """Return [(name, severity, format)] indexed by format ID"""
+    with open(path) as f:
+        source = f.read()
+    start = source.index('#define GKC_LOG_FORMATS')
+    formats = []
+    for name, severity, literals in ENTRY_PATTERN.findall(source[start:]):
+        text = ''.join(LITERAL_PATTERN.findall(literals))
+        formats.append((name, severity, text.encode().decode('unicode_escape')))
+    return formats
+
+
+def format_record(fmt, args):
+    """Apply a printf-style format to raw u32 arguments"""
+    values = []
+    for conversion in CONVERSION_PATTERN.findall(fmt):
+        if conversion == '%':
+            continue
+        raw = args[len(values)] if len(values) < len(args) else 0
+        if conversion in 'feg':
+            values.append(struct.unpack('<f', struct.pack('<I', raw))[0])
+        elif conversion in 'di':
+            values.append(struct.unpack('<i', struct.pack('<I', raw))[0])
+        else:
+            values.append(raw)
+    return fmt % tuple(values)
+
+
+def decode_binary_log(payload, formats):
+    """Decode one 0xB2 payload into (dropped, [(stamp_us, severity, name, text)])"""
+    if len(payload) < 2 or payload[0] != BINARY_LOG_ID:
+        return 0, []
+    dropped = payload[1]
+    records = []
+    index = 2
+    while index + 7 <= len(payload):
+        format_id, stamp_us, argc = struct.unpack_from('<HIB', payload, index)
+        index += 7
+        if index + 4 * argc > len(payload):
+            break
+        args = struct.unpack_from(f'<{argc}I', payload, index)
+        index += 4 * argc
+        if format_id < len(formats):
+            name, severity, fmt = formats[format_id]
+            records.append((stamp_us, severity, name, format_record(fmt, args)))
+        else:
+            records.append((stamp_us, 'UNKNOWN', f'#{format_id}', f'unknown format, args {list(args)}'))
+    return dropped, records
+
+
+def read_payloads(ser):
+    """Yield the payload of every valid frame read from the port"""
+    buffer = bytearray()
+    while True:
+        buffer.extend(ser.read(ser.in_waiting or 1))
+        while True:
+            start = buffer.find(0x02)
+            if start < 0:
+                buffer.clear()
+                break
+            del buffer[:start]
+            if len(buffer) < 2 or len(buffer) < buffer[1] + 5:
+                break
+            size = buffer[1]
+            if buffer[size + 4] != 0x03:
+                del buffer[:1]
+                continue
+            payload = bytes(buffer[2:2 + size])
+            del buffer[:size + 5]
+            yield payload
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode the firmware binary log')
+    parser.add_argument('--port', '-p', default='/dev/ttyUSB0', help='Serial port')
+    parser.add_argument('--baudrate', '-b', type=int, default=115200, help='Baud rate')
+    parser.add_argument('--formats', default=DEFAULT_FORMATS, help='Path to log_formats.hpp')
+    args = parser.parse_args()
+
+    formats = load_formats(args.formats)
+    ser = serial.Serial(args.port, args.baudrate, timeout=0.1)
+    try:
+        for payload in read_payloads(ser):
+            dropped, records = decode_binary_log(payload, formats)
+            if dropped:
+                print(f'{time.strftime("%H:%M:%S")} {dropped} records dropped on the MCU')
+            for stamp_us, severity, _, text in records:
+                print(f'{stamp_us / 1e6:12.6f} {severity:<7} {text}')
+            sys.stdout.flush()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        ser.close()
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,138 @@
+#!/usr/bin/env python3
+"""Live viewer for the firmware's profiler reports (GKC_ID_PROFILER_REPORT, 0xB6).
+
+The firmware sends the latency histogram of each profiler in
+src/Tools/global_profilers.hpp, one profiler per packet, every
+PROFILER_REPORT_MS. Each report covers the time since the previous report of
+the same profiler. This tool requests a report, optionally changes the
+interval, and keeps a table of the percentiles on screen.
+
+    python3 profiler_view.py --port /dev/ttyUSB0 --interval 500
+"""
+
+import argparse
+import struct
+import sys
+import time
+
+import serial
+
+from log_decode import read_payloads
+
+PROFILER_REPORT_ID = 0xB6
+HEADER = struct.Struct('<BBBBIHIIBB')
+PERCENTILES = (0.5, 0.9, 0.99)
+
+
+def bucket_bounds(bucket, sub_bits):
+    """Return (lower bound, width) in ticks, as ProfilerHistogram in src/Tools/profiler.hpp"""
+    sub_count = 1 << sub_bits
+    if bucket < sub_count:
+        return bucket, 1
+    lower = (sub_count + (bucket & (sub_count - 1))) << ((bucket >> sub_bits) - 1)
+    width = 1 if bucket < 2 * sub_count else 1 << ((bucket >> sub_bits) - 1)
+    return lower, width
+
+
+def decode_profiler_report(payload):
+    """Decode one 0xB6 payload into a dict, or None if it is not a report"""
+    if len(payload) < HEADER.size or payload[0] != PROFILER_REPORT_ID:
+        return None
+    (_, seq, probe, probe_count, tick_rate, window_ms, count, max_ticks, sub_bits,
+     name_len) = HEADER.unpack_from(payload)
+    index = HEADER.size
+    name = bytes(payload[index:index + name_len]).decode('utf-8', errors='replace')
+    index += name_len
+    buckets = {}
+    while index + 6 <= len(payload):
+        bucket, bucket_count = struct.unpack_from('<HI', payload, index)
+        buckets[bucket] = bucket_count
+        index += 6
+    return {
+        'seq': seq, 'probe': probe, 'probe_count': probe_count, 'tick_rate': tick_rate,
+        'window_ms': window_ms, 'count': count, 'max_ticks': max_ticks, 'sub_bits': sub_bits,
+        'name': name, 'buckets': buckets,
+    }
+
+
+def percentile_us(report, fraction):
+    """Middle of the bucket holding the fraction of samples, the same estimate the firmware uses"""
+    count = report['count']
+    if count == 0:
+        return 0.0
+    rank = int(fraction * (count - 1)) + 1
+    seen = 0
+    ticks = report['max_ticks']
+    for bucket in sorted(report['buckets']):
+        seen += report['buckets'][bucket]
+        if seen >= rank:
+            lower, width = bucket_bounds(bucket, report['sub_bits'])
+            ticks = min(lower + width // 2, report['max_ticks'])
+            break
+    return ticks * 1e6 / report['tick_rate']
+
+
+class ProfilerReports:
+    """Latest report of every profiler, with continuation packets merged"""
+
+    def __init__(self):
+        self.reports = {}
+
+    def update(self, report):
+        last = self.reports.get(report['probe'])
+        if last is not None and last['seq'] == report['seq'] and last['count'] == report['count']:
+            last['buckets'].update(report['buckets'])
+        else:
+            self.reports[report['probe']] = report
+
+    def render(self):
+        lines = [f"{'probe':<10} {'window':>7} {'rate/s':>8} " +
+                 ' '.join(f"{f'p{p * 100:g} us':>10}" for p in PERCENTILES) + f" {'max us':>10}"]
+        for probe in sorted(self.reports):
+            report = self.reports[probe]
+            rate = report['count'] * 1000.0 / report['window_ms'] if report['window_ms'] else 0.0
+            lines.append(f"{report['name']:<10} {report['window_ms']:>5}ms {rate:>8.1f} " +
+                         ' '.join(f'{percentile_us(report, p):>10.1f}' for p in PERCENTILES) +
+                         f" {report['max_ticks'] * 1e6 / report['tick_rate']:>10.1f}")
+        return '\n'.join(lines)
+
+
+def request_payload(interval_ms=None):
+    """Payload asking for a report now, and for one every interval_ms when given"""
+    payload = bytearray([PROFILER_REPORT_ID])
+    if interval_ms is not None:
+        payload.extend(struct.pack('<H', interval_ms))
+    return payload
+
+
+def main():
+    from serial_test import calc_crc16_custom
+
+    parser = argparse.ArgumentParser(description='Show the firmware profiler percentiles')
+    parser.add_argument('--port', '-p', default='/dev/ttyUSB0', help='Serial port')
+    parser.add_argument('--baudrate', '-b', type=int, default=115200, help='Baud rate')
+    parser.add_argument('--interval', type=int, default=None,
+                        help='Report interval in ms, 0 = on request only (default: firmware PROFILER_REPORT_MS)')
+    args = parser.parse_args()
+
+    ser = serial.Serial(args.port, args.baudrate, timeout=0.1)
+    payload = request_payload(args.interval)
+    ser.write(bytes([0x02, len(payload)]) + payload + struct.pack('<H', calc_crc16_custom(payload)) + bytes([0x03]))
+
+    reports = ProfilerReports()
+    try:
+        for payload in read_payloads(ser):
+            report = decode_profiler_report(payload)
+            if report is None:
+                continue
+            reports.update(report)
+            sys.stdout.write('\x1b[H\x1b[2J' + time.strftime('%H:%M:%S') + '\n' + reports.render() + '\n')
+            sys.stdout.flush()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        ser.close()
+
+
+if __name__ == '__main__':
+    main()
@@ -4,6 +4,9 @@ import time
 import argparse
 import logging
 
+from log_decode import decode_binary_log, load_formats
+from profiler_view import decode_profiler_report, percentile_us
+
 logging.basicConfig(
     level=logging.INFO,
     format='%(asctime)s - %(levelname)s - %(message)s'
@@ -67,6 +70,41 @@ class PacketType:
     SHUTDOWN2 = 0xA3
     LOG = 0xAD
     RC_CONTROL = 0xAE
+    SENSOR_AGE = 0xB0  # firmware-local, see src/Comm/gkc_frame.hpp
+    STEERING_CONFIG = 0xB1  # firmware-local, host -> MCU
+    BINARY_LOG = 0xB2  # firmware-local, decoded with log_decode.py
+    LOG_CONFIG = 0xB3  # firmware-local, host -> MCU
+    THREAD_STATS = 0xB4  # firmware-local, per-thread CPU, stack and wakeup statistics
+    THREAD_INFO = 0xB5  # firmware-local, host -> MCU request, MCU -> host thread names and stacks
+    PROFILER_REPORT = 0xB6  # firmware-local, profiler histograms, shown live by profiler_view.py
+    RESET_CAUSE = 0xB7  # firmware-local, why the previous boot ended, sent before the first heartbeat
+
+# ResetCause values (must match src/Watchdog/reset_record.hpp)
+RESET_CAUSES = ('unknown', 'power on', 'reset pin', 'brown out', 'software', 'watchable timeout',
+                'hardware watchdog', 'host request', 'lockup')
+
+# Steering position loop modes (must match SteeringMode in src/Actuation/steering_controller.hpp)
+STEERING_MODES = {
+    'vesc': 0,
+    'mcu': 1,
+}
+
+# LogPacket::Severity values, for the lowest severity the firmware sends
+LOG_SEVERITIES = {
+    'debug': 0,
+    'info': 1,
+    'warning': 2,
+    'error': 3,
+    'fatal': 4,
+}
+
+# Link speed negotiation codes carried in the Handshake1 sequence number top byte
+# (must match LINK_BAUD_RATES in include/config.hpp)
+LINK_BAUD_CODES = {
+    115200: 1,
+    921600: 2,
+    2000000: 3,
+}
 
 class GokartController:
     """Controller for serial communication with the gokart"""
@@ -91,8 +129,12 @@ class GokartController:
         """Initialize serial connection to gokart"""
         self.ser = serial.Serial(port, baudrate)
         self.seq_number = 0
+        self.last_handshake_reply = None
         self.rolling_counter = 0
         self.debug = debug
+        self.log_formats = load_formats()
+        self.thread_names = {}
+        self.show_thread_stats = False
         
         # Create CRC function using crcmod
         self.crc_func = calc_crc16_custom
@@ -196,6 +238,63 @@ class GokartController:
                 
             # logger.info(f"Decoded Heartbeat: counter={counter}, state={state_name}")
             
+        elif packet_type == PacketType.HANDSHAKE2 and len(payload) >= 5:
+            self.last_handshake_reply = struct.unpack("<I", bytes(payload[1:5]))[0]
+            logger.debug(f"Decoded Handshake2: seq_number={self.last_handshake_reply & 0xFFFFFF}, "
+                         f"baud_code={self.last_handshake_reply >> 24}")
+
+        elif packet_type == PacketType.SENSOR_AGE and len(payload) >= 13:
+            ages = struct.unpack("<III", bytes(payload[1:13]))
+            names = ("steering", "speed", "brake_pressure")
+            fields = ", ".join(
+                f"{name}={'never' if age == 0xFFFFFFFF else f'{age / 1000.0:.2f}ms'}"
+                for name, age in zip(names, ages))
+            logger.debug(f"Decoded Sensor age: {fields}")
+
+        elif packet_type == PacketType.BINARY_LOG:
+            dropped, records = decode_binary_log(payload, self.log_formats)
+            if dropped:
+                logger.warning(f"Binary log: {dropped} records dropped on the MCU")
+            for stamp_us, severity, _, text in records:
+                logger.info(f"Decoded Binary log: t={stamp_us / 1e6:.6f}s severity={severity}, message={text}")
+
+        elif packet_type == PacketType.THREAD_INFO and len(payload) >= 2:
+            index = 2
+            for _ in range(payload[1]):
+                thread, priority, stack_size, max_used, name_len = struct.unpack_from("<BBHHB", payload, index)
+                index += 7
+                name = bytes(payload[index:index + name_len]).decode('utf-8', errors='replace')
+                index += name_len
+                self.thread_names[thread] = name
+                logger.info(f"Decoded Thread info: {name} priority={priority}, "
+                            f"stack {max_used}/{stack_size} bytes used")
+
+        elif packet_type == PacketType.THREAD_STATS and len(payload) >= 4:
+            window_ms, count = struct.unpack_from("<HB", payload, 1)
+            lines = [f"Decoded Thread stats over {window_ms}ms:",
+                     f"  {'thread':<20} {'cpu%':>6} {'headroom':>8} {'wakeups':>7} {'mean us':>7} {'max us':>7}"]
+            for i in range(count):
+                thread, cpu, headroom, wakeups, mean_us, max_us = struct.unpack_from("<BHHHHH", payload, 4 + i * 11)
+                name = "other" if thread == 0xFF else self.thread_names.get(thread, f"#{thread}")
+                stack = "" if thread == 0xFF else headroom
+                lines.append(f"  {name:<20} {cpu / 100.0:6.2f} {stack:>8} {wakeups:>7} {mean_us:>7} {max_us:>7}")
+            (logger.info if self.show_thread_stats else logger.debug)("\n".join(lines))
+
+        elif packet_type == PacketType.PROFILER_REPORT:
+            report = decode_profiler_report(payload)
+            if report is not None:
+                logger.debug(f"Decoded Profiler report: {report['name']} n={report['count']} "
+                             f"over {report['window_ms']}ms, p50={percentile_us(report, 0.5):.1f}us, "
+                             f"p99={percentile_us(report, 0.99):.1f}us, "
+                             f"max={report['max_ticks'] * 1e6 / report['tick_rate']:.1f}us")
+
+        elif packet_type == PacketType.RESET_CAUSE and len(payload) >= 4:
+            cause, hardware_reason, name_len = payload[1], payload[2], payload[3]
+            name = bytes(payload[4:4 + name_len]).decode('utf-8', errors='replace')
+            cause_name = RESET_CAUSES[cause] if cause < len(RESET_CAUSES) else f"#{cause}"
+            logger.info(f"Decoded Reset cause: {cause_name}" + (f" ({name})" if name else "") +
+                        f", reset_reason_t={hardware_reason}")
+
         elif packet_type == PacketType.FIRMWARE_VERSION and len(payload) >= 4:
             major = payload[1]
             minor = payload[2]
@@ -210,18 +309,52 @@ class GokartController:
             except:
                 logger.info(f"Decoded Log: severity={severity}, message=<binary data>")
     
-    def send_handshake(self):
-        """Send handshake packet and wait for response"""
+    def send_handshake(self, baud_code=0):
+        """Send handshake packet and wait for response
+
+        The top byte of the sequence number optionally requests a link speed,
+        see LINK_BAUD_CODES.
+        """
         logger.info("Initiating handshake...")
         self.seq_number += 1
         # Handshake1 packet format
         handshake_payload = bytearray([PacketType.HANDSHAKE1])
-        handshake_payload.extend(struct.pack("<I", self.seq_number))
+        handshake_payload.extend(struct.pack("<I", (self.seq_number & 0xFFFFFF) | (baud_code << 24)))
         response = self.send_packet(handshake_payload)
         if self.debug:
             logger.debug(f"Handshake response: {response.hex()}")
         return response
     
+    def negotiate_baud(self, baudrate):
+        """Ask the gokart to switch the link to a faster baud rate
+
+        The MCU echoes the code in its Handshake2 reply and switches after it.
+        We then switch too and handshake again at the new rate to confirm,
+        otherwise the MCU falls back to the default rate.
+        """
+        if baudrate not in LINK_BAUD_CODES:
+            logger.error(f"Unsupported link baud rate {baudrate}, "
+                         f"choose one of {list(LINK_BAUD_CODES)}")
+            return False
+
+        code = LINK_BAUD_CODES[baudrate]
+        self.last_handshake_reply = None
+        self.send_handshake(code)
+        if self.last_handshake_reply is None or (self.last_handshake_reply >> 24) != code:
+            logger.warning(f"Gokart declined link baud rate {baudrate}")
+            return False
+
+        self.ser.baudrate = baudrate
+        self.last_handshake_reply = None
+        self.send_handshake(code)
+        if self.last_handshake_reply is None:
+            logger.error(f"No reply at {baudrate} baud, gokart will fall back to 115200")
+            self.ser.baudrate = 115200
+            return False
+
+        logger.info(f"Link switched to {baudrate} baud")
+        return True
+
     def send_config(self):
         """Send configuration packet"""
         logger.info("Sending configuration...")
@@ -272,6 +405,39 @@ class GokartController:
             logger.debug(f"Control response: {response.hex() if response else 'None'}")
         return response
     
+    def send_steering_config(self, mode, kp, ki, kd, kff=1.0, i_limit=0.08):
+        """Select the steering position loop and its gains for this run
+
+        Args:
+            mode: 'vesc' (VESC PID only) or 'mcu' (MCU PID on STATUS_4 feedback)
+            kp, ki, kd, kff, i_limit: see STEERING_PID_* in include/config.hpp
+        """
+        logger.info(f"Sending steering config: mode={mode}, kp={kp}, ki={ki}, kd={kd}, kff={kff}, i_limit={i_limit}")
+        payload = bytearray([PacketType.STEERING_CONFIG, STEERING_MODES[mode]])
+        payload.extend(struct.pack("<fffff", kp, ki, kd, kff, i_limit))
+        return self.send_packet(payload)
+
+    def send_log_config(self, severity):
+        """Set the lowest severity of the log messages the firmware sends
+
+        Args:
+            severity: one of LOG_SEVERITIES, applies to LogPackets and binary log records
+        """
+        logger.info(f"Sending log config: severity={severity}")
+        payload = bytearray([PacketType.LOG_CONFIG, LOG_SEVERITIES[severity]])
+        return self.send_packet(payload)
+
+    def request_thread_info(self):
+        """Request the thread names and stack sizes, followed by an immediate stats report"""
+        logger.info("Requesting thread info...")
+        self.show_thread_stats = True
+        return self.send_packet(bytearray([PacketType.THREAD_INFO]))
+
+    def request_reset_cause(self):
+        """Ask why the previous boot ended, the firmware also sends it before its first heartbeat"""
+        logger.info("Requesting reset cause...")
+        return self.send_packet(bytearray([PacketType.RESET_CAUSE]))
+
     def get_firmware_version(self):
         """Request firmware version"""
         logger.info("Requesting firmware version...")
@@ -335,6 +501,17 @@ def main():
                       help='Serial port (default: /dev/ttyUSB0)')
     parser.add_argument('--baudrate', '-b', type=int, default=115200, 
                       help='Baud rate (default: 115200)')
+    parser.add_argument('--link-baud', type=int, default=None,
+                      help='Negotiate a faster link after connecting (921600 or 2000000)')
+    parser.add_argument('--steering-mode', choices=sorted(STEERING_MODES), default=None,
+                      help='Steering position loop for this run (default: firmware STEERING_CONTROL_MODE)')
+    parser.add_argument('--steering-gains', type=float, nargs=5, default=[1.2, 4.0, 0.05, 1.0, 0.08],
+                      metavar=('KP', 'KI', 'KD', 'KFF', 'I_LIMIT'),
+                      help='Gains sent with --steering-mode (default: 1.2 4.0 0.05 1.0 0.08)')
+    parser.add_argument('--log-severity', choices=list(LOG_SEVERITIES), default=None,
+                      help='Lowest severity of firmware log messages sent to the host (default: firmware config)')
+    parser.add_argument('--thread-stats', action='store_true',
+                      help='Request thread info and print the per-thread statistics the firmware reports')
     parser.add_argument('--debug', '-d', action='store_true', 
                       help='Enable debug mode with verbose logging')
     
@@ -348,8 +525,22 @@ def main():
             debug=args.debug
         )
 
+        if args.link_baud:
+            controller.negotiate_baud(args.link_baud)
+
+        if args.log_severity:
+            controller.send_log_config(args.log_severity)
+
+        if args.thread_stats:
+            controller.request_thread_info()
+
+        controller.request_reset_cause()
+
         # Run the default demo sequence
         controller.initialize_system()
+
+        if args.steering_mode:
+            controller.send_steering_config(args.steering_mode, *args.steering_gains)
         
         controller.get_firmware_version()
         time.sleep(0.5)
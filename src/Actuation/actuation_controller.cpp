@@ -10,25 +10,39 @@
 #include "Actuation/vesc_can_tools.hpp"
 #include "config.hpp"
 #include <algorithm>
+#include <cmath>
 
 namespace tritonai::gkc {
 
     ActuationController::ActuationController(ILogger* logger) : m_Logger(logger) {
+        SetSteeringFeedbackCallback(callback(&m_SteeringController, &SteeringController::OnFeedback));
         InitializeCan();
         m_Logger->SendLog(LogPacket::Severity::INFO, "ActuationController initialized with CAN callbacks");
     }
 
     void ActuationController::SetThrottleCmd(float cmd) {
         cmd = ActuationController::Clamp(cmd, THROTTLE_MAX_FORWARD_SPEED, -1.0f*THROTTLE_MAX_REVERSE_SPEED);
-        CommCanSetSpeed(cmd);
+        // Only speeding up away from zero is shaped. Letting off goes out at
+        // once, and a reversal restarts the ramp from standstill
+        const float output = m_ThrottleShaper.GetOutput();
+        if (cmd * output <= 0.0f) {
+            m_ThrottleShaper.Reset(0.0f);
+        } else if (std::fabs(cmd) < std::fabs(output)) {
+            m_ThrottleShaper.Reset(cmd);
+        }
+        m_ThrottleShaper.SetTarget(cmd);
+        m_ThrottleReleased = false;
     }
 
     void ActuationController::FullRelRevCurrentBrake() {
         CommCanSetCurrentBrakeRel(THROTTLE_CAN_ID, 1.0);
+        // Start the next drive command from standstill
+        m_ThrottleShaper.Reset(0.0f);
+        m_ThrottleReleased = true;
     }
 
     void ActuationController::SetSteeringCmd(float cmd) {
-        CommCanSetAngle(cmd);
+        m_SteeringShaper.SetTarget(cmd);
         // Log the command for steering PID tuning
         // float motorAngle = cmd * STEERING_RATIO + ENCODER_OFFSET;
         // float radToDeg = 180.0 / M_PI * motorAngle;
@@ -37,13 +51,37 @@ namespace tritonai::gkc {
 
     void ActuationController::SetBrakeCmd(float cmd) {
         CommCanSetBrakePosition(cmd);
+        // Never drive against the brake, Update sends zero speed this tick
+        if (cmd > 0.0f) {
+            m_ThrottleShaper.Reset(0.0f);
+        }
     }
 
-    float ActuationController::GetSteeringAngle() const {
+    void ActuationController::Update(float dtS) {
+        m_SteeringController.Command(m_SteeringShaper.Update(dtS));
+        if (!m_ThrottleReleased) {
+            CommCanSetSpeed(m_ThrottleShaper.Update(dtS));
+        }
+    }
+
+    void ActuationController::SetThrottleLimits(float slewRate, float jerkLimit) {
+        m_ThrottleShaper.SetLimits(slewRate, jerkLimit);
+    }
+
+    void ActuationController::SetSteeringLimits(float slewRate, float jerkLimit) {
+        m_SteeringShaper.SetLimits(slewRate, jerkLimit);
+    }
+
+    void ActuationController::SetSteeringMode(SteeringMode mode, const SteeringGains& gains) {
+        m_SteeringController.SetGains(gains);
+        m_SteeringController.SetMode(mode);
+    }
+
+    Stamped<float> ActuationController::GetSteeringAngle() const {
         return CommCanGetAngle();
     }
 
-    float ActuationController::GetCurrentSpeed() const {
+    Stamped<float> ActuationController::GetCurrentSpeed() const {
         return CommCanGetSpeed();
     }
 
@@ -12,6 +12,9 @@
 #include "Tools/logger.hpp"
 #include "mbed.h"
 #include "Sensor/sensor_reader.hpp"
+#include "Tools/stamped_value.hpp"
+#include "Actuation/setpoint_shaper.hpp"
+#include "Actuation/steering_controller.hpp"
 #include <cstdint>
 
 namespace tritonai::gkc {
@@ -20,11 +23,41 @@ namespace tritonai::gkc {
     public:
         explicit ActuationController(ILogger* logger);
 
+        /**
+         * @brief Set the throttle and steering targets, sent shaped by Update
+         *
+         * Throttle is only shaped while it moves away from zero.
+         */
         void SetThrottleCmd(float cmd);
         void SetSteeringCmd(float cmd);
+
+        /**
+         * @brief Send the brake command right away, braking is never shaped
+         *
+         * Any brake also cuts the throttle to zero, a later throttle command ramps up from standstill.
+         */
         void SetBrakeCmd(float cmd);
-        float GetSteeringAngle() const;
-        float GetCurrentSpeed() const;
+
+        /**
+         * @brief Advance throttle and steering toward their targets and send them
+         * @param dtS Control period in seconds
+         */
+        void Update(float dtS);
+
+        /**
+         * @brief True once the shaped steering reached its target, Update then sends the same angle
+         */
+        bool IsSteeringSettled() const { return m_SteeringShaper.GetOutput() == m_SteeringShaper.GetTarget(); }
+
+        void SetThrottleLimits(float slewRate, float jerkLimit);
+        void SetSteeringLimits(float slewRate, float jerkLimit);
+
+        /**
+         * @brief Select who closes the steering position loop, see SteeringController
+         */
+        void SetSteeringMode(SteeringMode mode, const SteeringGains& gains);
+        Stamped<float> GetSteeringAngle() const;
+        Stamped<float> GetCurrentSpeed() const;
         void FullRelRevCurrentBrake();
 
         template <typename T>
@@ -39,6 +72,10 @@ namespace tritonai::gkc {
 
     private:
         ILogger* m_Logger;
+        SetpointShaper m_ThrottleShaper{THROTTLE_SLEW_RATE, THROTTLE_JERK_LIMIT};
+        SetpointShaper m_SteeringShaper{STEERING_SLEW_RATE, STEERING_JERK_LIMIT};
+        SteeringController m_SteeringController;
+        bool m_ThrottleReleased{true}; // brake current is commanded, don't send speed
     };
 
 } // namespace tritonai::gkc
\ No newline at end of file
@@ -0,0 +1,38 @@
+/**
+ * @file fast_stop.cpp
+ * @brief Implementation of the interrupt-safe emergency stop
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#include "Actuation/fast_stop.hpp"
+#include "Actuation/vesc_can_tools.hpp"
+#include "Tools/timestamp.hpp"
+#include "config.hpp"
+
+namespace tritonai::gkc {
+
+    FastStop::FastStop()
+        : m_Frames{MakeBrakePositionFrame(EMERGENCY_BRAKE_PRESSURE), MakeCurrentBrakeRelFrame(THROTTLE_CAN_ID, 1.0f)}
+    {
+    }
+
+    void FastStop::Trigger() {
+        if (m_Latched.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        const uint32_t startUs = GetTimestampUs();
+        can2.SendUrgent(m_Frames, sizeof(m_Frames) / sizeof(m_Frames[0]));
+        m_SendUs.store(GetTimestampUs() - startUs, std::memory_order_relaxed);
+        m_Unreported.store(true, std::memory_order_release);
+    }
+
+    bool FastStop::TakeTrigger(uint32_t& sendUs) {
+        if (!m_Unreported.exchange(false, std::memory_order_acquire)) {
+            return false;
+        }
+        sendUs = m_SendUs.load(std::memory_order_relaxed);
+        return true;
+    }
+
+} // namespace tritonai::gkc
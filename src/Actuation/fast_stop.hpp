@@ -0,0 +1,64 @@
+/**
+ * @file fast_stop.hpp
+ * @brief Emergency stop that reaches the CAN bus from interrupt context
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "mbed.h"
+
+namespace tritonai::gkc {
+
+    /**
+     * @class FastStop
+     * @brief Full brake and throttle release without the state machine, the control loop or logging
+     *
+     * The regular stop submits a SAFETY setpoint that the control loop sends
+     * on its next tick, and logs on the way. Trigger writes prebuilt full
+     * brake and CURRENT_BRAKE_REL frames straight to the CAN mailboxes and
+     * discards the setpoints still waiting, so it costs no more than a
+     * critical section. It then latches: the control loop keeps braking until
+     * Release, whatever the state machine does meanwhile.
+     *
+     * Trigger takes no lock and does not log. A thread reports the trigger
+     * later with TakeTrigger.
+     *
+     * Threading: Trigger and IsLatched from any thread or ISR, Release and
+     * TakeTrigger from threads.
+     */
+    class FastStop {
+    public:
+        FastStop();
+
+        /**
+         * @brief Send the stop frames and latch, does nothing while latched
+         */
+        void Trigger();
+
+        bool IsLatched() const { return m_Latched.load(std::memory_order_acquire); }
+
+        /**
+         * @brief Hand braking back to the control loop
+         */
+        void Release() { m_Latched.store(false, std::memory_order_release); }
+
+        /**
+         * @brief Check for a trigger not reported yet
+         * @param sendUs Set to the time Trigger spent putting the frames on their way
+         * @return True once per trigger
+         */
+        bool TakeTrigger(uint32_t& sendUs);
+
+    private:
+        CANMessage m_Frames[2]; // built once, Trigger must not compute
+        std::atomic<bool> m_Latched{false};
+        std::atomic<bool> m_Unreported{false};
+        std::atomic<uint32_t> m_SendUs{0};
+    };
+
+} // namespace tritonai::gkc
@@ -0,0 +1,145 @@
+/**
+ * @file irq_can.cpp
+ * @brief Implementation of the interrupt-driven CAN bus
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#include "irq_can.hpp"
+#include "Tools/timestamp.hpp"
+
+namespace tritonai::gkc {
+
+    IrqCan::IrqCan(PinName rd, PinName td, int hz)
+        : CAN(rd, td, hz)
+    {
+    }
+
+    void IrqCan::StartIrq() {
+#if defined(CAN_MCR_TXFP)
+        // bxCAN sends the mailbox with the lowest ID first by default, so two
+        // frames with the same ID could leave newest first; use request order
+        _can.CanHandle.Instance->MCR |= CAN_MCR_TXFP;
+#endif
+        CAN::attach(callback(this, &IrqCan::OnRxIrq), CAN::RxIrq);
+        CAN::attach(callback(this, &IrqCan::OnTxIrq), CAN::TxIrq);
+        // The STM32 HAL raises the bus error interrupt on bus-off
+        CAN::attach(callback(this, &IrqCan::OnBusOffIrq), CAN::BeIrq);
+
+        CriticalSectionLock lock;
+        PumpTx();
+    }
+
+    bool IrqCan::Send(const CANMessage& msg) {
+        CriticalSectionLock lock;
+
+        TxSlot* freeSlot = nullptr;
+        for (auto& slot : m_TxSlots) {
+            if (slot.pending && slot.msg.id == msg.id && slot.msg.format == msg.format) {
+                // Keep the slot's place in line, only the payload is newer
+                slot.msg = msg;
+                m_TxSupersededCount++;
+                PumpTx();
+                return true;
+            }
+            if (!slot.pending && freeSlot == nullptr) {
+                freeSlot = &slot;
+            }
+        }
+
+        if (freeSlot == nullptr) {
+            m_TxDroppedCount++;
+            return false;
+        }
+        freeSlot->msg = msg;
+        freeSlot->order = m_TxOrder++;
+        freeSlot->pending = true;
+        PumpTx();
+        return true;
+    }
+
+    void IrqCan::SendUrgent(const CANMessage* msgs, size_t count) {
+        CriticalSectionLock lock;
+
+        // The waiting setpoints predate the urgent frames and must not follow them
+        for (auto& slot : m_TxSlots) {
+            if (slot.pending) {
+                slot.pending = false;
+                m_TxSupersededCount++;
+            }
+        }
+#if defined(CAN_TSR_ABRQ0)
+        // Same for the mailboxes; a frame already on the wire completes, the
+        // others free their mailbox and raise the TX interrupt. The RQCP, TXOK,
+        // ALST and TERR bits clear on a written 1, so no read-modify-write.
+        _can.CanHandle.Instance->TSR = CAN_TSR_ABRQ0 | CAN_TSR_ABRQ1 | CAN_TSR_ABRQ2;
+#elif defined(FDCAN1)
+        // FDCAN: cancel the requests still pending in the TX FIFO. A cancellation
+        // raises no interrupt mbed enables, so frames that still find the FIFO
+        // full leave on the next Send or TX complete, i.e. the next control tick.
+        const uint32_t pending = _can.CanHandle.Instance->TXBRP;
+        if (pending != 0) {
+            HAL_FDCAN_AbortTxRequest(&_can.CanHandle, pending);
+        }
+#endif
+
+        // Once one frame waits, the rest wait behind it to keep their order
+        bool waiting = false;
+        for (size_t i = 0; i < count && i < CAN_TX_SLOT_COUNT; i++) {
+            waiting = waiting || !can_write(&_can, msgs[i], 0);
+            if (waiting) {
+                m_TxSlots[i].msg = msgs[i];
+                m_TxSlots[i].order = m_TxOrder++;
+                m_TxSlots[i].pending = true;
+            }
+        }
+    }
+
+    void IrqCan::PumpTx() {
+        // Called with interrupts locked; fill mailboxes oldest slot first
+        while (true) {
+            TxSlot* oldest = nullptr;
+            for (auto& slot : m_TxSlots) {
+                if (slot.pending &&
+                    (oldest == nullptr || static_cast<int32_t>(slot.order - oldest->order) < 0)) {
+                    oldest = &slot;
+                }
+            }
+
+            if (oldest == nullptr || !can_write(&_can, oldest->msg, 0)) {
+                return;
+            }
+            oldest->pending = false;
+        }
+    }
+
+    void IrqCan::WaitEvent() {
+        while (m_RxRing.IsEmpty() && !m_BusOff) {
+            m_Flags.wait_any(RX_FLAG | BUS_OFF_FLAG);
+        }
+    }
+
+    void IrqCan::OnRxIrq() {
+        // Drain the whole FIFO, the interrupt stays pending while it is non-empty
+        CanRxFrame frame;
+        while (can_read(&_can, &frame.msg, 0)) {
+            frame.stampUs = GetTimestampUs();
+            if (!m_RxRing.Push(frame)) {
+                m_RxOverflowCount++;
+            }
+        }
+        m_Flags.set(RX_FLAG);
+    }
+
+    void IrqCan::OnTxIrq() {
+        CriticalSectionLock lock;
+        PumpTx();
+    }
+
+    void IrqCan::OnBusOffIrq() {
+        m_BusOffCount++;
+        m_BusOff = true;
+        m_Flags.set(BUS_OFF_FLAG);
+    }
+
+} // namespace tritonai::gkc
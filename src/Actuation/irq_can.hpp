@@ -0,0 +1,142 @@
+/**
+ * @file irq_can.hpp
+ * @brief Interrupt-driven CAN with a lock-free receive ring and latest-wins transmit slots
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "mbed.h"
+
+#include "config.hpp"
+#include "Tools/spsc_ring.hpp"
+
+namespace tritonai::gkc {
+
+    /**
+     * @brief Received CAN frame with its arrival time, see Tools/timestamp.hpp
+     */
+    struct CanRxFrame {
+        CANMessage msg;
+        uint32_t stampUs{0};
+    };
+
+    /**
+     * @class IrqCan
+     * @brief CAN bus whose receive FIFO and transmit mailboxes are serviced by interrupts
+     *
+     * CAN::read and CAN::write take a mutex and cannot be called from an ISR, so
+     * the interrupts go through the HAL directly.
+     *
+     * RX: the interrupt reads the FIFO, stamps every frame and pushes it into a
+     * lock-free ring. The dispatcher thread sleeps on an event flag until a frame
+     * arrives, so an idle bus costs no wakeups.
+     *
+     * TX: Send places the frame in one of CAN_TX_SLOT_COUNT static slots. A frame
+     * whose ID is already waiting replaces the waiting one in place, so only the
+     * latest setpoint per target goes out. Slots are moved into the hardware
+     * mailboxes in the order they were queued, from Send and from the
+     * TX-complete interrupt.
+     *
+     * SendUrgent skips the line: it discards every waiting slot, aborts the
+     * mailboxes not yet on the wire and writes its frames right away, for the
+     * emergency stop.
+     *
+     * Threading: Send from any thread, SendUrgent also from an ISR; one
+     * dispatcher thread consumes frames and services bus-off.
+     */
+    class IrqCan : public CAN {
+    public:
+        IrqCan(PinName rd, PinName td, int hz);
+
+        /**
+         * @brief Attach the interrupts, call once the RTOS is running and again after reset()
+         */
+        void StartIrq();
+
+        /**
+         * @brief Queue a frame for transmission, replacing a waiting frame with the same ID
+         * @return False if every slot is taken and the frame was dropped
+         */
+        bool Send(const CANMessage& msg);
+
+        /**
+         * @brief Put frames on the bus ahead of everything queued, which is discarded
+         *
+         * Pending mailboxes are aborted on bxCAN (F7) and pending TX FIFO
+         * requests cancelled on FDCAN (H7). Frames that find no free mailbox
+         * wait in slots and go first on the next TX interrupt or Send; on FDCAN
+         * a cancellation raises no interrupt, so that is the next Send. Safe in
+         * interrupt context.
+         * @param count At most CAN_TX_SLOT_COUNT frames
+         */
+        void SendUrgent(const CANMessage* msgs, size_t count);
+
+        /**
+         * @brief Block until a frame is received or the controller went bus-off
+         */
+        void WaitEvent();
+
+        /**
+         * @brief Take the oldest received frame
+         * @return False if no frame is buffered
+         */
+        bool PopFrame(CanRxFrame& frame) { return m_RxRing.Pop(frame); }
+
+        /**
+         * @brief Check and clear the bus-off flag
+         * @return True if the controller went bus-off since the last call
+         */
+        bool TakeBusOff() { return m_BusOff.exchange(false); }
+
+        /**
+         * @brief Number of frames dropped because the RX ring was full
+         */
+        uint32_t GetRxOverflowCount() const { return m_RxOverflowCount.load(); }
+
+        /**
+         * @brief Number of frames dropped because every TX slot was taken
+         */
+        uint32_t GetTxDroppedCount() const { return m_TxDroppedCount.load(); }
+
+        /**
+         * @brief Number of waiting frames replaced by a newer frame with the same ID
+         */
+        uint32_t GetTxSupersededCount() const { return m_TxSupersededCount.load(); }
+
+        /**
+         * @brief Number of times the controller entered bus-off
+         */
+        uint32_t GetBusOffCount() const { return m_BusOffCount.load(); }
+
+    private:
+        static constexpr uint32_t RX_FLAG = 1 << 0;
+        static constexpr uint32_t BUS_OFF_FLAG = 1 << 1;
+
+        struct TxSlot {
+            CANMessage msg;
+            uint32_t order{0};
+            bool pending{false};
+        };
+
+        SpscRing<CanRxFrame, CAN_RX_RING_SIZE> m_RxRing;
+        TxSlot m_TxSlots[CAN_TX_SLOT_COUNT];
+        uint32_t m_TxOrder{0};
+        EventFlags m_Flags;
+        std::atomic<bool> m_BusOff{false};
+        std::atomic<uint32_t> m_RxOverflowCount{0};
+        std::atomic<uint32_t> m_TxDroppedCount{0};
+        std::atomic<uint32_t> m_TxSupersededCount{0};
+        std::atomic<uint32_t> m_BusOffCount{0};
+
+        void PumpTx();
+        void OnRxIrq();
+        void OnTxIrq();
+        void OnBusOffIrq();
+    };
+
+} // namespace tritonai::gkc
@@ -0,0 +1,49 @@
+/**
+ * @file setpoint_shaper.cpp
+ * @brief Implementation of the setpoint shaper
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#include "setpoint_shaper.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace tritonai::gkc {
+
+    float SetpointShaper::Update(float dtS) {
+        const float error = m_Target - m_Output;
+        if (dtS <= 0.0f || (m_MaxRate <= 0.0f && m_MaxJerk <= 0.0f)) {
+            m_Output = m_Target;
+            m_Rate = 0.0f;
+            return m_Output;
+        }
+
+        // Fastest rate that still lets the jerk limit bring the rate to zero on target
+        float rateCap = std::fabs(error) / dtS;
+        if (m_MaxRate > 0.0f) {
+            rateCap = std::min(rateCap, m_MaxRate);
+        }
+        if (m_MaxJerk > 0.0f) {
+            rateCap = std::min(rateCap, std::sqrt(2.0f * m_MaxJerk * std::fabs(error)));
+        }
+        const float desiredRate = std::copysign(rateCap, error);
+
+        if (m_MaxJerk > 0.0f) {
+            const float maxStep = m_MaxJerk * dtS;
+            m_Rate += std::min(std::max(desiredRate - m_Rate, -maxStep), maxStep);
+        } else {
+            m_Rate = desiredRate;
+        }
+
+        m_Output += m_Rate * dtS;
+
+        // Landed on or passed the target
+        if ((m_Target - m_Output) * error <= 0.0f) {
+            m_Output = m_Target;
+            m_Rate = 0.0f;
+        }
+        return m_Output;
+    }
+
+} // namespace tritonai::gkc
@@ -0,0 +1,60 @@
+/**
+ * @file setpoint_shaper.hpp
+ * @brief Rate and jerk limited setpoint shaping
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#pragma once
+
+namespace tritonai::gkc {
+
+    /**
+     * @class SetpointShaper
+     * @brief Moves an output toward a target with a bounded rate and rate of change
+     *
+     * The output rate is limited to maxRate and the rate itself may only change
+     * by maxJerk per second, slowing down early enough to land on the target
+     * without overshoot. Calling Update at the control rate therefore fills in a
+     * smooth trajectory between sparse target updates. A limit of 0 disables it.
+     */
+    class SetpointShaper {
+    public:
+        SetpointShaper(float maxRate, float maxJerk)
+            : m_MaxRate(maxRate), m_MaxJerk(maxJerk) {}
+
+        void SetLimits(float maxRate, float maxJerk) {
+            m_MaxRate = maxRate;
+            m_MaxJerk = maxJerk;
+        }
+
+        void SetTarget(float target) { m_Target = target; }
+
+        /**
+         * @brief Jump to a value and stop moving, e.g. after an emergency stop
+         */
+        void Reset(float value) {
+            m_Output = value;
+            m_Target = value;
+            m_Rate = 0.0f;
+        }
+
+        /**
+         * @brief Advance the output by one control period
+         * @param dtS Time since the last update in seconds
+         * @return Shaped output
+         */
+        float Update(float dtS);
+
+        float GetOutput() const { return m_Output; }
+        float GetTarget() const { return m_Target; }
+
+    private:
+        float m_MaxRate;
+        float m_MaxJerk;
+        float m_Target{0.0f};
+        float m_Output{0.0f};
+        float m_Rate{0.0f};
+    };
+
+} // namespace tritonai::gkc
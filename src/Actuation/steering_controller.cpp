@@ -0,0 +1,81 @@
+/**
+ * @file steering_controller.cpp
+ * @brief Implementation of the MCU-side steering position loop
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#include "Actuation/steering_controller.hpp"
+#include "Actuation/vesc_can_tools.hpp"
+
+namespace tritonai::gkc {
+
+    SteeringController::SteeringController()
+        : m_Mode(static_cast<SteeringMode>(STEERING_CONTROL_MODE))
+    {
+        m_Gains.Write(SteeringGains{STEERING_PID_KP, STEERING_PID_KI, STEERING_PID_KD,
+                                    STEERING_PID_KFF, STEERING_PID_I_LIMIT});
+    }
+
+    void SteeringController::Command(float steerAngle) {
+        m_Target.store(steerAngle, std::memory_order_relaxed);
+        m_HasTarget.store(true, std::memory_order_release);
+
+        if (m_Mode.load() == SteeringMode::MCU_PID &&
+            CommCanGetAngle().IsFresh(CAN_FEEDBACK_TIMEOUT_MS)) {
+            return; // sent by OnFeedback
+        }
+
+        // Restart the outer loop from scratch once feedback is back
+        m_ResetPending.store(true);
+        CommCanSetAngle(steerAngle);
+    }
+
+    void SteeringController::OnFeedback(float steerAngle, uint32_t stampUs) {
+        if (m_Mode.load() != SteeringMode::MCU_PID || !m_HasTarget.load(std::memory_order_acquire)) {
+            return;
+        }
+
+        const SteeringGains gains = m_Gains.Read();
+        const float target = m_Target.load(std::memory_order_relaxed);
+
+        float dtS = (stampUs - m_LastStampUs) / 1e6f;
+        if (m_ResetPending.exchange(false) || dtS > CAN_FEEDBACK_TIMEOUT_MS / 1e3f) {
+            m_Integral = 0.0f;
+            m_LastAngle = steerAngle;
+            dtS = 0.0f;
+        }
+        m_LastStampUs = stampUs;
+
+        const float error = target - steerAngle;
+        const float lastIntegral = m_Integral;
+        float derivative = 0.0f;
+        if (dtS > 0.0f) {
+            m_Integral = Clamp(m_Integral + gains.ki * error * dtS, -gains.iLimit, gains.iLimit);
+            derivative = (steerAngle - m_LastAngle) / dtS;
+        }
+        m_LastAngle = steerAngle;
+
+        const float unclamped = gains.kp * error + m_Integral - gains.kd * derivative;
+        const float correction = Clamp(unclamped, -STEERING_PID_OUTPUT_LIMIT, STEERING_PID_OUTPUT_LIMIT);
+        if (correction != unclamped && (error > 0.0f) == (unclamped > 0.0f)) {
+            // Saturated, don't wind up further in the same direction
+            m_Integral = lastIntegral;
+        }
+
+        // Corrected through the calibration like the feedforward, so a wheel
+        // radian of correction moves the wheel a radian at any steer angle
+        CommCanSetMotorAngle(MapSteer2Motor(gains.kff * target + correction));
+    }
+
+    void SteeringController::SetMode(SteeringMode mode) {
+        m_ResetPending.store(true);
+        m_Mode.store(mode);
+    }
+
+    void SteeringController::SetGains(const SteeringGains& gains) {
+        m_Gains.Write(gains);
+        m_ResetPending.store(true);
+    }
+
+} // namespace tritonai::gkc
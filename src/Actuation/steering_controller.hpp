@@ -0,0 +1,81 @@
+/**
+ * @file steering_controller.hpp
+ * @brief Optional MCU-side outer position loop for the steering VESC
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "config.hpp"
+#include "Tools/seqlock.hpp"
+
+namespace tritonai::gkc {
+
+    enum class SteeringMode : uint8_t {
+        VESC_POSITION = 0, // mapped position setpoint, the VESC PID alone closes the loop
+        MCU_PID = 1,       // PID + feedforward on the measured wheel angle, at the feedback rate
+        COUNT
+    };
+
+    struct SteeringGains {
+        float kp;     // wheel rad of correction per wheel rad of error
+        float ki;     // 1/s
+        float kd;     // s, on the measured angle
+        float kff;    // feedforward scale of the mapped setpoint, 1 = VESC_POSITION command
+        float iLimit; // max integral contribution, wheel rad
+    };
+
+    /**
+     * @class SteeringController
+     * @brief Sends the steering position command, optionally corrected on the MCU
+     *
+     * In VESC_POSITION mode Command sends the mapped setpoint straight away, as
+     * before. In MCU_PID mode every decoded STATUS_4 angle runs one PID step on
+     * the wheel steer error and sends
+     *   MapSteer2Motor(kff * target + correction)
+     * so the outer loop runs at the CAN feedback rate instead of the control
+     * tick, with the VESC PID as the inner loop. The integral is clamped to
+     * iLimit and frozen while the correction saturates, the derivative acts on
+     * the measurement so setpoint steps don't kick. Without fresh feedback the
+     * command falls back to VESC_POSITION until feedback returns.
+     *
+     * Threading: Command from the control loop thread, OnFeedback from the CAN
+     * receive thread, SetMode/SetGains from a single configuring thread.
+     */
+    class SteeringController {
+    public:
+        SteeringController();
+
+        /**
+         * @brief New wheel steer angle target (rad)
+         */
+        void Command(float steerAngle);
+
+        /**
+         * @brief Measured wheel steer angle (rad) decoded from STATUS_4
+         */
+        void OnFeedback(float steerAngle, uint32_t stampUs);
+
+        void SetMode(SteeringMode mode);
+        SteeringMode GetMode() const { return m_Mode.load(); }
+        void SetGains(const SteeringGains& gains);
+        SteeringGains GetGains() const { return m_Gains.Read(); }
+
+    private:
+        std::atomic<SteeringMode> m_Mode;
+        std::atomic<float> m_Target{0.0f};
+        std::atomic<bool> m_HasTarget{false};
+        std::atomic<bool> m_ResetPending{true};
+        Seqlock<SteeringGains> m_Gains;
+
+        // CAN receive thread only
+        float m_Integral{0.0f};
+        float m_LastAngle{0.0f};
+        uint32_t m_LastStampUs{0};
+    };
+
+} // namespace tritonai::gkc
@@ -0,0 +1,129 @@
+/**
+ * @file steering_lut.hpp
+ * @brief Compile-time resampled steering calibration table
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace tritonai::gkc {
+
+    /**
+    * @brief Odd-symmetric mapping y = f(x) sampled uniformly on [0, xMax]
+    *
+    * Negative inputs mirror positive ones and inputs beyond xMax are clamped
+    * to the last sample. Lookup is one multiply, two min() and one lerp.
+    *
+    * @tparam N Number of samples, at least 2
+    */
+    template <size_t N>
+    struct SteeringLut {
+        static_assert(N >= 2, "SteeringLut needs at least two samples");
+
+        float xMax{0.0f};
+        float invStep{0.0f}; // (N - 1) / xMax
+        float y[N]{};
+
+        float Map(float x) const {
+            const float t = std::min(std::fabs(x) * invStep, static_cast<float>(N - 1));
+            const size_t i = std::min(static_cast<size_t>(t), N - 2);
+            const float frac = t - static_cast<float>(i);
+            return std::copysign(y[i] + frac * (y[i + 1] - y[i]), x);
+        }
+    };
+
+    namespace steering_lut_detail {
+
+        // Calibration points are {motor angle, wheel steer angle} pairs
+        template <size_t M>
+        constexpr bool IsStrictlyIncreasing(const float (&points)[M][2], size_t col) {
+            for (size_t k = 1; k < M; k++) {
+                if (!(points[k][col] > points[k - 1][col])) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /**
+        * @brief Monotone cubic (Fritsch-Butland) slopes at every calibration point
+        */
+        template <size_t M>
+        constexpr void ComputeSlopes(const float (&points)[M][2], size_t inCol, float (&slopes)[M]) {
+            const size_t outCol = 1 - inCol;
+            for (size_t k = 0; k < M; k++) {
+                const size_t lo = (k == 0) ? 0 : k - 1;
+                const size_t hi = (k == M - 1) ? M - 2 : k;
+                const float hPrev = points[lo + 1][inCol] - points[lo][inCol];
+                const float hNext = points[hi + 1][inCol] - points[hi][inCol];
+                const float dPrev = (points[lo + 1][outCol] - points[lo][outCol]) / hPrev;
+                const float dNext = (points[hi + 1][outCol] - points[hi][outCol]) / hNext;
+
+                if (k == 0 || k == M - 1) {
+                    // The curve is odd-symmetric, so the end slope is the secant
+                    slopes[k] = (k == 0) ? dNext : dPrev;
+                } else if (dPrev * dNext <= 0.0f) {
+                    slopes[k] = 0.0f;
+                } else {
+                    const float w1 = 2.0f * hNext + hPrev;
+                    const float w2 = hNext + 2.0f * hPrev;
+                    slopes[k] = (w1 + w2) / (w1 / dPrev + w2 / dNext);
+                }
+            }
+        }
+
+        template <size_t M>
+        constexpr float Interpolate(const float (&points)[M][2], size_t inCol,
+                                    const float (&slopes)[M], bool cubic, float x) {
+            const size_t outCol = 1 - inCol;
+            size_t k = 0;
+            while (k < M - 2 && x > points[k + 1][inCol]) {
+                k++;
+            }
+
+            const float h = points[k + 1][inCol] - points[k][inCol];
+            const float t = (x - points[k][inCol]) / h;
+            const float y0 = points[k][outCol];
+            const float y1 = points[k + 1][outCol];
+            if (!cubic) {
+                return y0 + t * (y1 - y0);
+            }
+
+            // Cubic Hermite basis
+            const float t2 = t * t;
+            const float t3 = t2 * t;
+            return (2.0f * t3 - 3.0f * t2 + 1.0f) * y0 +
+                   (t3 - 2.0f * t2 + t) * h * slopes[k] +
+                   (-2.0f * t3 + 3.0f * t2) * y1 +
+                   (t3 - t2) * h * slopes[k + 1];
+        }
+
+    } // namespace steering_lut_detail
+
+    /**
+    * @brief Resample a calibration curve into a SteeringLut at compile time
+    * @param points Calibration pairs, starting at {0, 0} and increasing in both columns
+    * @param inCol Column used as input: 1 maps wheel steer to motor angle, 0 the inverse
+    * @param cubic Monotone cubic interpolation between points instead of linear
+    */
+    template <size_t N, size_t M>
+    constexpr SteeringLut<N> MakeSteeringLut(const float (&points)[M][2], size_t inCol, bool cubic) {
+        float slopes[M]{};
+        steering_lut_detail::ComputeSlopes(points, inCol, slopes);
+
+        SteeringLut<N> lut{};
+        lut.xMax = points[M - 1][inCol];
+        lut.invStep = static_cast<float>(N - 1) / lut.xMax;
+        for (size_t i = 0; i < N; i++) {
+            const float x = lut.xMax * static_cast<float>(i) / static_cast<float>(N - 1);
+            lut.y[i] = steering_lut_detail::Interpolate(points, inCol, slopes, cubic, x);
+        }
+        return lut;
+    }
+
+} // namespace tritonai::gkc
@@ -6,108 +6,208 @@
  */
 
 #include "vesc_can_tools.hpp"
+#include "steering_lut.hpp"
+#include "Tools/global_profilers.hpp"
+#include "Tools/thread_monitor.hpp"
 #include <cstring>
 
 namespace tritonai::gkc {
 
     CAN can1(CAN1_RX, CAN1_TX, CAN1_BAUDRATE);
-    CAN can2(CAN2_RX, CAN2_TX, CAN2_BAUDRATE);
+    IrqCan can2(CAN2_RX, CAN2_TX, CAN2_BAUDRATE);
 
-    static float g_LastSteeringAngle = 0.0f;
-    static bool g_SteeringAngleReceived = false;
-    static Mutex g_SteeringAngleMutex;
+    struct ThrottleFeedback {
+        int32_t erpm;
+        float speedMs;
+    };
 
-    static int32_t g_ThrottleErpm = 0;
-    static float g_CalculatedSpeed = 0.0f; // Speed in m/s
-    static bool g_ErpmReceived = false;
-    static Mutex g_ErpmMutex;
+    // Written only by the CAN dispatcher thread, read lock-free from anywhere
+    static StampedStore<float> g_SteeringAngle;
+    static StampedStore<ThrottleFeedback> g_Throttle;
+
+    static Callback<void()> g_FeedbackCallback;
+    static Callback<void(float, uint32_t)> g_SteeringFeedbackCallback;
 
     void CanTransmitEid(uint32_t id, const uint8_t* data, uint8_t len) {
-        CANMessage* cMsg;
-        cMsg = new CANMessage(id, data, len, CANData, CANExtended);
+        // Replaces a not yet sent frame with the same ID, the latest setpoint wins
+        can2.Send(CANMessage(id, data, len, CANData, CANExtended));
+    }
+
+    void SetCanFeedbackCallback(Callback<void()> func) {
+        g_FeedbackCallback = func;
+    }
+
+    void SetSteeringFeedbackCallback(Callback<void(float, uint32_t)> func) {
+        g_SteeringFeedbackCallback = func;
+    }
+
+    // Controller ID -> index into g_Telemetry, NO_CONTROLLER_SLOT if not decoded
+    static constexpr uint8_t NO_CONTROLLER_SLOT = 0xFF;
+    static constexpr uint8_t VESC_IDS[] = VESC_CONTROLLER_IDS;
+    static constexpr size_t VESC_COUNT = sizeof(VESC_IDS) / sizeof(VESC_IDS[0]);
+    static constexpr size_t STATUS_COUNT = static_cast<size_t>(VescStatus::COUNT);
+
+    static VescTelemetry g_TelemetryWorking[VESC_COUNT]; // dispatcher thread only
+    static StampedStore<VescTelemetry> g_Telemetry[VESC_COUNT];
+
+    // Vehicle feedback derived from a decoded status frame
+    using FeedbackHook = void (*)(const VescTelemetry& telemetry, uint32_t stampUs);
 
-        if (!can2.write(*cMsg)) {
-            can2.reset();
-            can2.frequency(CAN2_BAUDRATE);
+    static void OnSteerPosition(const VescTelemetry& telemetry, uint32_t stampUs) {
+        // This calculation needs to be verified
+
+        // Were given PID Position, which seems to be 360 - encoder angle
+        float angleDeg = (360.0f - telemetry.pidPos);
+
+        // Normalize to [-180, +180]
+        while (angleDeg > 180.0f) angleDeg -= 360.0f;
+        while (angleDeg < -180.0f) angleDeg += 360.0f;
+
+        // Convert motor angle in degrees to radians
+        float angleRad = angleDeg * (M_PI / 180.0f);
+        float steerAngleRad = MapMotor2Steer(angleRad - ENCODER_OFFSET);
+        // float steerAngleRad = angleDeg; // for PID tuning, we use the raw angle directly
+
+        g_SteeringAngle.Publish(steerAngleRad, stampUs);
+
+        if (g_SteeringFeedbackCallback) {
+            g_SteeringFeedbackCallback(steerAngleRad, stampUs);
+        }
+        if (g_FeedbackCallback) {
+            g_FeedbackCallback();
         }
-        delete cMsg;
     }
 
-    bool CanReceiveEid(uint32_t id, uint8_t* outData, uint8_t& outLen) {
-        CANMessage cMsg;
+    static void OnThrottleErpm(const VescTelemetry& telemetry, uint32_t stampUs) {
+        // Calculate actual speed in m/s
+        float speedMs = (telemetry.erpm * WHEEL_CIRCUMFERENCE_M) / (NUM_MOTOR_POLES * GEAR_RATIO * 60.0);
 
-        if (can2.read(cMsg)) {
-            if (cMsg.id == id) {
-                outLen = cMsg.len;
-                memcpy(outData, cMsg.data, outLen);
-                return true;
-            }
+        g_Throttle.Publish(ThrottleFeedback{telemetry.erpm, speedMs}, stampUs);
+
+        if (g_FeedbackCallback) {
+            g_FeedbackCallback();
         }
-        return false;
     }
 
-    void ProcessCanMessage(const CANMessage& msg) {
-        // Process steering feedback (STATUS_4 packet)
-        if (msg.id == (STEER_CAN_ID | ((uint32_t)CAN_PACKET_ID::CAN_PACKET_STATUS_4 << 8)) && msg.len >= 8) {
-            // This calculation needs to be verified
+    struct CanDispatchTable {
+        uint8_t slot[256];                         // by controller ID
+        FeedbackHook hooks[VESC_COUNT][STATUS_COUNT]; // by (slot, status)
+    };
 
-            // Convert motor angle in degrees to radians
-            int16_t posRaw = (msg.data[6] << 8) | msg.data[7];
-            float positionDeg = (posRaw / 50.0f);
+    static constexpr uint8_t FindSlot(uint8_t controllerId) {
+        for (size_t i = 0; i < VESC_COUNT; i++) {
+            if (VESC_IDS[i] == controllerId) {
+                return static_cast<uint8_t>(i);
+            }
+        }
+        return NO_CONTROLLER_SLOT;
+    }
+
+    static constexpr CanDispatchTable MakeCanDispatchTable() {
+        CanDispatchTable table{};
+        for (size_t id = 0; id < 256; id++) {
+            table.slot[id] = FindSlot(static_cast<uint8_t>(id));
+        }
+        table.hooks[FindSlot(STEER_CAN_ID)][static_cast<size_t>(VescStatus::STATUS_4)] = OnSteerPosition;
+        table.hooks[FindSlot(THROTTLE_CAN_ID)][static_cast<size_t>(VescStatus::STATUS_1)] = OnThrottleErpm;
+        return table;
+    }
 
-            // Were given PID Position, which seems to be 360 - encoder angle
-            float angleDeg = (360.0f - positionDeg);
+    static_assert(VESC_COUNT < NO_CONTROLLER_SLOT, "Too many VESC controllers");
+    static_assert(FindSlot(STEER_CAN_ID) != NO_CONTROLLER_SLOT &&
+                  FindSlot(THROTTLE_CAN_ID) != NO_CONTROLLER_SLOT,
+                  "VESC_CONTROLLER_IDS must contain STEER_CAN_ID and THROTTLE_CAN_ID");
 
-            // Normalize to [-180, +180]
-            while (angleDeg > 180.0f) angleDeg -= 360.0f;
-            while (angleDeg < -180.0f) angleDeg += 360.0f;
+    static constexpr CanDispatchTable CAN_DISPATCH_TABLE = MakeCanDispatchTable();
 
-            float angleRad = angleDeg * (M_PI / 180.0f);
-            float steerAngleRad = (angleRad - ENCODER_OFFSET) / STEERING_RATIO;
-            // float steerAngleRad = angleDeg; // for PID tuning, we use the raw angle directly
+    void ProcessCanMessage(const CANMessage& msg, uint32_t stampUs) {
+        ScopedProfile probe(CanProfiler);
 
-            g_SteeringAngleMutex.lock();
-            g_LastSteeringAngle = steerAngleRad;
-            g_SteeringAngleReceived = true;
-            g_SteeringAngleMutex.unlock();
+        // VESC extended ID: packet ID << 8 | controller ID
+        const uint8_t slot = CAN_DISPATCH_TABLE.slot[msg.id & 0xFF];
+        const VescStatusDecoder* decoder = GetVescStatusDecoder(msg.id >> 8);
+        if (msg.format != CANExtended || slot == NO_CONTROLLER_SLOT ||
+            decoder == nullptr || msg.len < decoder->minLen) {
+            return;
         }
 
-        // Process throttle ERPM (STATUS packet)
-        else if (msg.id == (THROTTLE_CAN_ID | ((uint32_t)CAN_PACKET_ID::CAN_PACKET_STATUS << 8)) && msg.len >= 6) {
-            // Extract ERPM from the first 4 bytes
-            int32_t erpm = (msg.data[0] << 24) | (msg.data[1] << 16) | (msg.data[2] << 8) | msg.data[3];
+        const size_t status = static_cast<size_t>(decoder->status);
+        VescTelemetry& telemetry = g_TelemetryWorking[slot];
+        decoder->decode(msg.data, telemetry);
+        telemetry.receivedMask |= 1 << status;
+        telemetry.stampUs[status] = stampUs;
+        g_Telemetry[slot].Publish(telemetry, stampUs);
 
-            // Calculate actual speed in m/s
-            float speedMs = (erpm * WHEEL_CIRCUMFERENCE_M) / (NUM_MOTOR_POLES * GEAR_RATIO * 60.0);
+        const FeedbackHook hook = CAN_DISPATCH_TABLE.hooks[slot][status];
+        if (hook != nullptr) {
+            hook(telemetry, stampUs);
+        }
+    }
 
-            g_ErpmMutex.lock();
-            g_ThrottleErpm = erpm;
-            g_CalculatedSpeed = speedMs;
-            g_ErpmReceived = true;
-            g_ErpmMutex.unlock();
+    static void SetupCanFilters() {
+        // Only frames from the decoded VESCs with a packet ID in the status range
+        // reach the FIFO, everything else is dropped in hardware
+        const uint32_t mask = CAN_EXT_ID_MASK & ~((VESC_PACKET_ID_COUNT - 1) << 8);
+        int handle = 0;
+        for (uint8_t controllerId : VESC_IDS) {
+            can2.filter(controllerId, mask, CANExtended, handle++);
         }
     }
 
     void CanRecvLoop() {
-        CANMessage msg;
+        CanRxFrame frame;
         while (true) {
-            while (can2.read(msg)) {
-                ProcessCanMessage(msg);
+            // Sleeps until the RX interrupt has queued a frame
+            can2.WaitEvent();
+            if (can2.PopFrame(frame)) {
+                // The oldest queued frame is the one that woke the thread
+                g_ThreadMonitor.RecordWake(frame.stampUs);
+                do {
+                    ProcessCanMessage(frame.msg, frame.stampUs);
+                } while (can2.PopFrame(frame));
+            } else {
+                g_ThreadMonitor.RecordWake();
+            }
+
+            if (can2.TakeBusOff()) {
+                // Recover here rather than in the ISR, reset() takes a mutex.
+                // Queued TX frames are kept and go out once the bus is back.
+                can2.reset();
+                can2.frequency(CAN2_BAUDRATE);
+                SetupCanFilters();
+                can2.StartIrq();
             }
-            // small sleep to yield CPU (tweak as needed)
-            ThisThread::sleep_for(1ms);
         }
     }
 
+    uint32_t GetCanRxOverflowCount() {
+        return can2.GetRxOverflowCount();
+    }
+
+    uint32_t GetCanTxDroppedCount() {
+        return can2.GetTxDroppedCount();
+    }
+
+    uint32_t GetCanTxErrorCount() {
+        return can2.tderror();
+    }
+
+    uint32_t GetCanBusOffCount() {
+        return can2.GetBusOffCount();
+    }
+
     void InitializeCan() {
         can1.frequency(CAN1_BAUDRATE);
         can2.frequency(CAN2_BAUDRATE);
+        SetupCanFilters();
+        can2.StartIrq();
 
         static Thread canThread(osPriorityNormal,
                                 OS_STACK_SIZE,
                                 nullptr,
                                 "can_recv_thread");
         canThread.start(callback(CanRecvLoop));
+        g_ThreadMonitor.Register(canThread);
     }
 
     void BufferAppendInt16(uint8_t* buffer, int16_t number, int32_t* index) {
@@ -130,28 +230,42 @@ namespace tritonai::gkc {
         BufferAppendInt32(buffer, (int32_t)(number * scale), index);
     }
 
-    bool GetThrottleErpm(int32_t& erpm, float& speedMs) {
-        g_ErpmMutex.lock();
-        bool dataAvailable = g_ErpmReceived;
-        if (dataAvailable) {
-            erpm = g_ThrottleErpm;
-            speedMs = g_CalculatedSpeed;
-        }
-        g_ErpmMutex.unlock();
-        return dataAvailable;
+    int16_t BufferGetInt16(const uint8_t* buffer, int32_t* index) {
+        int16_t result = ((uint16_t)buffer[*index] << 8) | buffer[*index + 1];
+        *index += 2;
+        return result;
+    }
+
+    int32_t BufferGetInt32(const uint8_t* buffer, int32_t* index) {
+        int32_t result = ((uint32_t)buffer[*index] << 24) | ((uint32_t)buffer[*index + 1] << 16) |
+                         ((uint32_t)buffer[*index + 2] << 8) | buffer[*index + 3];
+        *index += 4;
+        return result;
     }
 
-    bool CommCanGetPos(uint8_t controllerId, float& pidPos) {
-        uint8_t data[8];
-        uint8_t len;
-        uint32_t expectedId = controllerId | ((uint32_t)CAN_PACKET_STATUS_4 << 8);
+    float BufferGetFloat16(const uint8_t* buffer, float scale, int32_t* index) {
+        return BufferGetInt16(buffer, index) / scale;
+    }
+
+    float BufferGetFloat32(const uint8_t* buffer, float scale, int32_t* index) {
+        return BufferGetInt32(buffer, index) / scale;
+    }
+
+    Stamped<VescTelemetry> CommCanGetTelemetry(uint8_t controllerId) {
+        const uint8_t slot = CAN_DISPATCH_TABLE.slot[controllerId];
+        if (slot == NO_CONTROLLER_SLOT) {
+            return Stamped<VescTelemetry>{};
+        }
+        return g_Telemetry[slot].Read();
+    }
 
-        if (CanReceiveEid(expectedId, data, len) && len >= 8) {
-            int16_t posRaw = (data[6] << 8) | data[7];
-            pidPos = posRaw / 50.0f;
-            return true;
+    bool GetThrottleErpm(int32_t& erpm, float& speedMs) {
+        const Stamped<ThrottleFeedback> throttle = g_Throttle.Read();
+        if (throttle.IsValid()) {
+            erpm = throttle.value.erpm;
+            speedMs = throttle.value.speedMs;
         }
-        return false;
+        return throttle.IsValid();
     }
 
     void CommCanSetDuty(uint8_t controllerId, float duty) {
@@ -212,11 +326,16 @@ namespace tritonai::gkc {
         CanTransmitEid(controllerId | ((uint32_t)CAN_PACKET_SET_CURRENT_REL << 8), buffer, sendIndex);
     }
 
-    void CommCanSetCurrentBrakeRel(uint8_t controllerId, float currentRel) {
+    CANMessage MakeCurrentBrakeRelFrame(uint8_t controllerId, float currentRel) {
         int32_t sendIndex = 0;
         uint8_t buffer[4];
         BufferAppendFloat32(buffer, currentRel, 1e5, &sendIndex);
-        CanTransmitEid(controllerId | ((uint32_t)CAN_PACKET_SET_CURRENT_BRAKE_REL << 8), buffer, sendIndex);
+        return CANMessage(controllerId | ((uint32_t)CAN_PACKET_SET_CURRENT_BRAKE_REL << 8), buffer, sendIndex,
+                          CANData, CANExtended);
+    }
+
+    void CommCanSetCurrentBrakeRel(uint8_t controllerId, float currentRel) {
+        can2.Send(MakeCurrentBrakeRelFrame(controllerId, currentRel));
     }
 
     void CommCanSetHandbrake(uint8_t controllerId, float current) {
@@ -238,54 +357,64 @@ namespace tritonai::gkc {
         CommCanSetRpm(THROTTLE_CAN_ID, speedToErpm);
     }
 
+    // STEERING_MAPPING resampled at compile time, both directions
+    static constexpr float STEERING_POINTS[][2] = STEERING_MAPPING;
+    static_assert(STEERING_POINTS[0][0] == 0.0f && STEERING_POINTS[0][1] == 0.0f,
+                  "STEERING_MAPPING must start at {0, 0}");
+    static_assert(steering_lut_detail::IsStrictlyIncreasing(STEERING_POINTS, 0) &&
+                  steering_lut_detail::IsStrictlyIncreasing(STEERING_POINTS, 1),
+                  "STEERING_MAPPING must be strictly increasing");
+
+#ifdef STEERING_LUT_CUBIC
+    static constexpr bool STEERING_LUT_IS_CUBIC = true;
+#else
+    static constexpr bool STEERING_LUT_IS_CUBIC = false;
+#endif
+
+    static constexpr SteeringLut<STEERING_LUT_SIZE> STEER_TO_MOTOR_LUT =
+        MakeSteeringLut<STEERING_LUT_SIZE>(STEERING_POINTS, 1, STEERING_LUT_IS_CUBIC);
+    static constexpr SteeringLut<STEERING_LUT_SIZE> MOTOR_TO_STEER_LUT =
+        MakeSteeringLut<STEERING_LUT_SIZE>(STEERING_POINTS, 0, STEERING_LUT_IS_CUBIC);
+
     float MapSteer2Motor(float steerAngle) {
-        std::map<float, float> mapping = STEERING_MAPPING;
-        int sign = steerAngle >= 0 ? 1 : -1;
-
-        for (auto it = mapping.begin(); it != mapping.end(); it++) {
-            if ((std::next(it))->second >= sign * steerAngle) {
-                auto returned = sign * MapRange<float, float>(
-                    sign * steerAngle, 
-                    it->second,
-                    std::next(it)->second, 
-                    it->first,
-                    std::next(it)->first
-                );
-                return returned;
-            }
-        }
-        return 0;
+        return STEER_TO_MOTOR_LUT.Map(steerAngle);
+    }
+
+    float MapMotor2Steer(float motorAngle) {
+        return MOTOR_TO_STEER_LUT.Map(motorAngle);
     }
 
     void CommCanSetAngle(float steerAngle) {
-        float motorAngle = steerAngle * STEERING_RATIO + ENCODER_OFFSET;
-        float radToDeg = 180.0 / M_PI * motorAngle;
+        CommCanSetMotorAngle(MapSteer2Motor(steerAngle));
+    }
+
+    void CommCanSetMotorAngle(float motorAngle) {
+        float radToDeg = 180.0 / M_PI * (motorAngle + ENCODER_OFFSET);
         CommCanSetPos(STEER_CAN_ID, radToDeg);
     }
 
-    float CommCanGetAngle() {
-        g_SteeringAngleMutex.lock();
-        float result = g_SteeringAngleReceived ? g_LastSteeringAngle : NAN;
-        g_SteeringAngleMutex.unlock();
-        return result;
+    Stamped<float> CommCanGetAngle() {
+        return g_SteeringAngle.Read();
     }
 
-    float CommCanGetSpeed() {
-        g_ErpmMutex.lock();
-        float result = g_ErpmReceived ? g_CalculatedSpeed : NAN;
-        g_ErpmMutex.unlock();
-        return result;
+    Stamped<float> CommCanGetSpeed() {
+        const Stamped<ThrottleFeedback> throttle = g_Throttle.Read();
+        return Stamped<float>{throttle.value.speedMs, throttle.stampUs, throttle.seq};
     }
 
-    void CommCanSetBrakePosition(float brakePosition) {
+    CANMessage MakeBrakePositionFrame(float brakePosition) {
         brakePosition = Clamp(brakePosition, 0.0f, 1.0f);
         unsigned int pos = (unsigned int)(brakePosition * (MAX_BRAKE_VAL - MIN_BRAKE_VAL)) + MIN_BRAKE_VAL;
 
-        static unsigned char buffer[8] = {0x0F, 0x4A, 0x00, 0xC0, 0, 0, 0, 0};
+        unsigned char buffer[8] = {0x0F, 0x4A, 0x00, 0xC0, 0, 0, 0, 0};
         buffer[2] = pos & 0xFF;
         buffer[3] = 0xC0 | ((pos >> 8) & 0x1F);
 
-        CanTransmitEid(BRAKE_CAN_ID, buffer, 8);
+        return CANMessage(BRAKE_CAN_ID, buffer, 8, CANData, CANExtended);
+    }
+
+    void CommCanSetBrakePosition(float brakePosition) {
+        can2.Send(MakeBrakePositionFrame(brakePosition));
     }
 
 } // namespace tritonai::gkc
\ No newline at end of file
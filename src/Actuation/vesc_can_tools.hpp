@@ -10,13 +10,15 @@
 #include "Thread.h"
 #include "mbed.h"
 #include "config.hpp"
-#include <map>
+#include "Actuation/irq_can.hpp"
+#include "Actuation/vesc_status.hpp"
+#include "Tools/stamped_value.hpp"
 
 namespace tritonai::gkc {
 
     // External declarations for CAN interfaces
     extern CAN can1;
-    extern CAN can2;
+    extern IrqCan can2;
 
     typedef enum {
         CAN_PACKET_SET_DUTY = 0,
@@ -29,24 +31,37 @@ namespace tritonai::gkc {
         CAN_PACKET_SET_CURRENT_BRAKE_REL,
         CAN_PACKET_SET_CURRENT_HANDBRAKE,
         CAN_PACKET_SET_CURRENT_HANDBRAKE_REL,
+        CAN_PACKET_STATUS_2 = 14, // Amp Hours, Amp Hours Charged
+        CAN_PACKET_STATUS_3 = 15, // Watt Hours, Watt Hours Charged
         CAN_PACKET_STATUS_4 = 16, // Temp Fet, Temp Motor, Current In, PID position
+        CAN_PACKET_STATUS_5 = 27, // Tachometer, Input Voltage
+        CAN_PACKET_STATUS_6 = 58, // ADC 1-3, PPM
         CAN_PACKET_MAKE_ENUM_32_BITS = 0xFFFFFFFF,
     } CAN_PACKET_ID;
 
+    constexpr uint32_t CAN_EXT_ID_MASK = 0x1FFFFFFF; // all 29 bits of an extended ID
+
     // Function declarations
     void InitializeCan();
     void CanTransmitEid(uint32_t id, const uint8_t* data, uint8_t len);
-    bool CanReceiveEid(uint32_t id, uint8_t* outData, uint8_t& outLen);
-    void ProcessCanMessage(const CANMessage& msg);
+    void ProcessCanMessage(const CANMessage& msg, uint32_t stampUs);
     void CanRecvLoop();
+    uint32_t GetCanRxOverflowCount();
+    uint32_t GetCanTxDroppedCount();
+    uint32_t GetCanTxErrorCount();   // transmit error counter of the controller
+    uint32_t GetCanBusOffCount();
 
     void BufferAppendInt16(uint8_t* buffer, int16_t number, int32_t* index);
     void BufferAppendInt32(uint8_t* buffer, int32_t number, int32_t* index);
     void BufferAppendFloat16(uint8_t* buffer, float number, float scale, int32_t* index);
     void BufferAppendFloat32(uint8_t* buffer, float number, float scale, int32_t* index);
+    int16_t BufferGetInt16(const uint8_t* buffer, int32_t* index);
+    int32_t BufferGetInt32(const uint8_t* buffer, int32_t* index);
+    float BufferGetFloat16(const uint8_t* buffer, float scale, int32_t* index);
+    float BufferGetFloat32(const uint8_t* buffer, float scale, int32_t* index);
 
     bool GetThrottleErpm(int32_t& erpm, float& speedMs);
-    bool CommCanGetPos(uint8_t controllerId, float& pidPos);
+    Stamped<VescTelemetry> CommCanGetTelemetry(uint8_t controllerId);
 
     // Message sending functions
     void CommCanSetDuty(uint8_t controllerId, float duty);
@@ -64,10 +79,21 @@ namespace tritonai::gkc {
     // Vehicle-specific functions
     void CommCanSetSpeed(float speedMs);
     void CommCanSetAngle(float steerAngle);
-    float CommCanGetAngle();
-    float CommCanGetSpeed();
+    void CommCanSetMotorAngle(float motorAngle); // rad from the calibration zero, ENCODER_OFFSET is added
+    Stamped<float> CommCanGetAngle();
+    Stamped<float> CommCanGetSpeed();
+
+    // Called from the CAN receive thread after steering or speed feedback is decoded
+    void SetCanFeedbackCallback(Callback<void()> func);
+
+    // Called from the CAN receive thread with every decoded wheel steer angle (rad)
+    void SetSteeringFeedbackCallback(Callback<void(float, uint32_t)> func);
     void CommCanSetBrakePosition(float brakePosition);
 
+    // Frames of the commands above, for senders that bypass CanTransmitEid
+    CANMessage MakeCurrentBrakeRelFrame(uint8_t controllerId, float currentRel);
+    CANMessage MakeBrakePositionFrame(float brakePosition);
+
     // Utility functions
     template <typename T>
     constexpr T Clamp(const T& val, const T& min, const T& max) {
@@ -89,5 +115,6 @@ namespace tritonai::gkc {
     }
 
     float MapSteer2Motor(float steerAngle);
+    float MapMotor2Steer(float motorAngle);
 
 } // namespace tritonai::gkc
\ No newline at end of file
@@ -0,0 +1,96 @@
+/**
+ * @file vesc_status.cpp
+ * @brief Decoding of the periodic VESC status frames - Implementation
+ *
+ * Scaling follows comm_can.c of the VESC firmware. All values are big-endian.
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#include "vesc_status.hpp"
+#include "vesc_can_tools.hpp"
+
+namespace tritonai::gkc {
+
+    static void DecodeStatus1(const uint8_t* data, VescTelemetry& out) {
+        int32_t index = 0;
+        out.erpm = BufferGetInt32(data, &index);
+        out.current = BufferGetFloat16(data, 1e1, &index);
+        out.duty = BufferGetFloat16(data, 1e3, &index);
+    }
+
+    static void DecodeStatus2(const uint8_t* data, VescTelemetry& out) {
+        int32_t index = 0;
+        out.ampHours = BufferGetFloat32(data, 1e4, &index);
+        out.ampHoursCharged = BufferGetFloat32(data, 1e4, &index);
+    }
+
+    static void DecodeStatus3(const uint8_t* data, VescTelemetry& out) {
+        int32_t index = 0;
+        out.wattHours = BufferGetFloat32(data, 1e4, &index);
+        out.wattHoursCharged = BufferGetFloat32(data, 1e4, &index);
+    }
+
+    static void DecodeStatus4(const uint8_t* data, VescTelemetry& out) {
+        int32_t index = 0;
+        out.tempFet = BufferGetFloat16(data, 1e1, &index);
+        out.tempMotor = BufferGetFloat16(data, 1e1, &index);
+        out.currentIn = BufferGetFloat16(data, 1e1, &index);
+        out.pidPos = BufferGetFloat16(data, 50.0, &index);
+    }
+
+    static void DecodeStatus5(const uint8_t* data, VescTelemetry& out) {
+        int32_t index = 0;
+        out.tachometer = BufferGetInt32(data, &index);
+        out.inputVoltage = BufferGetFloat16(data, 1e1, &index);
+    }
+
+    static void DecodeStatus6(const uint8_t* data, VescTelemetry& out) {
+        int32_t index = 0;
+        out.adc1 = BufferGetFloat16(data, 1e3, &index);
+        out.adc2 = BufferGetFloat16(data, 1e3, &index);
+        out.adc3 = BufferGetFloat16(data, 1e3, &index);
+        out.ppm = BufferGetFloat16(data, 1e3, &index);
+    }
+
+    // Indexed by VescStatus
+    static constexpr VescStatusDecoder DECODERS[] = {
+        {VescStatus::STATUS_1, 8, DecodeStatus1},
+        {VescStatus::STATUS_2, 8, DecodeStatus2},
+        {VescStatus::STATUS_3, 8, DecodeStatus3},
+        {VescStatus::STATUS_4, 8, DecodeStatus4},
+        {VescStatus::STATUS_5, 6, DecodeStatus5},
+        {VescStatus::STATUS_6, 8, DecodeStatus6},
+    };
+    static_assert(sizeof(DECODERS) / sizeof(DECODERS[0]) == static_cast<size_t>(VescStatus::COUNT),
+                  "Every VescStatus needs a decoder");
+
+    static constexpr uint32_t STATUS_PACKET_IDS[] = {
+        CAN_PACKET_STATUS, CAN_PACKET_STATUS_2, CAN_PACKET_STATUS_3,
+        CAN_PACKET_STATUS_4, CAN_PACKET_STATUS_5, CAN_PACKET_STATUS_6,
+    };
+
+    // Packet ID -> DECODERS index + 1, 0 for packets that are not status frames
+    struct PacketIdTable {
+        uint8_t entry[VESC_PACKET_ID_COUNT];
+    };
+
+    static constexpr PacketIdTable MakePacketIdTable() {
+        PacketIdTable table{};
+        for (size_t i = 0; i < sizeof(STATUS_PACKET_IDS) / sizeof(STATUS_PACKET_IDS[0]); i++) {
+            table.entry[STATUS_PACKET_IDS[i]] = static_cast<uint8_t>(i + 1);
+        }
+        return table;
+    }
+
+    static constexpr PacketIdTable PACKET_ID_TABLE = MakePacketIdTable();
+
+    const VescStatusDecoder* GetVescStatusDecoder(uint32_t packetId) {
+        if (packetId >= VESC_PACKET_ID_COUNT) {
+            return nullptr;
+        }
+        const uint8_t entry = PACKET_ID_TABLE.entry[packetId];
+        return entry ? &DECODERS[entry - 1] : nullptr;
+    }
+
+} // namespace tritonai::gkc
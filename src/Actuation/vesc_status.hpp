@@ -0,0 +1,86 @@
+/**
+ * @file vesc_status.hpp
+ * @brief Decoding of the periodic VESC status frames
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace tritonai::gkc {
+
+    // VESC status frames, in the order of VescTelemetry
+    enum class VescStatus : uint8_t {
+        STATUS_1 = 0, // ERPM, current, duty cycle
+        STATUS_2,     // amp hours drawn and charged
+        STATUS_3,     // watt hours drawn and charged
+        STATUS_4,     // FET and motor temperature, input current, PID position
+        STATUS_5,     // tachometer, input voltage
+        STATUS_6,     // ADC 1-3, PPM input
+        COUNT
+    };
+
+    /**
+     * @brief Latest status values reported by one VESC
+     */
+    struct VescTelemetry {
+        // STATUS_1
+        int32_t erpm{0};
+        float current{0.0f};          // A
+        float duty{0.0f};             // -1 to 1
+
+        // STATUS_2
+        float ampHours{0.0f};         // Ah
+        float ampHoursCharged{0.0f};  // Ah
+
+        // STATUS_3
+        float wattHours{0.0f};        // Wh
+        float wattHoursCharged{0.0f}; // Wh
+
+        // STATUS_4
+        float tempFet{0.0f};          // deg C
+        float tempMotor{0.0f};        // deg C
+        float currentIn{0.0f};        // A
+        float pidPos{0.0f};           // deg
+
+        // STATUS_5
+        int32_t tachometer{0};        // electrical steps
+        float inputVoltage{0.0f};     // V
+
+        // STATUS_6
+        float adc1{0.0f};             // V
+        float adc2{0.0f};             // V
+        float adc3{0.0f};             // V
+        float ppm{0.0f};              // -1 to 1
+
+        uint8_t receivedMask{0};      // bit per VescStatus received at least once
+        uint32_t stampUs[static_cast<size_t>(VescStatus::COUNT)]{}; // arrival of each status frame
+
+        bool Has(VescStatus status) const {
+            return receivedMask & (1 << static_cast<uint8_t>(status));
+        }
+    };
+
+    /**
+     * @brief Decoder of one status frame type
+     */
+    struct VescStatusDecoder {
+        VescStatus status;
+        uint8_t minLen;
+        void (*decode)(const uint8_t* data, VescTelemetry& out);
+    };
+
+    // Every status packet ID fits in six bits
+    constexpr size_t VESC_PACKET_ID_COUNT = 64;
+
+    /**
+     * @brief Decoder for a CAN packet ID, a single table lookup
+     * @param packetId Packet ID (bits 8 and up of the extended CAN ID)
+     * @return Decoder, nullptr if the packet is not a status frame
+     */
+    const VescStatusDecoder* GetVescStatusDecoder(uint32_t packetId);
+
+} // namespace tritonai::gkc
@@ -6,12 +6,17 @@
  */
 
 #include <chrono>
+#include <cstring>
 #include <memory>
 #include <ratio>
 #include <string>
 
 #include "Kernel.h"
 #include "comm.hpp"
+#include "Comm/gkc_frame.hpp"
+#include "Tools/binary_log.hpp"
+#include "Tools/global_profilers.hpp"
+#include "Tools/thread_monitor.hpp"
 #include "mbed.h"
 
 namespace tritonai::gkc {
@@ -22,27 +27,116 @@ namespace tritonai::gkc {
         m_Factory(std::make_unique<GkcPacketFactory>(sub, GkcPacketUtils::debug_cout)) 
     {
         Attach(callback(this, &CommManager::WatchdogCallback));
+        LearnTemplates();
         m_Logger->SendLog(LogPacket::Severity::INFO, "CommManager initialized");
 
-        m_UartSerial = std::make_unique<BufferedSerial>(UART_TX_PIN, UART_RX_PIN, BAUD_RATE);
+        m_UartSerial = std::make_unique<UartLink>(UART_TX_PIN, UART_RX_PIN, BAUD_RATE);
         m_UartSerialThread.start(mbed::callback(this, &CommManager::RecvCallback));
+        g_ThreadMonitor.Register(m_UartSerialThread);
 
         m_SendThread.start(callback(this, &CommManager::SendThreadImpl));
+        g_ThreadMonitor.Register(m_SendThread);
     }
 
     void CommManager::Send(const GkcPacket& packet) {
-        auto toSend = m_Factory->Send(packet);
-        if (m_SendQueue.try_put(toSend.get())) {
-            m_SendQueueData.push(toSend);
+        ScopedProfile probe(CommSendProfiler);
+        PacketBuffer* slot = m_SendPool.Acquire();
+        if (slot == nullptr) {
+            m_DroppedSendCount++;
+            return;
         }
+
+        // The packet library only encodes into a GkcBuffer, which is released
+        // right here; only the fixed pool slot outlives this call
+        auto encoded = m_Factory->Send(packet);
+        if (encoded->size() > sizeof(slot->data)) {
+            m_SendPool.Release(slot);
+            m_DroppedSendCount++;
+            return;
+        }
+        memcpy(slot->data, encoded->data(), encoded->size());
+        slot->size = encoded->size();
+        QueueSlot(slot);
     }
 
-    size_t CommManager::SendImpl(const GkcBuffer& buffer) {
-        if (!m_UartSerial->writable()) {
-            m_Logger->SendLog(LogPacket::Severity::ERROR, "Serial not writable");
-            return 0;
+    template <typename Packet>
+    void CommManager::SendTemplated(const PacketTemplate<Packet>& packetTemplate, const Packet& packet) {
+        if (!packetTemplate.IsValid()) {
+            Send(static_cast<const GkcPacket&>(packet));
+            return;
+        }
+
+        ScopedProfile probe(CommSendProfiler);
+        PacketBuffer* slot = m_SendPool.Acquire();
+        if (slot == nullptr) {
+            m_DroppedSendCount++;
+            return;
+        }
+        slot->size = packetTemplate.Encode(packet, slot->data, sizeof(slot->data));
+        QueueSlot(slot);
+    }
+
+    void CommManager::Send(const HeartbeatGkcPacket& packet) {
+        SendTemplated(m_HeartbeatTemplate, packet);
+    }
+
+    void CommManager::Send(const SensorGkcPacket& packet) {
+        SendTemplated(m_SensorTemplate, packet);
+    }
+
+    void CommManager::LearnTemplates() {
+        // Only the fields the firmware sets, the others keep their defaults
+        HeartbeatGkcPacket heartbeat;
+        const bool heartbeatLearned = m_HeartbeatTemplate.Learn(
+            *m_Factory, heartbeat, {MakeFieldRef(heartbeat.rolling_counter), MakeFieldRef(heartbeat.state)});
+
+        SensorGkcPacket sensor;
+        auto& values = sensor.values;
+        const bool sensorLearned = m_SensorTemplate.Learn(
+            *m_Factory, sensor,
+            {MakeFieldRef(values.wheel_speed_fl), MakeFieldRef(values.wheel_speed_fr),
+             MakeFieldRef(values.wheel_speed_rl), MakeFieldRef(values.wheel_speed_rr),
+             MakeFieldRef(values.brake_pressure), MakeFieldRef(values.steering_angle_rad)});
+
+        if (!heartbeatLearned || !sensorLearned) {
+            m_Logger->SendLog(LogPacket::Severity::WARNING,
+                              "Packet layout not learned, heartbeat and sensor packets allocate on send");
+        }
+    }
+
+    void CommManager::SendRaw(const uint8_t* payload, size_t len) {
+        PacketBuffer* slot = m_SendPool.Acquire();
+        if (slot == nullptr) {
+            m_DroppedSendCount++;
+            return;
+        }
+
+        slot->size = EncodeFrame(payload, len, slot->data, sizeof(slot->data));
+        if (slot->size == 0) {
+            m_SendPool.Release(slot);
+            m_DroppedSendCount++;
+            return;
+        }
+        QueueSlot(slot);
+    }
+
+    void CommManager::QueueSlot(PacketBuffer* slot) {
+        if (PacketBuffer* dropped = m_Scheduler.Enqueue(slot)) {
+            m_SendPool.Release(dropped);
+            m_DroppedSendCount++;
+        }
+    }
+
+    void CommManager::SetLocalPacketHandler(Callback<void(const uint8_t*, size_t)> handler) {
+        m_LocalHandler = handler;
+        m_HasLocalHandler.store(static_cast<bool>(handler), std::memory_order_release);
+    }
+
+    size_t CommManager::SendImpl(const PacketBuffer& buffer) {
+        size_t bytes = m_UartSerial->Write(buffer.data, buffer.size);
+        if (bytes != buffer.size) {
+            GKC_LOG(SERIAL_NOT_WRITABLE);
         }
-        size_t bytes = m_UartSerial->write(buffer.data(), buffer.size());
         return bytes;
     }
 
@@ -52,31 +146,169 @@ namespace tritonai::gkc {
     }
 
     void CommManager::RecvCallback() {
-        static auto buffer = GkcBuffer(RECV_BUFFER_SIZE, 0);
         static auto waitTime = std::chrono::milliseconds(WAIT_READ_MS);
 
         while (!ThisThread::flags_get()) {
             IncCount();
-            if (m_UartSerial->readable()) {
-                auto numByteRead = m_UartSerial->read(buffer.data(), buffer.size());
-                if (numByteRead > 0) {
-                    RawGkcBuffer buff;
-                    buff.data = buffer.data();
-                    buff.size = numByteRead;
-
-                    m_Factory->Receive(buff);
+
+            // Sleeps until the RX interrupt signals new bytes (or the timeout
+            // elapses so the watchdog still sees activity on an idle link)
+            if (!m_UartSerial->WaitReadable(waitTime)) {
+                continue;
+            }
+            g_ThreadMonitor.RecordWake();
+
+            m_LastRxMs = NowMs();
+
+            // Hand the ring's contiguous spans straight to the parser, no copy
+            uint8_t* span;
+            size_t numByteRead;
+            while ((numByteRead = m_UartSerial->PeekRx(span)) > 0) {
+                ScopedProfile probe(CommProfiler);
+                RawGkcBuffer buff;
+                buff.data = span;
+                buff.size = numByteRead;
+
+                m_Factory->Receive(buff);
+
+                if (m_HasLocalHandler.load(std::memory_order_acquire)) {
+                    for (size_t i = 0; i < numByteRead; i++) {
+                        if (m_LocalParser.Push(span[i]) &&
+                            IsLocalPacketId(m_LocalParser.GetPayload()[0])) {
+                            m_LocalHandler(m_LocalParser.GetPayload(), m_LocalParser.GetPayloadSize());
+                        }
+                    }
                 }
+                m_UartSerial->ConsumeRx(numByteRead);
             }
         }
     }
 
     void CommManager::SendThreadImpl() {
         while (!ThisThread::flags_get()) {
-            GkcBuffer* bufToSend;
-            m_SendQueue.try_get_for(Kernel::wait_for_u32_forever, &bufToSend);
-            SendImpl(*bufToSend);
-            m_SendQueueData.pop();
+            // Pay off the byte budget before picking, so the choice of the next
+            // packet is made as late as possible and a heartbeat never queues
+            // behind more than one frame
+            m_Scheduler.WaitForBudget();
+
+            PacketBuffer* bufToSend = m_Scheduler.Dequeue(std::chrono::milliseconds(WAIT_READ_MS));
+            if (bufToSend == nullptr) {
+                ServiceLink(0, false);
+                continue;
+            }
+            g_ThreadMonitor.RecordWake();
+#ifdef COMM_TX_AGGREGATION
+            bool sentHandshakeReply = false;
+            size_t bytes = SendBurstImpl(bufToSend, sentHandshakeReply);
+#else
+            bool sentHandshakeReply =
+                GetFramePacketId(bufToSend->data, bufToSend->size) == GKC_ID_HANDSHAKE2;
+            size_t bytes = SendImpl(*bufToSend);
+            m_SendPool.Release(bufToSend);
+            m_TxPacketCount++;
+            m_TxWriteCount++;
+#endif
+            m_Scheduler.Consume(bytes);
+            ServiceLink(bytes, sentHandshakeReply);
+        }
+    }
+
+    int CommManager::GetBaudRateForCode(uint8_t code) {
+        static const int baudRates[] = LINK_BAUD_RATES;
+        if (code == 0 || code > sizeof(baudRates) / sizeof(baudRates[0])) {
+            return 0;
+        }
+        return baudRates[code - 1];
+    }
+
+    void CommManager::RequestBaudRate(int baudRate) {
+        m_NegotiatedBaudRate = baudRate;
+    }
+
+    void CommManager::SwitchBaudRate(int baudRate) {
+        m_UartSerial->WaitTxIdle(std::chrono::milliseconds(UART_WRITE_TIMEOUT_MS));
+        m_UartSerial->SetBaud(baudRate);
+        m_Scheduler.SetBaudRate(baudRate);
+        m_BaudRate = baudRate;
+        m_BaudSwitchMs = NowMs();
+        m_WindowStartMs = m_BaudSwitchMs;
+        m_WindowBytes = 0;
+    }
+
+    void CommManager::ServiceLink(size_t bytesWritten, bool sentHandshakeReply) {
+        const uint32_t now = NowMs();
+
+        // The handshake reply went out at the old rate, the host switches on receipt
+        const int negotiated = m_NegotiatedBaudRate.load();
+        if (negotiated != 0 && sentHandshakeReply) {
+            m_NegotiatedBaudRate = 0;
+            m_LinkConfirmed = (negotiated == BAUD_RATE);
+            if (negotiated != m_BaudRate) {
+                SwitchBaudRate(negotiated);
+                m_Logger->SendLog(LogPacket::Severity::INFO,
+                                  "Serial link switched to " + std::to_string(negotiated) + " baud");
+            }
+        }
+
+        // Fall back if the host never confirmed the new rate or went silent on it
+        if (m_BaudRate != BAUD_RATE) {
+            const bool unconfirmed = !m_LinkConfirmed &&
+                                     now - m_BaudSwitchMs > LINK_BAUD_CONFIRM_TIMEOUT_MS;
+            const bool silent = now - m_BaudSwitchMs > LINK_IDLE_FALLBACK_MS &&
+                                now - m_LastRxMs > LINK_IDLE_FALLBACK_MS;
+            if (unconfirmed || silent) {
+                SwitchBaudRate(BAUD_RATE);
+                m_LinkConfirmed = true;
+                m_Logger->SendLog(LogPacket::Severity::WARNING,
+                                  "Serial link fell back to " + std::to_string(BAUD_RATE) + " baud");
+            }
+        }
+
+        // Link utilization: bits written over bits the line could carry
+        m_WindowBytes += bytesWritten;
+        const uint32_t windowMs = now - m_WindowStartMs;
+        if (windowMs >= LINK_UTILIZATION_WINDOW_MS) {
+            const uint64_t bitsSent = static_cast<uint64_t>(m_WindowBytes) * 10 * 1000 * 1000;
+            const uint64_t capacity = static_cast<uint64_t>(m_BaudRate) * windowMs;
+            m_LinkUtilizationPermille = static_cast<uint32_t>(bitsSent / capacity);
+            m_WindowStartMs = now;
+            m_WindowBytes = 0;
         }
     }
 
-} // namespace tritonai::gkc
\ No newline at end of file
+    size_t CommManager::SendBurstImpl(PacketBuffer* first, bool& sentHandshakeReply) {
+        static uint8_t burst[TX_BURST_MAX_BYTES];
+        static_assert(TX_BURST_MAX_BYTES >= SEND_FRAME_MAX_SIZE, "A burst must hold the largest frame");
+        static_assert(TX_BURST_MAX_BYTES <= SEND_BUFFER_SIZE, "A burst must fit the UART ring");
+
+        // Only what is already queued joins the burst: waiting for more costs
+        // the send thread an extra wake per burst, more than the writes it saves.
+        // Frames are concatenated unchanged, so the receiver sees the same
+        // byte stream as with one write per packet
+        size_t burstSize = 0;
+        uint32_t packets = 0;
+        PacketBuffer* buffer = first;
+        while (buffer != nullptr) {
+            sentHandshakeReply = GetFramePacketId(buffer->data, buffer->size) == GKC_ID_HANDSHAKE2;
+            memcpy(burst + burstSize, buffer->data, buffer->size);
+            burstSize += buffer->size;
+            packets++;
+            m_SendPool.Release(buffer);
+            if (sentHandshakeReply) {
+                // The host switches rates on this reply, so the burst ends here
+                // and ServiceLink switches before the next frame, as without bursts
+                break;
+            }
+            buffer = m_Scheduler.TryDequeue(sizeof(burst) - burstSize);
+        }
+
+        size_t bytes = m_UartSerial->Write(burst, burstSize);
+        if (bytes != burstSize) {
+            GKC_LOG(SERIAL_NOT_WRITABLE);
+        }
+        m_TxPacketCount += packets;
+        m_TxWriteCount++;
+        return bytes;
+    }
+
+} // namespace tritonai::gkc
@@ -9,13 +9,17 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <atomic>
 #include <memory>
-#include <queue>
 
-#include "BufferedSerial.h"
 #include "mbed.h"
 
 #include "config.hpp"
+#include "Comm/gkc_frame.hpp"
+#include "Comm/packet_pool.hpp"
+#include "Comm/packet_template.hpp"
+#include "Comm/tx_scheduler.hpp"
+#include "Comm/uart_link.hpp"
 #include "Watchdog/watchable.hpp"
 #include "Tools/logger.hpp"
 
@@ -30,21 +34,128 @@ namespace tritonai::gkc {
         explicit CommManager(GkcPacketSubscriber* sub, ILogger* logger);
         void Send(const GkcPacket& packet);
 
+        /**
+         * @brief Send the periodic packets without the library's allocations, see PacketTemplate
+         */
+        void Send(const HeartbeatGkcPacket& packet);
+        void Send(const SensorGkcPacket& packet);
+
+        /**
+         * @brief Frame and queue a firmware-local payload straight into a pool slot
+         * @param payload Payload bytes, the first byte is the packet ID (see gkc_frame.hpp)
+         * @param len Payload size in bytes
+         */
+        void SendRaw(const uint8_t* payload, size_t len);
+
+        /**
+         * @brief Receive inbound firmware-local packets (IDs GKC_ID_LOCAL_FIRST..LAST)
+         *
+         * The packet library does not know these IDs, so the receive thread also
+         * runs its own frame parser and passes valid local payloads (packet ID
+         * first) to the handler. Called on the receive thread, like packet_callback.
+         */
+        void SetLocalPacketHandler(Callback<void(const uint8_t*, size_t)> handler);
+
+        /**
+         * @brief Number of outbound packets dropped in total (pool exhausted, queue full,
+         *        superseded or oversize)
+         */
+        uint32_t GetDroppedSendCount() const { return m_DroppedSendCount.load(); }
+
+        /**
+         * @brief Number of sends that found the packet buffer pool empty
+         */
+        uint32_t GetPoolExhaustedCount() const { return m_SendPool.GetExhaustedCount(); }
+
+        /**
+         * @brief Number of packets of a transmit class rejected or superseded in its queue
+         */
+        uint32_t GetDroppedSendCount(TxClass txClass) const {
+            return m_Scheduler.GetDroppedCount(txClass);
+        }
+
+        /**
+         * @brief Number of packets written to the serial link
+         */
+        uint32_t GetTxPacketCount() const { return m_TxPacketCount.load(); }
+
+        /**
+         * @brief Number of serial writes (send thread wake-ups that produced output)
+         */
+        uint32_t GetTxWriteCount() const { return m_TxWriteCount.load(); }
+
+        /**
+         * @brief Line rate for a negotiation code from the handshake
+         * @param code 1-based index into LINK_BAUD_RATES
+         * @return Baud rate, or 0 if the code is 0 or unknown
+         */
+        static int GetBaudRateForCode(uint8_t code);
+
+        /**
+         * @brief Switch to a new line rate once the next handshake reply is written
+         *
+         * The host must handshake again at the new rate within
+         * LINK_BAUD_CONFIRM_TIMEOUT_MS, otherwise the link falls back to BAUD_RATE.
+         */
+        void RequestBaudRate(int baudRate);
+
+        /**
+         * @brief Mark the current line rate as working (host handshake received at it)
+         */
+        void ConfirmBaudRate() { m_LinkConfirmed = true; }
+
+        int GetBaudRate() const { return m_BaudRate.load(); }
+
+        /**
+         * @brief Fraction of the line capacity used over the last window (0.0 - 1.0)
+         */
+        float GetLinkUtilization() const { return m_LinkUtilizationPermille.load() / 1000.0f; }
+
     protected:
         ILogger* m_Logger;
 
         std::unique_ptr<GkcPacketFactory> m_Factory;
-        Queue<GkcBuffer, SEND_QUEUE_SIZE> m_SendQueue;
-        std::queue<std::shared_ptr<GkcBuffer>> m_SendQueueData;
+        PacketTemplate<HeartbeatGkcPacket> m_HeartbeatTemplate;
+        PacketTemplate<SensorGkcPacket> m_SensorTemplate;
+        static_assert(SEND_QUEUE_SIZE > TX_QUEUE_DEPTH_SAFETY + TX_QUEUE_DEPTH_CONTROL +
+                                        TX_QUEUE_DEPTH_SENSOR + TX_QUEUE_DEPTH_LOG,
+                      "Send pool must cover every TX queue plus the packet in flight");
+        PacketBufferPool<SEND_QUEUE_SIZE> m_SendPool;
+        TxScheduler m_Scheduler{BAUD_RATE};
+        std::atomic<uint32_t> m_DroppedSendCount{0};
+        std::atomic<uint32_t> m_TxPacketCount{0};
+        std::atomic<uint32_t> m_TxWriteCount{0};
+
+        // Link speed and utilization, switched only by the send thread
+        std::atomic<int> m_BaudRate{BAUD_RATE};
+        std::atomic<int> m_NegotiatedBaudRate{0};
+        std::atomic<bool> m_LinkConfirmed{true};
+        std::atomic<uint32_t> m_LastRxMs{0};
+        uint32_t m_BaudSwitchMs{0};
+        uint32_t m_WindowStartMs{0};
+        uint32_t m_WindowBytes{0};
+        std::atomic<uint32_t> m_LinkUtilizationPermille{0};
         Thread m_SendThread{osPriorityNormal, OS_STACK_SIZE, nullptr, "send_thread"};
 
-        std::unique_ptr<BufferedSerial> m_UartSerial;
+        // Firmware-local inbound packets, parsed by the receive thread only
+        GkcFrameParser m_LocalParser;
+        Callback<void(const uint8_t*, size_t)> m_LocalHandler;
+        std::atomic<bool> m_HasLocalHandler{false};
+
+        std::unique_ptr<UartLink> m_UartSerial;
         Thread m_UartSerialThread{osPriorityNormal, OS_STACK_SIZE, nullptr, "uart_serial_thread"};
 
         void RecvCallback();
         void WatchdogCallback();
         void SendThreadImpl();
-        size_t SendImpl(const GkcBuffer& buffer);
+        size_t SendImpl(const PacketBuffer& buffer);
+        void LearnTemplates();
+        template <typename Packet>
+        void SendTemplated(const PacketTemplate<Packet>& packetTemplate, const Packet& packet);
+        void QueueSlot(PacketBuffer* slot);
+        size_t SendBurstImpl(PacketBuffer* first, bool& sentHandshakeReply);
+        void ServiceLink(size_t bytesWritten, bool sentHandshakeReply);
+        void SwitchBaudRate(int baudRate);
     };
 
 } // namespace tritonai::gkc
\ No newline at end of file
@@ -0,0 +1,188 @@
+/**
+ * @file gkc_frame.hpp
+ * @brief Wire framing constants of the serial packet protocol
+ *
+ * Every packet on the link is framed as
+ * 0x02 | payload size | payload | CRC16 (little endian) | 0x03
+ * and the first payload byte is the packet ID (see serial_test.py).
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace tritonai::gkc {
+
+    constexpr uint8_t GKC_FRAME_START = 0x02;
+    constexpr uint8_t GKC_FRAME_END = 0x03;
+    constexpr size_t GKC_FRAME_HEADER_SIZE = 2;  // start byte + payload size
+    constexpr size_t GKC_FRAME_TRAILER_SIZE = 3; // CRC16 + end byte
+    constexpr size_t GKC_FRAME_OVERHEAD = GKC_FRAME_HEADER_SIZE + GKC_FRAME_TRAILER_SIZE;
+
+    // Packet IDs carried in the first payload byte
+    enum GkcPacketId : uint8_t {
+        GKC_ID_HANDSHAKE1 = 0x04,
+        GKC_ID_HANDSHAKE2 = 0x05,
+        GKC_ID_GET_FIRMWARE_VERSION = 0x06,
+        GKC_ID_FIRMWARE_VERSION = 0x07,
+        GKC_ID_CONFIG = 0xA0,
+        GKC_ID_STATE_TRANSITION = 0xA1,
+        GKC_ID_SHUTDOWN1 = 0xA2,
+        GKC_ID_SHUTDOWN2 = 0xA3,
+        GKC_ID_HEARTBEAT = 0xAA,
+        GKC_ID_CONTROL = 0xAB,
+        GKC_ID_SENSOR = 0xAC,
+        GKC_ID_LOG = 0xAD,
+        GKC_ID_RC_CONTROL = 0xAE,
+        GKC_ID_RESET_RTC = 0xFF,
+
+        // Firmware-local packets, outside the range used by tai_gokart_packet
+        GKC_ID_SENSOR_AGE = 0xB0,   // u32 LE ages (us) of steering, speed, brake pressure
+        GKC_ID_STEERING_CONFIG = 0xB1, // host -> MCU: u8 SteeringMode, f32 LE kp, ki, kd, kff, integral limit
+        GKC_ID_BINARY_LOG = 0xB2,   // u8 dropped, then records: u16 LE format ID, u32 LE stamp (us), u8 argc, argc u32 LE
+        GKC_ID_LOG_CONFIG = 0xB3,   // host -> MCU: u8 LogPacket::Severity, lowest severity sent to the host
+        GKC_ID_THREAD_STATS = 0xB4, // u16 LE window (ms), u8 count, then per thread: u8 index, u16 LE CPU (0.01%),
+                                    // stack headroom (bytes), wakeups, mean and max wakeup latency (us)
+        GKC_ID_THREAD_INFO = 0xB5,  // host -> MCU: request; MCU -> host: u8 count, then per thread: u8 index,
+                                    // u8 priority, u16 LE stack size, u16 LE max stack used, u8 name length, name
+        GKC_ID_PROFILER_REPORT = 0xB6, // host -> MCU: request, optional u16 LE report interval (ms, 0 = on request);
+                                    // MCU -> host: one profiler histogram, see Controller::ReportProfilers
+        GKC_ID_RESET_CAUSE = 0xB7,  // host -> MCU: request; MCU -> host, also before the first heartbeat:
+                                    // u8 ResetCause, u8 reset_reason_t, u8 name length, watchable name
+    };
+
+    // Inbound firmware-local packets are handed to CommManager's local handler
+    constexpr uint8_t GKC_ID_LOCAL_FIRST = 0xB0;
+    constexpr uint8_t GKC_ID_LOCAL_LAST = 0xBF;
+
+    inline bool IsLocalPacketId(uint8_t id) {
+        return id >= GKC_ID_LOCAL_FIRST && id <= GKC_ID_LOCAL_LAST;
+    }
+
+    constexpr size_t GKC_FRAME_MAX_PAYLOAD = 255;
+
+    /**
+     * @brief Packet ID of a complete frame, or 0 if the frame has no payload
+     */
+    inline uint8_t GetFramePacketId(const uint8_t* frame, size_t size) {
+        if (size <= GKC_FRAME_OVERHEAD || frame[1] == 0) {
+            return 0;
+        }
+        return frame[GKC_FRAME_HEADER_SIZE];
+    }
+
+    /**
+     * @brief CRC16-XMODEM (poly 0x1021, init 0) used by the frame checksum
+     */
+    inline uint16_t CalcFrameCrc16(const uint8_t* data, size_t len) {
+        uint16_t crc = 0;
+        for (size_t i = 0; i < len; i++) {
+            crc ^= static_cast<uint16_t>(data[i]) << 8;
+            for (int bit = 0; bit < 8; bit++) {
+                crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ 0x1021)
+                                     : static_cast<uint16_t>(crc << 1);
+            }
+        }
+        return crc;
+    }
+
+    /**
+     * @brief Frame a payload for the wire
+     * @param payload Payload, first byte is the packet ID
+     * @param len Payload size, at most GKC_FRAME_MAX_PAYLOAD
+     * @param out Destination buffer
+     * @param outSize Size of out in bytes
+     * @return Frame size in bytes, 0 if it does not fit
+     */
+    inline size_t EncodeFrame(const uint8_t* payload, size_t len, uint8_t* out, size_t outSize) {
+        if (len == 0 || len > GKC_FRAME_MAX_PAYLOAD || len + GKC_FRAME_OVERHEAD > outSize) {
+            return 0;
+        }
+        const uint16_t crc = CalcFrameCrc16(payload, len);
+        out[0] = GKC_FRAME_START;
+        out[1] = static_cast<uint8_t>(len);
+        memcpy(out + GKC_FRAME_HEADER_SIZE, payload, len);
+        out[GKC_FRAME_HEADER_SIZE + len] = crc & 0xFF;
+        out[GKC_FRAME_HEADER_SIZE + len + 1] = crc >> 8;
+        out[GKC_FRAME_HEADER_SIZE + len + 2] = GKC_FRAME_END;
+        return len + GKC_FRAME_OVERHEAD;
+    }
+
+    /**
+     * @brief Little endian float at a payload position
+     */
+    inline float GetPayloadFloat(const uint8_t* data) {
+        const uint32_t bits = static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8) |
+                              (static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24);
+        float value;
+        memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    /**
+     * @class GkcFrameParser
+     * @brief Byte-at-a-time frame decoder that validates size, CRC and end byte
+     *
+     * A byte that cannot continue the current frame drops it and the parser
+     * resyncs on the next start byte.
+     */
+    class GkcFrameParser {
+    public:
+        /**
+         * @brief Feed one received byte
+         * @return True if the byte completed a valid frame, see GetPayload
+         */
+        bool Push(uint8_t byte) {
+            switch (m_State) {
+            case State::START:
+                if (byte == GKC_FRAME_START) {
+                    m_State = State::SIZE;
+                }
+                return false;
+            case State::SIZE:
+                m_Size = byte;
+                m_Index = 0;
+                m_State = (byte == 0) ? State::START : State::PAYLOAD;
+                return false;
+            case State::PAYLOAD:
+                m_Payload[m_Index++] = byte;
+                if (m_Index == m_Size) {
+                    m_State = State::CRC_LOW;
+                }
+                return false;
+            case State::CRC_LOW:
+                m_Crc = byte;
+                m_State = State::CRC_HIGH;
+                return false;
+            case State::CRC_HIGH:
+                m_Crc |= static_cast<uint16_t>(byte) << 8;
+                m_State = State::END;
+                return false;
+            case State::END:
+                m_State = State::START;
+                return byte == GKC_FRAME_END && m_Crc == CalcFrameCrc16(m_Payload, m_Size);
+            }
+            return false;
+        }
+
+        /**
+         * @brief Payload of the last completed frame, the first byte is the packet ID
+         */
+        const uint8_t* GetPayload() const { return m_Payload; }
+        size_t GetPayloadSize() const { return m_Size; }
+
+    private:
+        enum class State : uint8_t { START, SIZE, PAYLOAD, CRC_LOW, CRC_HIGH, END };
+
+        State m_State{State::START};
+        uint8_t m_Payload[GKC_FRAME_MAX_PAYLOAD];
+        size_t m_Size{0};
+        size_t m_Index{0};
+        uint16_t m_Crc{0};
+    };
+
+} // namespace tritonai::gkc
@@ -0,0 +1,209 @@
+/**
+ * @file log_forwarder.cpp
+ * @brief Implementation of the log forwarder
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#include "Comm/log_forwarder.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "Kernel.h"
+
+namespace tritonai::gkc {
+
+    static uint32_t NowMs() {
+        return static_cast<uint32_t>(Kernel::Clock::now().time_since_epoch().count());
+    }
+
+    // FNV-1a, only compared against the previous message of the same site
+    static uint32_t HashText(const char* text) {
+        uint32_t hash = 2166136261u;
+        for (; *text != '\0'; text++) {
+            hash = (hash ^ static_cast<uint8_t>(*text)) * 16777619u;
+        }
+        return hash;
+    }
+
+    LogForwarder::LogForwarder(CommManager* comm) : m_Comm(comm) {}
+
+    void LogForwarder::Submit(LogPacket::Severity severity, const char* what, uintptr_t site) {
+        if (severity < GetSeverity()) {
+            return;
+        }
+        const uint32_t nowMs = NowMs();
+        const uint32_t hash = HashText(what);
+
+        m_Lock.lock();
+        Accept(severity, what, FindSite(site), hash, nowMs);
+        m_Lock.unlock();
+    }
+
+    void LogForwarder::Accept(LogPacket::Severity severity, const char* what, Site& entry, uint32_t hash,
+                              uint32_t nowMs) {
+        if (entry.textHash == hash && entry.severity == severity) {
+            if (entry.repeats++ == 0) {
+                entry.firstRepeatMs = nowMs;
+            }
+            return;
+        }
+        ReportRepeats(entry);
+
+        if (!TakeToken(entry, nowMs)) {
+            entry.suppressed++;
+            return;
+        }
+        entry.textHash = hash;
+        entry.severity = severity;
+        snprintf(entry.text, sizeof(entry.text), "%s", what);
+
+        if (entry.suppressed == 0) {
+            Append(severity, what);
+            return;
+        }
+        char text[LOG_FORWARD_BATCH_SIZE];
+        snprintf(text, sizeof(text), "%s [%u suppressed]", what, static_cast<unsigned int>(entry.suppressed));
+        entry.suppressed = 0;
+        Append(severity, text);
+    }
+
+    void LogForwarder::Flush() {
+        const uint32_t nowMs = NowMs();
+        Batch batches[LOG_FORWARD_BATCH_COUNT];
+        size_t count = 0;
+
+        RefillBudget();
+
+        m_Lock.lock();
+        for (Site& site : m_Sites) {
+            if (site.repeats > 0 && nowMs - site.firstRepeatMs >= LOG_FORWARD_REPEAT_REPORT_MS) {
+                ReportRepeats(site);
+            }
+        }
+
+        while (count < m_BatchCount && m_BudgetBytes > 0) {
+            batches[count] = m_Batches[count];
+            m_BudgetBytes -= static_cast<int32_t>(batches[count].size);
+            count++;
+        }
+        m_BatchCount -= count;
+        memmove(m_Batches, m_Batches + count, m_BatchCount * sizeof(Batch));
+
+        if (m_Dropped > 0 && m_BatchCount < LOG_FORWARD_BATCH_COUNT) {
+            char text[48];
+            snprintf(text, sizeof(text), "%u log messages dropped", static_cast<unsigned int>(m_Dropped));
+            m_Dropped = 0;
+            Append(LogPacket::Severity::WARNING, text);
+        }
+        m_Lock.unlock();
+
+        // Encoding allocates, so it stays outside the lock on this thread
+        for (size_t i = 0; i < count; i++) {
+            LogPacket packet;
+            packet.level = batches[i].severity;
+            packet.what = std::string(batches[i].text, batches[i].size);
+            m_Comm->Send(packet);
+        }
+    }
+
+    bool LogForwarder::TakeBudget(size_t bytes) {
+        // Like a batch, a packet may overdraw the budget once
+        RefillBudget();
+        if (m_BudgetBytes <= 0) {
+            return false;
+        }
+        m_BudgetBytes -= static_cast<int32_t>(bytes);
+        return true;
+    }
+
+    void LogForwarder::RefillBudget() {
+        // Budget in bytes, refilled for the time since the last refill and
+        // capped to one flush interval of backlog
+        constexpr int32_t BUDGET_CAP = LOG_FORWARD_MAX_BYTES_PER_S * BINARY_LOG_DRAIN_INTERVAL_MS / 1000 +
+                                       LOG_FORWARD_BATCH_SIZE;
+        const uint32_t nowMs = NowMs();
+        const int64_t refill = static_cast<int64_t>(nowMs - m_LastBudgetMs) * LOG_FORWARD_MAX_BYTES_PER_S / 1000;
+        if (refill == 0) {
+            return; // keeps the fraction of a byte for the next refill
+        }
+        m_BudgetBytes = static_cast<int32_t>(refill + m_BudgetBytes < BUDGET_CAP ? refill + m_BudgetBytes : BUDGET_CAP);
+        m_LastBudgetMs = nowMs;
+    }
+
+    LogForwarder::Site& LogForwarder::FindSite(uintptr_t address) {
+        for (size_t i = 0; i + 1 < LOG_FORWARD_SITE_COUNT; i++) {
+            Site& site = m_Sites[i];
+            if (site.address == address) {
+                return site;
+            }
+            if (site.address == 0) {
+                site.address = address;
+                site.milliTokens = LOG_RATE_LIMIT_BURST * 1000;
+                site.lastRefillMs = NowMs();
+                return site;
+            }
+        }
+        Site& shared = m_Sites[LOG_FORWARD_SITE_COUNT - 1];
+        if (shared.address == 0) {
+            shared.address = UINTPTR_MAX;
+            shared.milliTokens = LOG_RATE_LIMIT_BURST * 1000;
+            shared.lastRefillMs = NowMs();
+        }
+        return shared;
+    }
+
+    bool LogForwarder::TakeToken(Site& site, uint32_t nowMs) {
+        // One token per message, LOG_RATE_LIMIT_PER_S tokens per second = as many milli-tokens per ms
+        const uint32_t elapsedMs = nowMs - site.lastRefillMs;
+        const uint32_t refill = (elapsedMs < 1000 * LOG_RATE_LIMIT_BURST ? elapsedMs : 1000 * LOG_RATE_LIMIT_BURST) *
+                                LOG_RATE_LIMIT_PER_S;
+        site.lastRefillMs = nowMs;
+        site.milliTokens = site.milliTokens + refill < LOG_RATE_LIMIT_BURST * 1000
+                               ? site.milliTokens + refill
+                               : LOG_RATE_LIMIT_BURST * 1000;
+        if (site.milliTokens < 1000) {
+            return false;
+        }
+        site.milliTokens -= 1000;
+        return true;
+    }
+
+    void LogForwarder::ReportRepeats(Site& site) {
+        if (site.repeats == 0) {
+            return;
+        }
+        char text[LOG_FORWARD_SITE_TEXT_SIZE + 32];
+        snprintf(text, sizeof(text), "%s (repeated %u times)", site.text, static_cast<unsigned int>(site.repeats));
+        site.repeats = 0;
+        Append(site.severity, text);
+    }
+
+    void LogForwarder::Append(LogPacket::Severity severity, const char* text) {
+        size_t len = strlen(text);
+        if (len > LOG_FORWARD_BATCH_SIZE) {
+            len = LOG_FORWARD_BATCH_SIZE;
+        }
+
+        if (m_BatchCount > 0) {
+            Batch& last = m_Batches[m_BatchCount - 1];
+            if (last.severity == severity && last.size + 1 + len <= LOG_FORWARD_BATCH_SIZE) {
+                last.text[last.size++] = '\n';
+                memcpy(last.text + last.size, text, len);
+                last.size += len;
+                return;
+            }
+        }
+        if (m_BatchCount == LOG_FORWARD_BATCH_COUNT) {
+            m_Dropped++;
+            return;
+        }
+        Batch& batch = m_Batches[m_BatchCount++];
+        batch.severity = severity;
+        batch.size = len;
+        memcpy(batch.text, text, len);
+    }
+
+} // namespace tritonai::gkc
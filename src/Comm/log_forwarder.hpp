@@ -0,0 +1,109 @@
+/**
+ * @file log_forwarder.hpp
+ * @brief Rate limited forwarding of log messages to the host as LogPackets
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "mbed.h"
+
+#include "config.hpp"
+#include "Comm/comm.hpp"
+#include "tai_gokart_packet/gkc_packets.hpp"
+
+namespace tritonai::gkc {
+
+    /**
+     * @class LogForwarder
+     * @brief Batches log messages into LogPackets on the lowest transmit class
+     *
+     * A message passes four stages before it is queued for the link:
+     * - the runtime severity threshold;
+     * - de-duplication per call site: an identical message is only counted
+     *   and later reported once as "(repeated N times)";
+     * - a token bucket per call site, suppressed messages are counted on the
+     *   next message that passes;
+     * - batching: consecutive messages of one severity share a LogPacket,
+     *   separated by newlines.
+     *
+     * Flush sends the batches within a byte budget, so that logging uses at
+     * most LOG_FORWARD_MAX_BYTES_PER_S of the link and each packet blocks a
+     * higher priority one for at most one short frame. Other log packets sent
+     * by the same thread, i.e. the binary log, draw from that budget through
+     * TakeBudget after Flush.
+     *
+     * Threading: Submit from any thread but not from interrupt context, Flush
+     * from a single low-priority thread.
+     */
+    class LogForwarder {
+    public:
+        explicit LogForwarder(CommManager* comm);
+
+        /**
+         * @brief Accept one message for the link
+         * @param site Identifies the call site, e.g. its return address
+         */
+        void Submit(LogPacket::Severity severity, const char* what, uintptr_t site);
+
+        /**
+         * @brief Report expired repeats and send the batches the byte budget allows
+         */
+        void Flush();
+
+        /**
+         * @brief Charge a log packet sent outside the forwarder to the byte budget
+         * @return False when the budget is spent and the packet must not be sent
+         */
+        bool TakeBudget(size_t bytes);
+
+        void SetSeverity(LogPacket::Severity severity) { m_Severity.store(severity, std::memory_order_relaxed); }
+        LogPacket::Severity GetSeverity() const { return m_Severity.load(std::memory_order_relaxed); }
+
+    private:
+        struct Site {
+            uintptr_t address;             // 0 = free
+            uint32_t milliTokens;
+            uint32_t lastRefillMs;
+            uint32_t suppressed;
+            uint32_t textHash;             // last message that passed
+            LogPacket::Severity severity;
+            uint32_t repeats;
+            uint32_t firstRepeatMs;
+            char text[LOG_FORWARD_SITE_TEXT_SIZE]; // prefix of the last message, for the repeat report
+        };
+
+        struct Batch {
+            LogPacket::Severity severity;
+            size_t size;
+            char text[LOG_FORWARD_BATCH_SIZE];
+        };
+
+        void Accept(LogPacket::Severity severity, const char* what, Site& entry, uint32_t hash, uint32_t nowMs);
+        Site& FindSite(uintptr_t address);
+        bool TakeToken(Site& site, uint32_t nowMs);
+        void ReportRepeats(Site& site);
+        void Append(LogPacket::Severity severity, const char* text);
+        void RefillBudget();
+
+        CommManager* m_Comm;
+        Mutex m_Lock;
+        std::atomic<LogPacket::Severity> m_Severity{LOG_FORWARD_MIN_SEVERITY};
+
+        // Guarded by m_Lock; the last site is shared by call sites that find the table full
+        Site m_Sites[LOG_FORWARD_SITE_COUNT] = {};
+        Batch m_Batches[LOG_FORWARD_BATCH_COUNT];
+        size_t m_BatchCount{0};
+        uint32_t m_Dropped{0};
+
+        // Flush thread only, also TakeBudget
+        int32_t m_BudgetBytes{0};
+        uint32_t m_LastBudgetMs{0};
+    };
+
+} // namespace tritonai::gkc
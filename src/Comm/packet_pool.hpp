@@ -0,0 +1,101 @@
+/**
+ * @file packet_pool.hpp
+ * @brief Fixed-capacity pool of wire-format packet buffers
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "mbed.h"
+
+#include "config.hpp"
+
+namespace tritonai::gkc {
+
+    /**
+     * @brief One framed packet ready to be written to the serial link
+     */
+    struct PacketBuffer {
+        PacketBuffer* next{nullptr}; // intrusive free-list link, only valid while pooled
+        size_t size{0};
+        uint8_t data[SEND_FRAME_MAX_SIZE];
+    };
+
+    /**
+     * @class PacketBufferPool
+     * @brief Statically allocated packet buffers recycled through an intrusive free list
+     *
+     * Acquire and Release may be called from any thread. The free list is guarded
+     * by a short critical section, so no heap memory is touched after construction.
+     *
+     * @tparam N Number of buffers in the pool
+     */
+    template <size_t N>
+    class PacketBufferPool {
+    public:
+        PacketBufferPool() {
+            for (size_t i = 0; i < N; i++) {
+                m_Buffers[i].next = (i + 1 < N) ? &m_Buffers[i + 1] : nullptr;
+            }
+            m_FreeList = &m_Buffers[0];
+        }
+
+        /**
+         * @brief Take a buffer from the pool
+         * @return Free buffer, or nullptr if the pool is exhausted
+         */
+        PacketBuffer* Acquire() {
+            PacketBuffer* buffer;
+            {
+                CriticalSectionLock lock;
+                buffer = m_FreeList;
+                if (buffer != nullptr) {
+                    m_FreeList = buffer->next;
+                    m_FreeCount--;
+                }
+            }
+
+            if (buffer == nullptr) {
+                m_ExhaustedCount++;
+                return nullptr;
+            }
+            buffer->next = nullptr;
+            buffer->size = 0;
+            return buffer;
+        }
+
+        /**
+         * @brief Return a buffer obtained from Acquire
+         */
+        void Release(PacketBuffer* buffer) {
+            if (buffer == nullptr) {
+                return;
+            }
+            CriticalSectionLock lock;
+            buffer->next = m_FreeList;
+            m_FreeList = buffer;
+            m_FreeCount++;
+        }
+
+        size_t GetFreeCount() const { return m_FreeCount; }
+
+        /**
+         * @brief Number of Acquire calls that found the pool empty
+         */
+        uint32_t GetExhaustedCount() const { return m_ExhaustedCount.load(); }
+
+        static constexpr size_t Capacity() { return N; }
+
+    private:
+        PacketBuffer m_Buffers[N];
+        PacketBuffer* m_FreeList{nullptr};
+        volatile size_t m_FreeCount{N};
+        std::atomic<uint32_t> m_ExhaustedCount{0};
+    };
+
+} // namespace tritonai::gkc
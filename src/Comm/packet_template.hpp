@@ -0,0 +1,178 @@
+/**
+ * @file packet_template.hpp
+ * @brief Allocation-free encoding of fixed-size library packets
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+
+#include "config.hpp"
+#include "Comm/gkc_frame.hpp"
+
+#include "tai_gokart_packet/gkc_packet_factory.hpp"
+
+namespace tritonai::gkc {
+
+    /**
+     * @brief A field of a probe packet, by address and size
+     */
+    struct PacketFieldRef {
+        void* address;
+        size_t size;
+    };
+
+    template <typename T>
+    PacketFieldRef MakeFieldRef(T& field) {
+        return PacketFieldRef{&field, sizeof(T)};
+    }
+
+    /**
+     * @class PacketTemplate
+     * @brief Frame of one library packet type, patched with new field values instead of encoded
+     *
+     * tai_gokart_packet owns the wire layout and only encodes into a heap
+     * allocated GkcBuffer. Learn encodes a probe packet through the library
+     * once per field, with a marker in that field, and records where the
+     * field lands in the frame. Encode then copies the frame, writes the
+     * packet's fields at those offsets and recomputes the CRC.
+     *
+     * Learn fails if a field is not a plain copy of its bytes on the wire
+     * (e.g. the library scales it) or if a patched frame differs from the
+     * library's; the caller then keeps using the library. Fields that are
+     * not listed are sent as they were in the probe.
+     *
+     * Threading: Learn once before use, Encode from any thread.
+     *
+     * @tparam Packet Library packet type
+     */
+    template <typename Packet>
+    class PacketTemplate {
+    public:
+        static constexpr size_t MAX_FIELDS = 8;
+
+        /**
+         * @brief Locate the fields in the library's encoding, allocates
+         * @param probe Packet to learn from, its listed fields are overwritten
+         * @param fields Fields of probe that change between sends, at most 4 bytes each
+         * @return True if the template can encode
+         */
+        bool Learn(GkcPacketFactory& factory, Packet& probe, std::initializer_list<PacketFieldRef> fields) {
+            static constexpr uint8_t MARKER[] = {0xA1, 0xA2, 0xA3, 0xA4}; // non-zero, no two alike
+
+            m_Size = 0;
+            m_FieldCount = 0;
+            if (fields.size() > MAX_FIELDS) {
+                return false;
+            }
+            for (const PacketFieldRef& field : fields) {
+                if (field.size == 0 || field.size > sizeof(MARKER)) {
+                    return false;
+                }
+                memset(field.address, 0, field.size);
+            }
+
+            const auto reference = factory.Send(probe);
+            if (reference->size() <= GKC_FRAME_OVERHEAD || reference->size() > SEND_FRAME_MAX_SIZE) {
+                return false;
+            }
+
+            uint8_t* const base = reinterpret_cast<uint8_t*>(&probe);
+            for (const PacketFieldRef& field : fields) {
+                memcpy(field.address, MARKER, field.size);
+                const auto marked = factory.Send(probe);
+                memset(field.address, 0, field.size);
+
+                const size_t offset = FindMarker(*reference, *marked, MARKER, field.size);
+                if (offset == 0) {
+                    return false;
+                }
+                m_Fields[m_FieldCount++] = Field{static_cast<size_t>(static_cast<uint8_t*>(field.address) - base),
+                                                 offset, field.size};
+            }
+            memcpy(m_Frame, reference->data(), reference->size());
+            m_Size = reference->size();
+
+            // Every field at once, against the library
+            uint8_t value = 0x10;
+            for (const PacketFieldRef& field : fields) {
+                for (size_t i = 0; i < field.size; i++) {
+                    static_cast<uint8_t*>(field.address)[i] = value++;
+                }
+            }
+            const auto expected = factory.Send(probe);
+            uint8_t frame[SEND_FRAME_MAX_SIZE];
+            if (Encode(probe, frame, sizeof(frame)) != expected->size() ||
+                memcmp(frame, expected->data(), expected->size()) != 0) {
+                m_Size = 0;
+                return false;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Frame a packet, allocates nothing
+         * @return Frame size, 0 if the template is not valid or out is too small
+         */
+        size_t Encode(const Packet& packet, uint8_t* out, size_t outSize) const {
+            if (m_Size == 0 || m_Size > outSize) {
+                return 0;
+            }
+            memcpy(out, m_Frame, m_Size);
+            const uint8_t* source = reinterpret_cast<const uint8_t*>(&packet);
+            for (size_t i = 0; i < m_FieldCount; i++) {
+                memcpy(out + m_Fields[i].frameOffset, source + m_Fields[i].packetOffset, m_Fields[i].size);
+            }
+
+            const size_t len = out[1];
+            const uint16_t crc = CalcFrameCrc16(out + GKC_FRAME_HEADER_SIZE, len);
+            out[GKC_FRAME_HEADER_SIZE + len] = crc & 0xFF;
+            out[GKC_FRAME_HEADER_SIZE + len + 1] = crc >> 8;
+            return m_Size;
+        }
+
+        bool IsValid() const { return m_Size != 0; }
+
+    private:
+        struct Field {
+            size_t packetOffset;
+            size_t frameOffset;
+            size_t size;
+        };
+
+        /**
+         * @brief Frame offset of a marker that is the only payload change, 0 if there is no such marker
+         */
+        static size_t FindMarker(const GkcBuffer& reference, const GkcBuffer& marked, const uint8_t* marker,
+                                 size_t size) {
+            if (marked.size() != reference.size() || reference[1] + GKC_FRAME_OVERHEAD != reference.size()) {
+                return 0;
+            }
+            size_t first = 0;
+            size_t changed = 0;
+            for (size_t i = 0; i < GKC_FRAME_HEADER_SIZE + reference[1]; i++) {
+                if (marked[i] != reference[i]) {
+                    if (changed == 0) {
+                        first = i;
+                    }
+                    changed++;
+                }
+            }
+            if (changed != size || first < GKC_FRAME_HEADER_SIZE || memcmp(&marked[first], marker, size) != 0) {
+                return 0;
+            }
+            return first;
+        }
+
+        uint8_t m_Frame[SEND_FRAME_MAX_SIZE];
+        size_t m_Size{0};
+        Field m_Fields[MAX_FIELDS];
+        size_t m_FieldCount{0};
+    };
+
+} // namespace tritonai::gkc
@@ -0,0 +1,192 @@
+/**
+ * @file tx_scheduler.cpp
+ * @brief Implementation of the outbound packet scheduler
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#include "tx_scheduler.hpp"
+#include "Comm/gkc_frame.hpp"
+
+namespace tritonai::gkc {
+
+    TxClass ClassifyFrame(const PacketBuffer& buffer) {
+        switch (GetFramePacketId(buffer.data, buffer.size)) {
+        case GKC_ID_HEARTBEAT:
+        case GKC_ID_STATE_TRANSITION:
+        case GKC_ID_SHUTDOWN1:
+        case GKC_ID_SHUTDOWN2:
+        case GKC_ID_RESET_CAUSE:
+            return TxClass::SAFETY;
+        case GKC_ID_SENSOR:
+        case GKC_ID_SENSOR_AGE:
+            return TxClass::SENSOR;
+        case GKC_ID_LOG:
+        case GKC_ID_BINARY_LOG:
+        case GKC_ID_THREAD_STATS:
+        case GKC_ID_THREAD_INFO:
+        case GKC_ID_PROFILER_REPORT:
+            return TxClass::LOG;
+        default:
+            return TxClass::CONTROL;
+        }
+    }
+
+    bool IsLatestWinsFrame(const PacketBuffer& buffer) {
+        switch (GetFramePacketId(buffer.data, buffer.size)) {
+        case GKC_ID_HEARTBEAT:
+        case GKC_ID_SENSOR:
+        case GKC_ID_SENSOR_AGE:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    TxScheduler::TxScheduler(uint32_t baudRate) {
+        static_assert(TX_QUEUE_DEPTH_SAFETY > 0 && TX_QUEUE_DEPTH_CONTROL > 0 &&
+                      TX_QUEUE_DEPTH_SENSOR > 0 && TX_QUEUE_DEPTH_LOG > 0,
+                      "Every TX class needs at least one queue slot");
+        static_assert(TX_QUEUE_DEPTH_SAFETY <= MAX_CLASS_DEPTH &&
+                      TX_QUEUE_DEPTH_CONTROL <= MAX_CLASS_DEPTH &&
+                      TX_QUEUE_DEPTH_SENSOR <= MAX_CLASS_DEPTH &&
+                      TX_QUEUE_DEPTH_LOG <= MAX_CLASS_DEPTH,
+                      "TX queue depth exceeds MAX_CLASS_DEPTH");
+
+        const size_t depths[] = {TX_QUEUE_DEPTH_SAFETY, TX_QUEUE_DEPTH_CONTROL,
+                                 TX_QUEUE_DEPTH_SENSOR, TX_QUEUE_DEPTH_LOG};
+        for (size_t i = 0; i < static_cast<size_t>(TxClass::COUNT); i++) {
+            m_Queues[i] = ClassQueue{};
+            m_Queues[i].depth = depths[i];
+        }
+
+        SetBaudRate(baudRate);
+        m_BudgetTimer.start();
+    }
+
+    PacketBuffer* TxScheduler::Enqueue(PacketBuffer* buffer) {
+        ClassQueue& queue = m_Queues[static_cast<size_t>(ClassifyFrame(*buffer))];
+        const uint8_t packetId = GetFramePacketId(buffer->data, buffer->size);
+        PacketBuffer* dropped = nullptr;
+
+        m_Lock.lock();
+        if (IsLatestWinsFrame(*buffer)) {
+            // Takes the place of the queued packet with its ID, if any
+            for (size_t i = 0; i < queue.count; i++) {
+                PacketBuffer*& queued = queue.items[(queue.head + i) % queue.depth];
+                if (GetFramePacketId(queued->data, queued->size) == packetId) {
+                    dropped = queued;
+                    queued = buffer;
+                    queue.dropped++;
+                    m_Lock.unlock();
+                    return dropped;
+                }
+            }
+        }
+
+        if (queue.count == queue.depth) {
+            // Only a latest-wins packet makes room, a newer one follows anyway
+            queue.dropped++;
+            dropped = RemoveOldestLatestWins(queue);
+            if (dropped == nullptr) {
+                m_Lock.unlock();
+                return buffer;
+            }
+        }
+        queue.items[(queue.head + queue.count) % queue.depth] = buffer;
+        queue.count++;
+        m_Lock.unlock();
+
+        m_Flags.set(PENDING_FLAG);
+        return dropped;
+    }
+
+    PacketBuffer* TxScheduler::RemoveOldestLatestWins(ClassQueue& queue) {
+        for (size_t i = 0; i < queue.count; i++) {
+            PacketBuffer* queued = queue.items[(queue.head + i) % queue.depth];
+            if (!IsLatestWinsFrame(*queued)) {
+                continue;
+            }
+            // Close the gap, the packets behind it keep their order
+            for (size_t j = i; j + 1 < queue.count; j++) {
+                queue.items[(queue.head + j) % queue.depth] = queue.items[(queue.head + j + 1) % queue.depth];
+            }
+            queue.count--;
+            return queued;
+        }
+        return nullptr;
+    }
+
+    PacketBuffer* TxScheduler::PopHighest(size_t maxSize) {
+        m_Lock.lock();
+        for (auto& queue : m_Queues) {
+            if (queue.count > 0) {
+                PacketBuffer* buffer = queue.items[queue.head];
+                if (buffer->size > maxSize) {
+                    break;
+                }
+                queue.head = (queue.head + 1) % queue.depth;
+                queue.count--;
+                m_Lock.unlock();
+                return buffer;
+            }
+        }
+        m_Lock.unlock();
+        return nullptr;
+    }
+
+    PacketBuffer* TxScheduler::Dequeue(std::chrono::milliseconds timeout) {
+        while (true) {
+            PacketBuffer* buffer = PopHighest(SEND_FRAME_MAX_SIZE);
+            if (buffer != nullptr) {
+                return buffer;
+            }
+
+            if (m_Flags.wait_any_for(PENDING_FLAG, timeout) & osFlagsError) {
+                return nullptr;
+            }
+        }
+    }
+
+    PacketBuffer* TxScheduler::TryDequeue(size_t maxSize) {
+        return PopHighest(maxSize);
+    }
+
+    void TxScheduler::RefillBudget() {
+        const int64_t elapsedUs = m_BudgetTimer.elapsed_time().count();
+        m_BudgetTimer.reset();
+
+        const int64_t maxBudget = static_cast<int64_t>(TX_PACING_BURST_BYTES) * 1000000;
+        m_BudgetMicroBytes += elapsedUs * m_BytesPerSecond;
+        if (m_BudgetMicroBytes > maxBudget) {
+            m_BudgetMicroBytes = maxBudget;
+        }
+    }
+
+    void TxScheduler::WaitForBudget() {
+        RefillBudget();
+        if (m_BudgetMicroBytes >= 0) {
+            return;
+        }
+
+        // Round up so we never wake before the debt is paid
+        const int64_t waitUs = (-m_BudgetMicroBytes + m_BytesPerSecond - 1) / m_BytesPerSecond;
+        ThisThread::sleep_for(std::chrono::milliseconds((waitUs + 999) / 1000));
+        RefillBudget();
+    }
+
+    void TxScheduler::Consume(size_t bytes) {
+        RefillBudget();
+        m_BudgetMicroBytes -= static_cast<int64_t>(bytes) * 1000000;
+    }
+
+    void TxScheduler::SetBaudRate(uint32_t baudRate) {
+        // 8N1: ten bit times per byte on the wire
+        m_BytesPerSecond = baudRate / 10;
+    }
+
+    uint32_t TxScheduler::GetDroppedCount(TxClass txClass) const {
+        return m_Queues[static_cast<size_t>(txClass)].dropped;
+    }
+
+} // namespace tritonai::gkc
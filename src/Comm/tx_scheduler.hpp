@@ -0,0 +1,131 @@
+/**
+ * @file tx_scheduler.hpp
+ * @brief Priority-aware outbound packet scheduler for the serial link
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "mbed.h"
+
+#include "config.hpp"
+#include "Comm/packet_pool.hpp"
+
+namespace tritonai::gkc {
+
+    // Transmit classes, highest priority first
+    enum class TxClass : uint8_t {
+        SAFETY = 0,  // heartbeat, state transitions, shutdown
+        CONTROL = 1, // handshake, firmware version and other replies
+        SENSOR = 2,  // sensor readings and their ages, latest value wins
+        LOG = 3,     // log messages
+        COUNT
+    };
+
+    /**
+     * @brief Transmit class a framed packet belongs to, based on its packet ID
+     */
+    TxClass ClassifyFrame(const PacketBuffer& buffer);
+
+    /**
+     * @brief True for periodic packets that a newer one with the same ID supersedes
+     */
+    bool IsLatestWinsFrame(const PacketBuffer& buffer);
+
+    /**
+     * @class TxScheduler
+     * @brief Strict-priority, per-class queues with byte-budget pacing
+     *
+     * Every class has its own bounded queue so that a burst of low priority
+     * packets can never take the slots of a heartbeat. A latest-wins packet
+     * (heartbeat, sensor reading) replaces a queued one with the same ID in
+     * place. A full queue makes room by dropping its oldest latest-wins
+     * packet, otherwise it rejects the newest, so one-shot replies such as a
+     * state transition or the reset cause are never evicted.
+     *
+     * Pacing releases bytes at the UART line rate so the UART ring never holds
+     * more than roughly one frame; the priority decision is then made right
+     * before each frame goes out and a heartbeat waits at most one frame time.
+     *
+     * Threading: Enqueue from any thread, Dequeue/WaitForBudget/Consume from the
+     * single send thread.
+     */
+    class TxScheduler {
+    public:
+        explicit TxScheduler(uint32_t baudRate);
+
+        /**
+         * @brief Queue a framed packet in its transmit class
+         * @param buffer Packet to queue
+         * @return Buffer that was rejected or evicted and must be released by
+         *         the caller, nullptr if nothing was dropped
+         */
+        PacketBuffer* Enqueue(PacketBuffer* buffer);
+
+        /**
+         * @brief Take the highest priority queued packet, waiting if none
+         * @param timeout Max time to wait for a packet
+         * @return Packet to send, nullptr on timeout
+         */
+        PacketBuffer* Dequeue(std::chrono::milliseconds timeout);
+
+        /**
+         * @brief Take the highest priority queued packet without waiting
+         * @param maxSize Only take the packet if it is at most this many bytes; a
+         *                larger head packet is left queued rather than skipped
+         * @return Packet to send, nullptr if none fits
+         */
+        PacketBuffer* TryDequeue(size_t maxSize);
+
+        /**
+         * @brief Sleep until the byte budget is no longer in debt
+         */
+        void WaitForBudget();
+
+        /**
+         * @brief Charge bytes written to the link against the budget
+         */
+        void Consume(size_t bytes);
+
+        /**
+         * @brief Change the pacing rate, e.g. after a baud rate switch
+         */
+        void SetBaudRate(uint32_t baudRate);
+
+        /**
+         * @brief Number of packets of a class that were rejected or superseded
+         */
+        uint32_t GetDroppedCount(TxClass txClass) const;
+
+    private:
+        static constexpr uint32_t PENDING_FLAG = 1 << 0;
+        static constexpr size_t MAX_CLASS_DEPTH = 8;
+
+        struct ClassQueue {
+            PacketBuffer* items[MAX_CLASS_DEPTH];
+            size_t head;
+            size_t count;
+            size_t depth;
+            uint32_t dropped;
+        };
+
+        ClassQueue m_Queues[static_cast<size_t>(TxClass::COUNT)];
+        Mutex m_Lock;
+        EventFlags m_Flags;
+
+        // Byte budget in bytes * 1e6 to stay integral at microsecond resolution
+        Timer m_BudgetTimer;
+        int64_t m_BudgetMicroBytes{0};
+        uint32_t m_BytesPerSecond;
+
+        void RefillBudget();
+        PacketBuffer* PopHighest(size_t maxSize);
+        static PacketBuffer* RemoveOldestLatestWins(ClassQueue& queue);
+    };
+
+} // namespace tritonai::gkc
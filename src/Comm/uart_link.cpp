@@ -0,0 +1,86 @@
+/**
+ * @file uart_link.cpp
+ * @brief Implementation of the interrupt-driven UART
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#include "uart_link.hpp"
+
+namespace tritonai::gkc {
+
+    UartLink::UartLink(PinName tx, PinName rx, int baud)
+        : SerialBase(tx, rx, baud)
+    {
+        SerialBase::attach(callback(this, &UartLink::OnRxIrq), SerialBase::RxIrq);
+    }
+
+    bool UartLink::WaitReadable(std::chrono::milliseconds timeout) {
+        if (!m_RxRing.IsEmpty()) {
+            return true;
+        }
+        m_Flags.wait_any_for(RX_FLAG, timeout);
+        return !m_RxRing.IsEmpty();
+    }
+
+    size_t UartLink::Write(const uint8_t* data, size_t len) {
+        size_t written = 0;
+        while (written < len) {
+            written += m_TxRing.Write(data + written, len - written);
+            StartTx();
+
+            if (written < len) {
+                // Ring full, sleep until the TX interrupt frees some space
+                m_Flags.clear(TX_SPACE_FLAG);
+                if (m_TxRing.Space() == 0) {
+                    uint32_t result = m_Flags.wait_any_for(
+                        TX_SPACE_FLAG, std::chrono::milliseconds(UART_WRITE_TIMEOUT_MS));
+                    if (result & osFlagsError) {
+                        break;
+                    }
+                }
+            }
+        }
+        return written;
+    }
+
+    void UartLink::WaitTxIdle(std::chrono::milliseconds timeout) {
+        const auto deadline = Kernel::Clock::now() + timeout;
+        while (m_TxIrqEnabled && Kernel::Clock::now() < deadline) {
+            ThisThread::sleep_for(1ms);
+        }
+        // The TX interrupt stops once the last byte is loaded, let it shift out
+        ThisThread::sleep_for(1ms);
+    }
+
+    void UartLink::StartTx() {
+        CriticalSectionLock lock;
+        if (!m_TxIrqEnabled && !m_TxRing.IsEmpty()) {
+            m_TxIrqEnabled = true;
+            SerialBase::attach(callback(this, &UartLink::OnTxIrq), SerialBase::TxIrq);
+        }
+    }
+
+    void UartLink::OnRxIrq() {
+        while (SerialBase::readable()) {
+            if (!m_RxRing.Push(static_cast<uint8_t>(_base_getc()))) {
+                m_RxOverflowCount++;
+            }
+        }
+        m_Flags.set(RX_FLAG);
+    }
+
+    void UartLink::OnTxIrq() {
+        uint8_t byte;
+        while (SerialBase::writable() && m_TxRing.Pop(byte)) {
+            _base_putc(byte);
+        }
+
+        if (m_TxRing.IsEmpty()) {
+            SerialBase::attach(nullptr, SerialBase::TxIrq);
+            m_TxIrqEnabled = false;
+        }
+        m_Flags.set(TX_SPACE_FLAG);
+    }
+
+} // namespace tritonai::gkc
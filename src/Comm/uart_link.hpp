@@ -0,0 +1,94 @@
+/**
+ * @file uart_link.hpp
+ * @brief Interrupt-driven UART with lock-free receive and transmit rings
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+
+#include "mbed.h"
+
+#include "config.hpp"
+#include "Tools/spsc_ring.hpp"
+
+namespace tritonai::gkc {
+
+    /**
+     * @class UartLink
+     * @brief Serial port driven entirely by RX/TX interrupts
+     *
+     * The RX interrupt moves bytes from the peripheral into a lock-free ring and
+     * raises an event flag, so the receiving thread sleeps until data arrives
+     * instead of polling. The receiver then borrows contiguous spans of the ring
+     * and hands them to the parser without copying. Writes are queued into a
+     * second ring that the TX interrupt drains.
+     *
+     * Threading: one receiving thread and one writing thread.
+     */
+    class UartLink : private SerialBase {
+    public:
+        UartLink(PinName tx, PinName rx, int baud);
+
+        /**
+         * @brief Block until received bytes are available
+         * @param timeout Max time to sleep
+         * @return True if bytes are available to read
+         */
+        bool WaitReadable(std::chrono::milliseconds timeout);
+
+        /**
+         * @brief Borrow the next contiguous span of received bytes
+         * @param data Set to the first received byte
+         * @return Number of bytes available at data, 0 if none
+         */
+        size_t PeekRx(uint8_t*& data) { return m_RxRing.PeekContiguous(data); }
+
+        /**
+         * @brief Release bytes borrowed with PeekRx
+         */
+        void ConsumeRx(size_t count) { m_RxRing.Consume(count); }
+
+        /**
+         * @brief Queue bytes for transmission, waiting for ring space if needed
+         * @return Number of bytes queued, less than len on timeout
+         */
+        size_t Write(const uint8_t* data, size_t len);
+
+        /**
+         * @brief Block until every queued byte has left the UART
+         * @param timeout Max time to wait for the TX ring to drain
+         */
+        void WaitTxIdle(std::chrono::milliseconds timeout);
+
+        /**
+         * @brief Change the line rate, call only while TX is idle
+         */
+        void SetBaud(int baud) { SerialBase::baud(baud); }
+
+        /**
+         * @brief Number of received bytes dropped because the RX ring was full
+         */
+        uint32_t GetRxOverflowCount() const { return m_RxOverflowCount.load(); }
+
+    private:
+        static constexpr uint32_t RX_FLAG = 1 << 0;
+        static constexpr uint32_t TX_SPACE_FLAG = 1 << 1;
+
+        SpscRing<uint8_t, RECV_BUFFER_SIZE> m_RxRing;
+        SpscRing<uint8_t, SEND_BUFFER_SIZE> m_TxRing;
+        EventFlags m_Flags;
+        std::atomic<uint32_t> m_RxOverflowCount{0};
+        std::atomic<bool> m_TxIrqEnabled{false};
+
+        void OnRxIrq();
+        void OnTxIrq();
+        void StartTx();
+    };
+
+} // namespace tritonai::gkc
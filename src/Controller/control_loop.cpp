@@ -0,0 +1,128 @@
+/**
+ * @file control_loop.cpp
+ * @brief Implementation of the fixed-rate actuation task
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#include "control_loop.hpp"
+#include "Tools/global_profilers.hpp"
+#include "Tools/thread_monitor.hpp"
+#include "Tools/timestamp.hpp"
+
+namespace tritonai::gkc {
+
+    // Max setpoint age per source in ms, 0 = never expires
+    static constexpr uint32_t SOURCE_TIMEOUT_MS[] = {
+        0,                                    // SAFETY
+        CONTROL_RC_SETPOINT_TIMEOUT_MS,       // RC
+        CONTROL_AUTONOMY_SETPOINT_TIMEOUT_MS, // AUTONOMY
+    };
+    static_assert(sizeof(SOURCE_TIMEOUT_MS) / sizeof(SOURCE_TIMEOUT_MS[0]) ==
+                  static_cast<size_t>(SetpointSource::COUNT),
+                  "Every setpoint source needs a timeout");
+
+    ControlLoop::ControlLoop(Callback<void(const ActuationSetpoint&)> output)
+        : Watchable(DEFAULT_CONTROL_LOOP_POLL_INTERVAL_MS,
+                    DEFAULT_CONTROL_LOOP_POLL_LOST_TOLERANCE_MS,
+                    "ControlLoop"),
+        m_Output(output)
+    {
+    }
+
+    void ControlLoop::Start() {
+        m_LoopThread.start(callback(this, &ControlLoop::LoopThreadImpl));
+        g_ThreadMonitor.Register(m_LoopThread);
+        m_Ticker.attach(callback(this, &ControlLoop::OnTick),
+                        std::chrono::microseconds(CONTROL_LOOP_PERIOD_US));
+    }
+
+    void ControlLoop::Submit(SetpointSource source, const ActuationSetpoint& setpoint) {
+        SourceSlot& slot = m_Slots[static_cast<size_t>(source)];
+        CriticalSectionLock lock;
+        slot.setpoint = setpoint;
+        slot.stampUs = GetTimestampUs();
+        slot.valid = true;
+    }
+
+    void ControlLoop::Release(SetpointSource source) {
+        CriticalSectionLock lock;
+        m_Slots[static_cast<size_t>(source)].valid = false;
+    }
+
+    void ControlLoop::OnTick() {
+        m_TickStampUs = GetTimestampUs();
+        m_LoopThread.flags_set(TICK_FLAG);
+    }
+
+    void ControlLoop::LoopThreadImpl() {
+        uint32_t lastTickUs = 0;
+        bool firstTick = true;
+
+        while (true) {
+            ThisThread::flags_wait_any(TICK_FLAG);
+            g_ThreadMonitor.RecordWake(m_TickStampUs);
+
+            const uint32_t nowUs = GetTimestampUs();
+            if (!firstTick) {
+                RecordPeriod(nowUs - lastTickUs);
+            }
+            firstTick = false;
+            lastTickUs = nowUs;
+
+            Step();
+            this->IncCount(); // Increments the count of the watchdog
+        }
+    }
+
+    void ControlLoop::Step() {
+        ScopedProfile probe(ControlProfiler);
+        ActuationSetpoint output = m_LastOutput;
+        SetpointSource active = SetpointSource::COUNT;
+        {
+            CriticalSectionLock lock;
+            for (size_t i = 0; i < static_cast<size_t>(SetpointSource::COUNT); i++) {
+                const SourceSlot& slot = m_Slots[i];
+                if (slot.valid && (SOURCE_TIMEOUT_MS[i] == 0 ||
+                                   GetAgeUs(slot.stampUs) / 1000 < SOURCE_TIMEOUT_MS[i])) {
+                    output = slot.setpoint;
+                    active = static_cast<SetpointSource>(i);
+                    break;
+                }
+            }
+        }
+
+        if (active == SetpointSource::COUNT) {
+            // Never keep re-sending a speed nobody asks for anymore
+            output.throttle = 0.0f;
+        }
+
+        m_LastOutput = output;
+        m_ActiveSource = active;
+        m_Output(output);
+    }
+
+    void ControlLoop::RecordPeriod(uint32_t periodUs) {
+        const uint32_t jitterUs = periodUs > CONTROL_LOOP_PERIOD_US
+            ? periodUs - CONTROL_LOOP_PERIOD_US
+            : CONTROL_LOOP_PERIOD_US - periodUs;
+
+        size_t bucket = 0;
+        while (bucket < ControlJitterStats::BUCKET_COUNT - 1 &&
+               jitterUs > ControlJitterStats::BUCKET_EDGES_US[bucket]) {
+            bucket++;
+        }
+
+        m_Stats.buckets[bucket]++;
+        m_Stats.ticks++;
+        const uint32_t elapsedTicks = (periodUs + CONTROL_LOOP_PERIOD_US / 2) / CONTROL_LOOP_PERIOD_US;
+        if (elapsedTicks > 1) {
+            m_Stats.missedTicks += elapsedTicks - 1;
+        }
+        if (jitterUs > m_Stats.maxJitterUs) {
+            m_Stats.maxJitterUs = jitterUs;
+        }
+        m_PublishedStats.Write(m_Stats);
+    }
+
+} // namespace tritonai::gkc
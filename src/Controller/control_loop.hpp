@@ -0,0 +1,117 @@
+/**
+ * @file control_loop.hpp
+ * @brief Fixed-rate actuation task arbitrating autonomy and RC setpoints
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "mbed.h"
+
+#include "config.hpp"
+#include "Tools/seqlock.hpp"
+#include "Watchdog/watchable.hpp"
+
+namespace tritonai::gkc {
+
+    // Setpoint sources, highest priority first
+    enum class SetpointSource : uint8_t {
+        SAFETY = 0, // stop requests, held until released
+        RC = 1,     // RC override or manual driving
+        AUTONOMY = 2,
+        COUNT       // no source, the loop holds steering and brake and cuts throttle
+    };
+
+    struct ActuationSetpoint {
+        float throttle{0.0f}; // m/s
+        float steering{0.0f}; // rad
+        float brake{0.0f};    // 0 to 1
+    };
+
+    /**
+     * @brief Histogram of the deviation of each tick period from CONTROL_LOOP_PERIOD_US
+     */
+    struct ControlJitterStats {
+        static constexpr uint32_t BUCKET_EDGES_US[] = CONTROL_JITTER_BUCKETS_US;
+        static constexpr size_t BUCKET_COUNT = sizeof(BUCKET_EDGES_US) / sizeof(BUCKET_EDGES_US[0]) + 1;
+
+        uint32_t buckets[BUCKET_COUNT]{}; // bucket i counts jitter <= BUCKET_EDGES_US[i]
+        uint32_t maxJitterUs{0};
+        uint32_t ticks{0};
+        uint32_t missedTicks{0};          // periods that spanned more than one tick
+    };
+
+    /**
+     * @class ControlLoop
+     * @brief High priority task emitting actuation commands on a hardware timer tick
+     *
+     * Packet callbacks only Submit setpoints. Every CONTROL_LOOP_PERIOD_US a
+     * Ticker wakes the task, which picks the highest priority source with a
+     * fresh setpoint and passes it to the output callback, so CAN commands go
+     * out at a fixed period no matter when UART or ELRS data arrives. Without a
+     * fresh source throttle is cut while steering and brake are held.
+     *
+     * Threading: Submit/Release from any thread; the output callback runs on the
+     * loop thread.
+     */
+    class ControlLoop : public Watchable {
+    public:
+        explicit ControlLoop(Callback<void(const ActuationSetpoint&)> output);
+
+        /**
+         * @brief Start ticking, call once the output target is ready
+         */
+        void Start();
+
+        /**
+         * @brief Store the latest setpoint of a source, applied on the next tick
+         */
+        void Submit(SetpointSource source, const ActuationSetpoint& setpoint);
+
+        /**
+         * @brief Stop using a source until it submits again
+         */
+        void Release(SetpointSource source);
+
+        /**
+         * @brief Source applied on the last tick, COUNT if none was fresh
+         */
+        SetpointSource GetActiveSource() const { return m_ActiveSource; }
+
+        /**
+         * @brief Tick period jitter since start
+         */
+        ControlJitterStats GetJitterStats() const { return m_PublishedStats.Read(); }
+
+    private:
+        static constexpr uint32_t TICK_FLAG = 1 << 0;
+
+        struct SourceSlot {
+            ActuationSetpoint setpoint;
+            uint32_t stampUs{0};
+            bool valid{false};
+        };
+
+        Callback<void(const ActuationSetpoint&)> m_Output;
+        SourceSlot m_Slots[static_cast<size_t>(SetpointSource::COUNT)];
+        ActuationSetpoint m_LastOutput;
+        volatile SetpointSource m_ActiveSource{SetpointSource::COUNT};
+
+        ControlJitterStats m_Stats;
+        Seqlock<ControlJitterStats> m_PublishedStats;
+
+        Ticker m_Ticker;
+        volatile uint32_t m_TickStampUs{0}; // written by OnTick, for the wakeup latency
+        Thread m_LoopThread{osPriorityHigh, OS_STACK_SIZE, nullptr, "control_loop_thread"};
+
+        void LoopThreadImpl();
+        void OnTick();
+        void Step();
+        void RecordPeriod(uint32_t periodUs);
+    };
+
+} // namespace tritonai::gkc
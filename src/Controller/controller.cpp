@@ -6,11 +6,16 @@
  */
 
 #include "Controller/controller.hpp"
+#include "Kernel.h"
+#include "Comm/gkc_frame.hpp"
+#include "Tools/binary_log.hpp"
+#include "Tools/timestamp.hpp"
 #include "config.h"
 #include "tai_gokart_packet/gkc_packets.hpp"
 #include "tai_gokart_packet/gkc_packet_utils.hpp"
 #include "tai_gokart_packet/version.hpp"
 #include <chrono>
+#include <cstring>
 #include <iostream>
 
 namespace tritonai::gkc {
@@ -84,6 +89,9 @@ namespace tritonai::gkc {
         std::string state;
         std::string oldState;
 
+        // The host learns why the last boot ended before it sees this one
+        SendResetReport();
+
         //TODO: (Moises) TEMP
         GkcStateMachine::Initialize();
 
@@ -98,6 +106,9 @@ namespace tritonai::gkc {
             this->IncCount();
 
             UpdateLights();
+            ReportFastStop();
+            ReportControlJitter();
+            ReportThreadStats();
 
             // Log state changes
             switch(GetState()) {
@@ -131,17 +142,25 @@ namespace tritonai::gkc {
             auto loopDuration = std::chrono::duration_cast<std::chrono::milliseconds>(loopEnd - loopStart);
             auto sleepTime = std::chrono::milliseconds(100) - loopDuration;
             if (sleepTime.count() > 0) {
-                ThisThread::sleep_for(sleepTime);
+                g_ThreadMonitor.SleepFor(sleepTime);
             } else {
                 if (loopDuration.count() > 110) {
                     SendLog(LogPacket::Severity::WARNING, 
                             "Heartbeat loop took " + std::to_string(loopDuration.count()) + "ms (>100ms target)");
                 }
-                ThisThread::sleep_for(std::chrono::milliseconds(1));
+                g_ThreadMonitor.SleepFor(std::chrono::milliseconds(1));
             }
         }
     }
 
+    void Controller::OnRcHeartbeatDeadline() {
+        // Interrupt context, the same deadline as m_RcHeartbeat without the
+        // watch thread. OnRcDisconnect follows with the logs and the state machine.
+        if(GetState() == GkcLifecycle::Active) {
+            m_FastStop.Trigger();
+        }
+    }
+
     void Controller::OnRcDisconnect() {
         SendLog(LogPacket::Severity::INFO, "Controller heartbeat lost");
         m_RcConnected = false;
@@ -151,8 +170,10 @@ namespace tritonai::gkc {
             return;
         }
 
+        // Usually done by the deadline timer already
+        m_FastStop.Trigger();
         SendLog(LogPacket::Severity::FATAL, "RC controller heartbeat lost");
-        SetActuationValues(0.0, 0.0, EMERGENCY_BRAKE_PRESSURE); // Set the actuation values to stop the car
+        SetActuationValues(SetpointSource::SAFETY, 0.0, 0.0, EMERGENCY_BRAKE_PRESSURE); // Set the actuation values to stop the car
         EmergencyStop();
     }
 
@@ -161,24 +182,34 @@ namespace tritonai::gkc {
         Watchable(DEFAULT_CONTROLLER_POLL_INTERVAL_MS, DEFAULT_CONTROLLER_POLL_LOST_TOLERANCE_MS, "Controller"),
         GkcStateMachine(),
         m_Severity(LogPacket::Severity::FATAL),
+        m_ResetReport(ReadResetReport()),
+        m_LogForwarder(&m_Comm),
         m_Comm(this, this),
-        m_Watchdog(DEFAULT_WD_INTERVAL_MS, DEFAULT_WD_MAX_INACTIVITY_MS, DEFAULT_WD_WAKEUP_INTERVAL_MS, this),
+        m_Watchdog(DEFAULT_WD_INTERVAL_MS, DEFAULT_WD_MAX_INACTIVITY_MS, this),
         m_SensorReader(this),
         m_Actuation(this),
         m_RcController(this, this),
         m_BrakePressureSensor(this),
         m_CanSensorProvider(this),
+        m_ControlLoop(callback(this, &Controller::ApplySetpoint)),
         m_RcHeartbeat(DEFAULT_RC_HEARTBEAT_INTERVAL_MS, DEFAULT_RC_HEARTBEAT_LOST_TOLERANCE_MS, "RCControllerHeartBeat")
     {
         Attach(callback(this, &Controller::WatchdogCallback));
+        m_Comm.SetLocalPacketHandler(callback(this, &Controller::OnLocalPacket));
         m_KeepAliveThread.start(callback(this, &Controller::AgxHeartbeat));
         m_SensorSendThread.start(callback(this, &Controller::SensorSendThreadImpl));
+        m_LogThread.start(callback(this, &Controller::LogThreadImpl));
+        g_ThreadMonitor.Register(m_KeepAliveThread);
+        g_ThreadMonitor.Register(m_SensorSendThread);
+        g_ThreadMonitor.Register(m_LogThread);
+        g_ThreadMonitor.Start();
 
         // Add all objects to the watchlist
         m_Watchdog.AddToWatchlist(this);
         m_Watchdog.AddToWatchlist(&m_Comm);
         m_Watchdog.AddToWatchlist(&m_SensorReader);
         m_Watchdog.AddToWatchlist(&m_RcController);
+        m_Watchdog.AddToWatchlist(&m_ControlLoop);
 
         if(m_StopOnRcDisconnect) {
             m_RcHeartbeat.Attach(callback(this, &Controller::OnRcDisconnect));
@@ -187,6 +218,7 @@ namespace tritonai::gkc {
 
         m_SensorReader.RegisterProvider(&m_BrakePressureSensor);
         m_SensorReader.RegisterProvider(&m_CanSensorProvider);
+        m_ControlLoop.Start();
 
         SendLog(LogPacket::Severity::INFO, "Controller initialized");
     }
@@ -197,8 +229,12 @@ namespace tritonai::gkc {
     }
 
     // ILogger API IMPLEMENTATION
-    // TODO: SendLog partially implemented, complete the implementation
     void Controller::SendLog(const LogPacket::Severity& severity, const std::string& what) {
+        PrintLog(severity, what.c_str());
+        m_LogForwarder.Submit(severity, what.c_str(), reinterpret_cast<uintptr_t>(__builtin_return_address(0)));
+    }
+
+    void Controller::PrintLog(const LogPacket::Severity& severity, const char* what) {
         if(severity == LogPacket::Severity::FATAL && m_Severity <= severity)
             std::cerr << "Fatal: " << what << std::endl;
         else if(severity == LogPacket::Severity::ERROR && m_Severity <= severity)
@@ -214,8 +250,24 @@ namespace tritonai::gkc {
     // PACKET CALLBACKS API IMPLEMENTATION
     void Controller::packet_callback(const Handshake1GkcPacket& packet) {
         SendLog(LogPacket::Severity::DEBUG, "Handshake1GkcPacket received");
+
+        // The top byte of the sequence number optionally requests a faster link.
+        // A known code is echoed back, then the link switches after the reply.
+        const uint8_t baudCode = packet.seq_number >> 24;
+        const int requestedBaud = CommManager::GetBaudRateForCode(baudCode);
+        uint8_t acceptedCode = 0;
+        if (requestedBaud != 0) {
+            acceptedCode = baudCode;
+            if (requestedBaud == m_Comm.GetBaudRate()) {
+                m_Comm.ConfirmBaudRate();
+            } else {
+                m_Comm.RequestBaudRate(requestedBaud);
+            }
+        }
+
         Handshake2GkcPacket response;
-        response.seq_number = packet.seq_number + 1;
+        response.seq_number = ((packet.seq_number + 1) & 0x00FFFFFF) |
+                              (static_cast<uint32_t>(acceptedCode) << 24);
         m_Comm.Send(response);
     }
 
@@ -238,11 +290,65 @@ namespace tritonai::gkc {
 
     void Controller::packet_callback(const ResetRTCGkcPacket& packet) {
         SendLog(LogPacket::Severity::FATAL, "ResetRTCGkcPacket received");
+        RecordPendingReset(ResetCause::HOST_REQUEST, "");
         NVIC_SystemReset();
     }
 
     void Controller::packet_callback(const HeartbeatGkcPacket& packet) {
-        SendLog(LogPacket::Severity::DEBUG, "HeartbeatGkcPacket received");
+        GKC_LOG(HEARTBEAT_RECEIVED);
+    }
+
+    void Controller::OnLocalPacket(const uint8_t* payload, size_t len) {
+        switch (payload[0]) {
+        case GKC_ID_STEERING_CONFIG: {
+            // ID, mode, then kp, ki, kd, kff, integral limit as f32
+            constexpr size_t STEERING_CONFIG_SIZE = 2 + 5 * sizeof(float);
+            if (len < STEERING_CONFIG_SIZE || payload[1] >= static_cast<uint8_t>(SteeringMode::COUNT)) {
+                SendLog(LogPacket::Severity::WARNING, "Invalid steering config packet ignored");
+                return;
+            }
+            const SteeringMode mode = static_cast<SteeringMode>(payload[1]);
+            const SteeringGains gains{GetPayloadFloat(payload + 2), GetPayloadFloat(payload + 6),
+                                      GetPayloadFloat(payload + 10), GetPayloadFloat(payload + 14),
+                                      GetPayloadFloat(payload + 18)};
+            m_Actuation.SetSteeringMode(mode, gains);
+            SendLog(LogPacket::Severity::INFO,
+                    std::string("Steering mode ") + (mode == SteeringMode::MCU_PID ? "MCU_PID" : "VESC_POSITION") +
+                    ", kp " + std::to_string(gains.kp) + ", ki " + std::to_string(gains.ki) +
+                    ", kd " + std::to_string(gains.kd) + ", kff " + std::to_string(gains.kff) +
+                    ", i limit " + std::to_string(gains.iLimit));
+            break;
+        }
+        case GKC_ID_LOG_CONFIG: {
+            // ID, lowest severity sent to the host, for both LogPackets and the binary log
+            if (len < 2 || payload[1] > static_cast<uint8_t>(LogPacket::Severity::FATAL)) {
+                SendLog(LogPacket::Severity::WARNING, "Invalid log config packet ignored");
+                return;
+            }
+            const LogPacket::Severity severity = static_cast<LogPacket::Severity>(payload[1]);
+            m_LogForwarder.SetSeverity(severity);
+            g_BinaryLog.SetMinSeverity(severity);
+            SendLog(LogPacket::Severity::INFO, "Host log severity set to " + std::to_string(payload[1]));
+            break;
+        }
+        case GKC_ID_THREAD_INFO:
+            // Answered from the keep alive thread, the stack scan is too slow for the receive path
+            m_ThreadInfoRequested = true;
+            break;
+        case GKC_ID_PROFILER_REPORT:
+            // ID, optional report interval; either way the log thread sends a report now
+            if (len >= 3) {
+                m_ProfilerReportMs = payload[1] | (payload[2] << 8);
+            }
+            m_ProfilerReportRequested = true;
+            break;
+        case GKC_ID_RESET_CAUSE:
+            SendResetReport();
+            break;
+        default:
+            SendLog(LogPacket::Severity::DEBUG, "Unhandled local packet " + std::to_string(payload[0]));
+            break;
+        }
     }
 
     void Controller::packet_callback(const ConfigGkcPacket& packet) {
@@ -283,23 +389,18 @@ namespace tritonai::gkc {
 
     // TODO: Implement the control packet callback, partially done
     void Controller::packet_callback(const ControlGkcPacket& packet) {
-        SendLog(LogPacket::Severity::INFO, "ControlGkcPacket received");
+        GKC_LOG(CONTROL_RECEIVED, packet.throttle, packet.steering, packet.brake);
         if(GetState() != GkcLifecycle::Active) {
-            SendLog(LogPacket::Severity::INFO, "Controller is not active, ignoring ControlGkcPacket");
+            GKC_LOG(CONTROL_NOT_ACTIVE);
             return;
         }
 
         if(m_RcCommanding) {
-            SendLog(LogPacket::Severity::WARNING, "RC is commanding, ignoring ControlGkcPacket");
+            GKC_LOG(CONTROL_RC_COMMANDING);
             return;
         }
 
-        SendLog(LogPacket::Severity::DEBUG, "ControlGkcPacket received: throttle: " + 
-                std::to_string((int)(packet.throttle * 100)) + "%, " +
-                "steering: " + std::to_string((int)(packet.steering * 100)) + "%, " +
-                "brake: " + std::to_string((int)(packet.brake * 100)) + "%");
-
-        SetActuationValues(packet.throttle, packet.steering, packet.brake);
+        SetActuationValues(SetpointSource::AUTONOMY, packet.throttle, packet.steering, packet.brake);
     }
 
     // TODO: Implement the sensor packet callback
@@ -322,11 +423,16 @@ namespace tritonai::gkc {
 
     // TODO: Implement the log packet callback
     void Controller::packet_callback(const LogPacket& packet) {
-        SendLog(packet.level, packet.what);
+        // Printed only, forwarding it would echo the host's own log back
+        PrintLog(packet.level, packet.what.c_str());
     }
 
     void Controller::packet_callback(const RCControlGkcPacket& packet) {
         m_RcHeartbeat.IncCount();
+        if(m_StopOnRcDisconnect) {
+            m_RcHeartbeatDeadline.attach(callback(this, &Controller::OnRcHeartbeatDeadline),
+                                         std::chrono::milliseconds(DEFAULT_RC_HEARTBEAT_LOST_TOLERANCE_MS));
+        }
         m_RcConnected = true;
 
         // Update light tower state based on emergency stop status
@@ -336,20 +442,23 @@ namespace tritonai::gkc {
         m_CurrentAutonomyMode = packet.autonomy_mode;
 
         if (GetState() == GkcLifecycle::Uninitialized) {
-            SendLog(LogPacket::Severity::WARNING, "Controller is uninitialized, ignoring RCControlGkcPacket");
+            GKC_LOG(RC_UNINITIALIZED);
             return;
         }
 
         if(!packet.is_active && GetState() != GkcLifecycle::Inactive) {
+            if(GetState() == GkcLifecycle::Active) {
+                m_FastStop.Trigger(); // before the logs
+            }
             SendLog(LogPacket::Severity::FATAL, "RCControlGkcPacket is not active, calling EmergencyStop()");
-            SetActuationValues(0.0, 0.0, packet.brake);
+            SetActuationValues(SetpointSource::SAFETY, 0.0, 0.0, packet.brake);
             EmergencyStop();
             return;
         }
 
         if(!packet.is_active && GetState() == GkcLifecycle::Inactive) {
-            SendLog(LogPacket::Severity::INFO, "Controller transitioning to Inactive");
-            SetActuationValues(0.0, 0.0, packet.brake);
+            GKC_LOG(RC_INACTIVE_HOLD, packet.brake);
+            SetActuationValues(SetpointSource::SAFETY, 0.0, 0.0, packet.brake);
             return;
         }
 
@@ -361,15 +470,18 @@ namespace tritonai::gkc {
 
         if(packet.autonomy_mode == AUTONOMOUS) {
             m_RcCommanding = false;
-            SendLog(LogPacket::Severity::DEBUG, "RCControlGkcPacket is in autonomous mode, ignoring");
+            m_ControlLoop.Release(SetpointSource::RC);
+            GKC_LOG(RC_AUTONOMOUS);
             return;
         }
 
         // If throttle, steering, and brake are zero, then the RC is not commanding
         if(packet.throttle == 0.0 && packet.steering == 0.0 && packet.brake == 0.0) {
             m_RcCommanding = packet.autonomy_mode == AutonomyMode::MANUAL;
-            if(!m_RcCommanding)
+            if(!m_RcCommanding) {
+                m_ControlLoop.Release(SetpointSource::RC);
                 return;
+            }
         }
 
         if(packet.autonomy_mode == AutonomyMode::AUTONOMOUS_OVERRIDE || 
@@ -378,12 +490,9 @@ namespace tritonai::gkc {
             m_LastRcCommand = std::chrono::steady_clock::now();
         }
 
-        SendLog(LogPacket::Severity::INFO, 
-            "RCControlGkcPacket received: throttle: " + std::to_string((int)(packet.throttle * 100)) + "%, " +
-            "steering: " + std::to_string((int)(packet.steering * 100)) + "%, " +
-            "brake: " + std::to_string((int)(packet.brake * 100)) + "%, " +
-            "autonomy_mode: " + std::to_string(packet.autonomy_mode) + ", " +
-            "is_active: " + std::to_string(packet.is_active));
+        GKC_LOG(RC_RECEIVED, static_cast<int>(packet.throttle * 100), static_cast<int>(packet.steering * 100),
+                static_cast<int>(packet.brake * 100), static_cast<unsigned int>(packet.autonomy_mode),
+                static_cast<unsigned int>(packet.is_active));
 
         float throttleSpeed = 0.0;
 
@@ -392,7 +501,7 @@ namespace tritonai::gkc {
         else if(packet.throttle < 0.0)
             throttleSpeed = packet.throttle * RC_MAX_SPEED_REVERSE; 
 
-        SetActuationValues(throttleSpeed, packet.steering, packet.brake);
+        SetActuationValues(SetpointSource::RC, throttleSpeed, packet.steering, packet.brake);
 
         if(packet.autonomy_mode == AutonomyMode::AUTONOMOUS || 
            packet.autonomy_mode == AutonomyMode::AUTONOMOUS_OVERRIDE)
@@ -406,7 +515,7 @@ namespace tritonai::gkc {
     StateTransitionResult Controller::OnInitialize(const GkcLifecycle& lastState) {
         SendLog(LogPacket::Severity::INFO, "Controller initializing");
         m_Watchdog.Arm();
-        SetActuationValues(0.0, 0.0, EMERGENCY_BRAKE_PRESSURE);
+        SetActuationValues(SetpointSource::SAFETY, 0.0, 0.0, EMERGENCY_BRAKE_PRESSURE);
 
         return StateTransitionResult::SUCCESS;
     }
@@ -422,6 +531,8 @@ namespace tritonai::gkc {
     // TODO: Implement on_activate
     StateTransitionResult Controller::OnActivate(const GkcLifecycle& lastState) {
         SendLog(LogPacket::Severity::INFO, "Controller activating");
+        m_ControlLoop.Release(SetpointSource::SAFETY);
+        m_FastStop.Release();
         m_ThrottleVescDisable = 0;
         m_SteeringVescDisable = 0;
         return StateTransitionResult::SUCCESS;
@@ -430,7 +541,7 @@ namespace tritonai::gkc {
     // TODO: Implement on_emergency_stop
     StateTransitionResult Controller::OnEmergencyStop(const GkcLifecycle& lastState) {
         SendLog(LogPacket::Severity::INFO, "Controller emergency stopping");
-        SetActuationValues(0.0, 0.0, EMERGENCY_BRAKE_PRESSURE);
+        SetActuationValues(SetpointSource::SAFETY, 0.0, 0.0, EMERGENCY_BRAKE_PRESSURE);
         m_ThrottleVescDisable = 1;
         m_SteeringVescDisable = 1;
         m_EmergencyActive = true;
@@ -440,7 +551,7 @@ namespace tritonai::gkc {
     // TODO: Implement on_reinitialize
     StateTransitionResult Controller::OnReinitialize(const GkcLifecycle& lastState) {
         SendLog(LogPacket::Severity::INFO, "Controller reinitializing");
-        SetActuationValues(0.0, 0.0, EMERGENCY_BRAKE_PRESSURE);
+        SetActuationValues(SetpointSource::SAFETY, 0.0, 0.0, EMERGENCY_BRAKE_PRESSURE);
         m_ThrottleVescDisable = 0;
         m_SteeringVescDisable = 0;
         m_EmergencyActive = false;
@@ -448,18 +559,198 @@ namespace tritonai::gkc {
         return StateTransitionResult::SUCCESS;
     }
 
-    void Controller::SetActuationValues(float throttle, float steering, float brake) {
-        if(GetState() != GkcLifecycle::Active) {
-            SendLog(LogPacket::Severity::INFO, "Controller is not active, ignoring SetActuationValues");
-            m_Actuation.FullRelRevCurrentBrake();
-            m_Actuation.SetBrakeCmd(brake);
-            m_Actuation.SetSteeringCmd(0.0);
+    void Controller::SetActuationValues(SetpointSource source, float throttle, float steering, float brake) {
+        // Applied by the control loop on its next tick
+        m_ControlLoop.Submit(source, ActuationSetpoint{throttle, steering, brake});
+    }
+
+    void Controller::ApplySetpoint(const ActuationSetpoint& setpoint) {
+        // Runs on the control loop thread every tick, must not log or block
+        const bool stopped = m_FastStop.IsLatched();
+        if(GetState() != GkcLifecycle::Active || stopped) {
+            // Latched, the SAFETY setpoint may not have arrived yet
+            const float brake = stopped ? EMERGENCY_BRAKE_PRESSURE : setpoint.brake;
+            const uint32_t nowUs = GetTimestampUs();
+
+            // Sent on the way in and when the brake changes, then only refreshed
+            // in case a frame was lost, instead of three frames every tick
+            const bool resend = !m_StopSent || brake != m_StopBrake ||
+                                nowUs - m_StopSentUs >= CONTROL_STOP_RESEND_MS * 1000;
+            if (resend) {
+                m_Actuation.FullRelRevCurrentBrake();
+                m_Actuation.SetBrakeCmd(brake);
+                m_Actuation.SetSteeringCmd(0.0);
+                m_StopSent = true;
+                m_StopBrake = brake;
+                m_StopSentUs = nowUs;
+            }
+
+            // Steering keeps ramping to center until it gets there
+            if (resend || !m_Actuation.IsSteeringSettled()) {
+                m_Actuation.Update(CONTROL_LOOP_PERIOD_US / 1e6f);
+            }
+            return;
+        }
+
+        m_StopSent = false;
+        m_Actuation.SetSteeringCmd(setpoint.steering);
+        m_Actuation.SetThrottleCmd(setpoint.throttle);
+        m_Actuation.SetBrakeCmd(setpoint.brake);
+
+        // Shaped throttle and steering move one control period toward the targets
+        m_Actuation.Update(CONTROL_LOOP_PERIOD_US / 1e6f);
+    }
+
+    void Controller::ReportControlJitter() {
+        auto now = chrono::steady_clock::now();
+        if (now - m_LastJitterReport < chrono::milliseconds(CONTROL_JITTER_REPORT_MS)) {
+            return;
+        }
+        m_LastJitterReport = now;
+
+        const ControlJitterStats stats = m_ControlLoop.GetJitterStats();
+        std::string histogram;
+        for (size_t i = 0; i < ControlJitterStats::BUCKET_COUNT; i++) {
+            histogram += (i + 1 < ControlJitterStats::BUCKET_COUNT)
+                ? " <=" + std::to_string(ControlJitterStats::BUCKET_EDGES_US[i]) + "us:"
+                : " >" + std::to_string(ControlJitterStats::BUCKET_EDGES_US[i - 1]) + "us:";
+            histogram += std::to_string(stats.buckets[i]);
+        }
+        SendLog(LogPacket::Severity::INFO,
+                "Control loop jitter over " + std::to_string(stats.ticks) + " ticks," + histogram +
+                ", max " + std::to_string(stats.maxJitterUs) + "us, missed " +
+                std::to_string(stats.missedTicks));
+    }
+
+    void Controller::ReportFastStop() {
+        // The fast stop itself does not log
+        uint32_t sendUs = 0;
+        if (m_FastStop.TakeTrigger(sendUs)) {
+            SendLog(LogPacket::Severity::WARNING,
+                    "Fast stop sent brake and throttle release frames in " + std::to_string(sendUs) + "us");
+        }
+
+        // An RC packet right after the deadline satisfies m_RcHeartbeat before
+        // the watch thread runs OnRcDisconnect, which then never leaves Active
+        if (m_FastStop.IsLatched() && GetState() == GkcLifecycle::Active) {
+            SendLog(LogPacket::Severity::FATAL, "Fast stop latched while Active, calling EmergencyStop()");
+            SetActuationValues(SetpointSource::SAFETY, 0.0, 0.0, EMERGENCY_BRAKE_PRESSURE);
+            EmergencyStop();
+        }
+    }
+
+    static uint16_t Saturate16(uint32_t value) {
+        return value > UINT16_MAX ? UINT16_MAX : static_cast<uint16_t>(value);
+    }
+
+    static void AppendU16(uint8_t* payload, size_t& index, uint16_t value) {
+        payload[index++] = value & 0xFF;
+        payload[index++] = value >> 8;
+    }
+
+    static void AppendU32(uint8_t* payload, size_t& index, uint32_t value) {
+        AppendU16(payload, index, value & 0xFFFF);
+        AppendU16(payload, index, value >> 16);
+    }
+
+    void Controller::ReportThreadStats() {
+        const bool infoRequested = m_ThreadInfoRequested.exchange(false);
+        auto now = chrono::steady_clock::now();
+        if (!infoRequested && now - m_LastThreadStatsReport < chrono::milliseconds(THREAD_STATS_REPORT_MS)) {
             return;
         }
+        const auto windowMs = chrono::duration_cast<chrono::milliseconds>(now - m_LastThreadStatsReport).count();
+        m_LastThreadStatsReport = now;
+
+        ThreadStats stats[THREAD_MONITOR_MAX_THREADS];
+        uint32_t otherSamples = 0;
+        const size_t count = g_ThreadMonitor.TakeWindow(stats, THREAD_MONITOR_MAX_THREADS, otherSamples);
+        if (infoRequested) {
+            SendThreadInfo(stats, count);
+        }
+
+        uint32_t totalSamples = otherSamples;
+        for (size_t i = 0; i < count; i++) {
+            totalSamples += stats[i].cpuSamples;
+        }
+        const auto cpuShare = [totalSamples](uint32_t samples) {
+            return static_cast<uint16_t>(totalSamples ? static_cast<uint64_t>(samples) * 10000 / totalSamples : 0);
+        };
+
+        // ID, window, count, then 11 bytes per thread and for "other" (index 0xFF)
+        constexpr size_t THREAD_STATS_ENTRY_SIZE = 11;
+        uint8_t payload[4 + (THREAD_MONITOR_MAX_THREADS + 1) * THREAD_STATS_ENTRY_SIZE];
+        static_assert(sizeof(payload) <= GKC_FRAME_MAX_PAYLOAD, "Thread stats must fit one packet");
+        size_t index = 0;
+        payload[index++] = GKC_ID_THREAD_STATS;
+        AppendU16(payload, index, Saturate16(windowMs));
+        payload[index++] = count + 1;
+        for (size_t i = 0; i < count; i++) {
+            const ThreadStats& thread = stats[i];
+            payload[index++] = i;
+            AppendU16(payload, index, cpuShare(thread.cpuSamples));
+            AppendU16(payload, index, Saturate16(thread.stackSize - thread.stackMaxUsed));
+            AppendU16(payload, index, Saturate16(thread.wakeups));
+            AppendU16(payload, index, Saturate16(thread.latencyCount ? thread.latencySumUs / thread.latencyCount : 0));
+            AppendU16(payload, index, Saturate16(thread.latencyMaxUs));
+        }
+        payload[index++] = 0xFF;
+        AppendU16(payload, index, cpuShare(otherSamples));
+        for (size_t i = 0; i < 4; i++) {
+            AppendU16(payload, index, 0);
+        }
+        m_Comm.SendRaw(payload, index);
+    }
 
-        m_Actuation.SetSteeringCmd(steering);
-        m_Actuation.SetThrottleCmd(throttle);
-        m_Actuation.SetBrakeCmd(brake);
+    void Controller::SendResetReport() {
+        const size_t nameLen = strnlen(m_ResetReport.name, sizeof(m_ResetReport.name));
+        uint8_t payload[4 + sizeof(m_ResetReport.name)];
+        size_t index = 0;
+        payload[index++] = GKC_ID_RESET_CAUSE;
+        payload[index++] = static_cast<uint8_t>(m_ResetReport.cause);
+        payload[index++] = m_ResetReport.hardwareReason;
+        payload[index++] = nameLen;
+        memcpy(payload + index, m_ResetReport.name, nameLen);
+        index += nameLen;
+        m_Comm.SendRaw(payload, index);
+
+        const bool expected = m_ResetReport.cause == ResetCause::POWER_ON || m_ResetReport.cause == ResetCause::PIN ||
+                              m_ResetReport.cause == ResetCause::HOST_REQUEST;
+        SendLog(expected ? LogPacket::Severity::INFO : LogPacket::Severity::WARNING,
+                std::string("Last reset: ") + GetResetCauseName(m_ResetReport.cause) +
+                (nameLen ? std::string(" (") + m_ResetReport.name + ")" : std::string()));
+    }
+
+    void Controller::SendThreadInfo(const ThreadStats* stats, size_t count) {
+        // Static description of each thread, split over packets when the names don't fit one
+        constexpr size_t THREAD_INFO_ENTRY_SIZE = 7; // index, priority, stack size, max used, name length
+        uint8_t payload[GKC_FRAME_MAX_PAYLOAD];
+        size_t index = 0;
+
+        for (size_t i = 0; i < count; i++) {
+            const char* name = stats[i].name != nullptr ? stats[i].name : "";
+            const size_t nameLen = strnlen(name, UINT8_MAX - THREAD_INFO_ENTRY_SIZE);
+            if (index + THREAD_INFO_ENTRY_SIZE + nameLen > sizeof(payload)) {
+                m_Comm.SendRaw(payload, index);
+                index = 0;
+            }
+            if (index == 0) {
+                payload[index++] = GKC_ID_THREAD_INFO;
+                payload[index++] = 0;
+            }
+            payload[1]++;
+            payload[index++] = i;
+            payload[index++] = static_cast<uint8_t>(stats[i].priority);
+            AppendU16(payload, index, Saturate16(stats[i].stackSize));
+            AppendU16(payload, index, Saturate16(stats[i].stackMaxUsed));
+            payload[index++] = nameLen;
+            memcpy(payload + index, name, nameLen);
+            index += nameLen;
+        }
+
+        if (index > 0) {
+            m_Comm.SendRaw(payload, index);
+        }
     }
 
     void Controller::SensorSendThreadImpl() {
@@ -467,16 +758,179 @@ namespace tritonai::gkc {
                 std::to_string(SEND_SENSOR_INTERVAL_MS) + "ms interval");
 
         while(true) {
-            const SensorGkcPacket& sensorPacket = m_SensorReader.GetPacket();
+#ifdef SENSOR_EVENT_DRIVEN
+            // Publish as soon as the reader has new data, at least every interval
+            m_SensorReader.WaitForUpdate(std::chrono::milliseconds(SEND_SENSOR_INTERVAL_MS));
+#endif
+            const SensorSnapshot snapshot = m_SensorReader.GetSnapshot();
+            const SensorGkcPacket& sensorPacket = snapshot.packet;
             m_Comm.Send(sensorPacket);
+            SendSensorAges(snapshot.stamps);
 
-            SendLog(LogPacket::Severity::DEBUG, 
-                    "Sensor packet - Steering: " + std::to_string(sensorPacket.values.steering_angle_rad) + 
-                    " rad, Speed: " + std::to_string(sensorPacket.values.wheel_speed_rl) + " m/s" +
-                    ", Brake Pressure: " + std::to_string(sensorPacket.values.brake_pressure) + " PSI");
+            GKC_LOG(SENSOR_SENT, sensorPacket.values.steering_angle_rad, sensorPacket.values.wheel_speed_rl,
+                    sensorPacket.values.brake_pressure);
 
-            ThisThread::sleep_for(std::chrono::milliseconds(SEND_SENSOR_INTERVAL_MS));
+#ifdef SENSOR_EVENT_DRIVEN
+            g_ThreadMonitor.SleepFor(std::chrono::milliseconds(SENSOR_SEND_MIN_INTERVAL_MS));
+#else
+            g_ThreadMonitor.SleepFor(std::chrono::milliseconds(SEND_SENSOR_INTERVAL_MS));
+#endif
+        }
+    }
+
+    void Controller::SendSensorAges(const SensorTimestamps& stamps) {
+        // SensorGkcPacket has no room for timestamps, so the age of each field
+        // follows it in a firmware-local packet (never captured = 0xFFFFFFFF)
+        const uint32_t ages[] = {
+            stamps.steeringAngleUs ? GetAgeUs(stamps.steeringAngleUs) : UINT32_MAX,
+            stamps.wheelSpeedUs ? GetAgeUs(stamps.wheelSpeedUs) : UINT32_MAX,
+            stamps.brakePressureUs ? GetAgeUs(stamps.brakePressureUs) : UINT32_MAX,
+        };
+
+        uint8_t payload[1 + sizeof(ages)];
+        size_t index = 0;
+        payload[index++] = GKC_ID_SENSOR_AGE;
+        for (uint32_t age : ages) {
+            payload[index++] = age & 0xFF;
+            payload[index++] = (age >> 8) & 0xFF;
+            payload[index++] = (age >> 16) & 0xFF;
+            payload[index++] = (age >> 24) & 0xFF;
+        }
+        m_Comm.SendRaw(payload, index);
+    }
+
+    void Controller::LogThreadImpl() {
+        while(true) {
+            g_ThreadMonitor.SleepFor(std::chrono::milliseconds(BINARY_LOG_DRAIN_INTERVAL_MS));
+            // LogPackets first, the binary log gets the rest of their byte budget
+            m_LogForwarder.Flush();
+            DrainBinaryLog();
+            ReportProfilers();
+        }
+    }
+
+    void Controller::DrainBinaryLog() {
+        // Records are printed here when the console severity allows and sent
+        // to the host in as few GKC_ID_BINARY_LOG packets as fit. Packets over
+        // the log byte budget are not sent, their records count as dropped in
+        // the next packet that is.
+        constexpr size_t RECORD_HEADER_SIZE = 7; // format ID, stamp, argument count
+        uint8_t payload[GKC_FRAME_MAX_PAYLOAD];
+        size_t index = 0;
+        uint32_t records = 0;
+        char text[128];
+
+        const auto sendPacket = [&]() {
+            if(m_LogForwarder.TakeBudget(index)) {
+                m_Comm.SendRaw(payload, index);
+            } else {
+                m_BinaryLogUnsent += payload[1] + records;
+            }
+            index = 0;
+            records = 0;
+        };
+
+        LogRecord record;
+        while(g_BinaryLog.Pop(record)) {
+            const LogPacket::Severity severity = GetLogSeverity(record);
+            if(m_Severity <= severity) {
+                FormatLogRecord(record, text, sizeof(text));
+                PrintLog(severity, text);
+            }
+
+            const size_t recordSize = RECORD_HEADER_SIZE + record.argCount * sizeof(uint32_t);
+            if(index + recordSize > sizeof(payload)) {
+                sendPacket();
+            }
+            if(index == 0) {
+                const uint32_t dropped = g_BinaryLog.TakeDropped() + m_BinaryLogUnsent;
+                m_BinaryLogUnsent = 0;
+                payload[index++] = GKC_ID_BINARY_LOG;
+                payload[index++] = dropped > UINT8_MAX ? UINT8_MAX : dropped;
+            }
+            records++;
+
+            const uint16_t formatId = static_cast<uint16_t>(record.formatId);
+            payload[index++] = formatId & 0xFF;
+            payload[index++] = formatId >> 8;
+            for(size_t shift = 0; shift < 32; shift += 8) {
+                payload[index++] = (record.stampUs >> shift) & 0xFF;
+            }
+            payload[index++] = record.argCount;
+            for(size_t i = 0; i < record.argCount; i++) {
+                for(size_t shift = 0; shift < 32; shift += 8) {
+                    payload[index++] = (record.args[i] >> shift) & 0xFF;
+                }
+            }
+        }
+
+        if(index > 0) {
+            sendPacket();
+        }
+    }
+
+    void Controller::ReportProfilers() {
+        // A round sends one profiler per log thread wakeup, so it never fills
+        // the LOG queue ahead of the log messages
+        const uint32_t nowMs = static_cast<uint32_t>(Kernel::Clock::now().time_since_epoch().count());
+        if (m_ProfilerReportIndex == GLOBAL_PROFILER_COUNT) {
+            const uint32_t intervalMs = m_ProfilerReportMs;
+            const bool requested = m_ProfilerReportRequested.exchange(false);
+            if (!requested && (intervalMs == 0 || nowMs - m_LastProfilerRoundMs < intervalMs)) {
+                return;
+            }
+            m_LastProfilerRoundMs = nowMs;
+            m_ProfilerReportSeq++;
+            m_ProfilerReportIndex = 0;
+        }
+
+        const size_t probe = m_ProfilerReportIndex++;
+        SendProfilerReport(probe, nowMs - m_LastProfilerReportMs[probe]);
+        m_LastProfilerReportMs[probe] = nowMs;
+    }
+
+    void Controller::SendProfilerReport(size_t probe, uint32_t windowMs) {
+        // Round sequence, probe index, probe count, tick rate, window (ms), sample count,
+        // max (ticks), sub-bucket bits, name, then u16 bucket index and u32 count for each
+        // non-empty bucket. Buckets that don't fit go into further packets with the same header.
+        Profiler& profiler = *GlobalProfilers[probe];
+        profiler.GetSnapshot(m_ProfilerSnapshot, true);
+
+        const char* name = profiler.GetName();
+        const size_t nameLen = strnlen(name, 32);
+        uint8_t payload[GKC_FRAME_MAX_PAYLOAD];
+        size_t index = 0;
+        const auto startPacket = [&]() {
+            index = 0;
+            payload[index++] = GKC_ID_PROFILER_REPORT;
+            payload[index++] = m_ProfilerReportSeq;
+            payload[index++] = probe;
+            payload[index++] = GLOBAL_PROFILER_COUNT;
+            AppendU32(payload, index, GetProfilerTickRate());
+            AppendU16(payload, index, Saturate16(windowMs));
+            AppendU32(payload, index, m_ProfilerSnapshot.count);
+            AppendU32(payload, index, m_ProfilerSnapshot.maxTicks);
+            payload[index++] = PROFILER_SUB_BUCKET_BITS;
+            payload[index++] = nameLen;
+            memcpy(payload + index, name, nameLen);
+            index += nameLen;
+        };
+
+        // PROFILER_SUB_BUCKET_BITS 4 already needs 464 buckets
+        static_assert(ProfilerHistogram::BUCKET_COUNT <= UINT16_MAX + 1, "Bucket index must fit its u16");
+        startPacket();
+        for (size_t bucket = 0; bucket < ProfilerHistogram::BUCKET_COUNT; bucket++) {
+            if (m_ProfilerSnapshot.buckets[bucket] == 0) {
+                continue;
+            }
+            if (index + 6 > sizeof(payload)) {
+                m_Comm.SendRaw(payload, index);
+                startPacket();
+            }
+            AppendU16(payload, index, bucket);
+            AppendU32(payload, index, m_ProfilerSnapshot.buckets[bucket]);
         }
+        m_Comm.SendRaw(payload, index);
     }
 
 } // namespace tritonai::gkc
\ No newline at end of file
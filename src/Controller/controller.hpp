@@ -9,14 +9,21 @@
 
 #include "config.hpp"
 #include "Comm/comm.hpp"
+#include "Comm/log_forwarder.hpp"
 #include "tai_gokart_packet/gkc_packet_subscriber.hpp"
+#include "Watchdog/reset_record.hpp"
 #include "Watchdog/watchdog.hpp"
 #include "Sensor/sensor_reader.hpp"
 #include "Actuation/actuation_controller.hpp"
+#include "Actuation/fast_stop.hpp"
 #include "RCController/rc_controller.hpp"
 #include "StateMachine/state_machine.hpp"
 #include "Sensor/brake_pressure_sensor.hpp"
 #include "Sensor/can_sensor_provider.hpp"
+#include "Controller/control_loop.hpp"
+#include "Tools/global_profilers.hpp"
+#include "Tools/thread_monitor.hpp"
+#include <atomic>
 #include <chrono>
 
 namespace tritonai::gkc {
@@ -50,9 +57,13 @@ namespace tritonai::gkc {
         void packet_callback(const LogPacket& packet);
         void packet_callback(const RCControlGkcPacket& packet);
 
-        // ILogger API
-        void SendLog(const LogPacket::Severity& severity, 
+        // Firmware-local packets (gkc_frame.hpp), payload starts with the packet ID
+        void OnLocalPacket(const uint8_t* payload, size_t len);
+
+        // ILogger API, not inlined so the return address identifies the call site
+        MBED_NOINLINE void SendLog(const LogPacket::Severity& severity, 
                     const std::string& what) override;
+        void PrintLog(const LogPacket::Severity& severity, const char* what);
         LogPacket::Severity m_Severity;
 
         // Watchable API
@@ -66,6 +77,9 @@ namespace tritonai::gkc {
         StateTransitionResult OnReinitialize(const GkcLifecycle& lastState) override;
 
     private:
+        const ResetReport m_ResetReport; // first, read before anything can record a new reset
+        void SendResetReport();
+        LogForwarder m_LogForwarder; // before m_Comm, which logs while constructing
         CommManager m_Comm;
         Watchdog m_Watchdog;
         SensorReader m_SensorReader;
@@ -73,16 +87,47 @@ namespace tritonai::gkc {
         RCController m_RcController;
         BrakePressureSensor m_BrakePressureSensor;
         CanSensorProvider m_CanSensorProvider;
+        ControlLoop m_ControlLoop;
 
         Thread m_KeepAliveThread{osPriorityNormal, OS_STACK_SIZE, nullptr, "keep_alive_thread"};
         Thread m_SensorSendThread{osPriorityNormal, OS_STACK_SIZE, nullptr, "sensor_send_thread"};
         void SensorSendThreadImpl();
+        void SendSensorAges(const SensorTimestamps& stamps);
+        Thread m_LogThread{osPriorityLow, OS_STACK_SIZE, nullptr, "log_thread"};
+        void LogThreadImpl();
+        void DrainBinaryLog();
+        uint32_t m_BinaryLogUnsent{0}; // records over the log byte budget, reported as dropped
+        void ReportProfilers();
+        void SendProfilerReport(size_t probe, uint32_t windowMs);
+        std::atomic<bool> m_ProfilerReportRequested{false};
+        std::atomic<uint32_t> m_ProfilerReportMs{PROFILER_REPORT_MS};
+        // Log thread only
+        ProfilerSnapshot m_ProfilerSnapshot; // ~1 KB, kept off the log thread stack
+        size_t m_ProfilerReportIndex{GLOBAL_PROFILER_COUNT}; // next profiler of the round, COUNT = idle
+        uint8_t m_ProfilerReportSeq{0};
+        uint32_t m_LastProfilerRoundMs{0};
+        uint32_t m_LastProfilerReportMs[GLOBAL_PROFILER_COUNT] = {};
         bool m_RcCommanding{false};
         std::chrono::time_point<std::chrono::steady_clock> m_LastRcCommand = std::chrono::steady_clock::now();
         Watchable m_RcHeartbeat;
         void OnRcDisconnect();
+        FastStop m_FastStop;
+        Timeout m_RcHeartbeatDeadline; // re-armed by every RC packet, fires in interrupt context
+        void OnRcHeartbeatDeadline();
+        void ReportFastStop(); // also leaves Active when the latch was set without OnRcDisconnect
         bool m_StopOnRcDisconnect{true};
-        void SetActuationValues(float throttle, float steering, float brake);
+        void SetActuationValues(SetpointSource source, float throttle, float steering, float brake);
+        void ApplySetpoint(const ActuationSetpoint& setpoint);
+        // Stop frames while not Active, control loop thread only
+        bool m_StopSent{false};
+        float m_StopBrake{0.0f};
+        uint32_t m_StopSentUs{0};
+        void ReportControlJitter();
+        chrono::time_point<chrono::steady_clock> m_LastJitterReport = chrono::steady_clock::now();
+        void ReportThreadStats();
+        void SendThreadInfo(const ThreadStats* stats, size_t count);
+        chrono::time_point<chrono::steady_clock> m_LastThreadStatsReport = chrono::steady_clock::now();
+        std::atomic<bool> m_ThreadInfoRequested{false}; // set by GKC_ID_THREAD_INFO, served by the keep alive thread
         DigitalOut m_Led{LED1};
         DigitalOut m_TowerLightRed{TOWER_LIGHT_RED, 0};
         DigitalOut m_TowerLightYellow{TOWER_LIGHT_YELLOW, 0};
@@ -6,6 +6,7 @@
  */
 
 #include "rc_controller.hpp"
+#include "Tools/thread_monitor.hpp"
 #include <iostream>
 #include <string>
 
@@ -77,7 +78,7 @@ namespace tritonai::gkc {
         const uint16_t* busData = m_Receiver.busData();
 
         while (true) {
-            ThisThread::sleep_for(10ms);
+            g_ThreadMonitor.SleepFor(10ms);
             IncCount();
 
             if (!m_Receiver.gatherData())
@@ -179,6 +180,7 @@ namespace tritonai::gkc {
 #endif
     {
         m_RCThread.start(callback(this, &RCController::Update));
+        g_ThreadMonitor.Register(m_RCThread);
         Attach(callback(this, &RCController::WatchdogCallback));
     }
 
@@ -6,6 +6,8 @@
  */
 
 #include "brake_pressure_sensor.hpp"
+#include "Tools/binary_log.hpp"
+#include "Tools/timestamp.hpp"
 #include <string>
 
 namespace tritonai::gkc {
@@ -22,16 +24,15 @@ namespace tritonai::gkc {
         return true;
     }
 
-    void BrakePressureSensor::PopulateReading(SensorGkcPacket& pkt) {
+    void BrakePressureSensor::PopulateReading(SensorGkcPacket& pkt, SensorTimestamps& stamps) {
         float normalizedValue = m_BrakeSensor.read();
         m_CurrentPressure = normalizedValue * 1000.0f;
 
         // Populate the packet
         pkt.values.brake_pressure = m_CurrentPressure;
+        stamps.brakePressureUs = GetTimestampUs();
 
-        m_Logger->SendLog(LogPacket::Severity::DEBUG, 
-            "Brake pressure: " + std::to_string((int)m_CurrentPressure) + 
-            " PSI (Raw: " + std::to_string(normalizedValue) + ")");
+        GKC_LOG(BRAKE_PRESSURE_READ, static_cast<int>(m_CurrentPressure), normalizedValue);
     }
 
     float BrakePressureSensor::GetPressure() const {
@@ -23,7 +23,7 @@ namespace tritonai::gkc {
     public:
         BrakePressureSensor(ILogger* logger);
         bool IsReady() override;
-        void PopulateReading(SensorGkcPacket& pkt) override;
+        void PopulateReading(SensorGkcPacket& pkt, SensorTimestamps& stamps) override;
         float GetPressure() const;
         
     private:
@@ -7,7 +7,7 @@
 
 #include "can_sensor_provider.hpp"
 #include "Actuation/vesc_can_tools.hpp"
-#include <cmath>
+#include "Tools/binary_log.hpp"
 #include <string>
 
 namespace tritonai::gkc {
@@ -23,31 +23,42 @@ namespace tritonai::gkc {
         return true;
     }
 
-    void CanSensorProvider::PopulateReading(SensorGkcPacket& pkt) {
+    void CanSensorProvider::AttachUpdateNotifier(Callback<void()> notify) {
+        m_Notify = notify;
+        SetCanFeedbackCallback(callback(this, &CanSensorProvider::OnCanFeedback));
+    }
+
+    void CanSensorProvider::OnCanFeedback() {
+        m_HasUpdate = true;
+        if (m_Notify) {
+            m_Notify();
+        }
+    }
+
+    void CanSensorProvider::PopulateReading(SensorGkcPacket& pkt, SensorTimestamps& stamps) {
         // Get steering angle from CAN feedback
-        float steeringAngle = CommCanGetAngle();
-        if (!std::isnan(steeringAngle)) {
-            pkt.values.steering_angle_rad = steeringAngle;
+        const Stamped<float> steeringAngle = CommCanGetAngle();
+        if (steeringAngle.IsValid()) {
+            pkt.values.steering_angle_rad = steeringAngle.value;
+            stamps.steeringAngleUs = steeringAngle.stampUs;
         } else {
             // Set to 0 as fallback
-            m_Logger->SendLog(LogPacket::Severity::WARNING, 
-                "CAN steering angle feedback not available - setting to 0");
+            GKC_LOG(CAN_STEERING_MISSING);
             pkt.values.steering_angle_rad = 0.0f;
         }
         
         // Get speed from CAN feedback
-        float canSpeed = CommCanGetSpeed();
-        if (!std::isnan(canSpeed)) {
+        const Stamped<float> canSpeed = CommCanGetSpeed();
+        if (canSpeed.IsValid()) {
             // CAN speed is used on all wheels, best estimate we have
-            pkt.values.wheel_speed_fl = canSpeed;
-            pkt.values.wheel_speed_fr = canSpeed;
-            pkt.values.wheel_speed_rl = canSpeed;
-            pkt.values.wheel_speed_rr = canSpeed;
+            pkt.values.wheel_speed_fl = canSpeed.value;
+            pkt.values.wheel_speed_fr = canSpeed.value;
+            pkt.values.wheel_speed_rl = canSpeed.value;
+            pkt.values.wheel_speed_rr = canSpeed.value;
+            stamps.wheelSpeedUs = canSpeed.stampUs;
         } else {
             // Set all wheel speeds to 0 as fallback
-            m_Logger->SendLog(LogPacket::Severity::WARNING, 
-                "CAN speed feedback not available - setting all wheel speeds to 0");
-            
+            GKC_LOG(CAN_SPEED_MISSING);
             pkt.values.wheel_speed_fl = 0.0f;
             pkt.values.wheel_speed_fr = 0.0f;
             pkt.values.wheel_speed_rl = 0.0f;
@@ -55,22 +66,24 @@ namespace tritonai::gkc {
         }
     }
 
-    float CanSensorProvider::GetSteeringAngle() const {
+    Stamped<float> CanSensorProvider::GetSteeringAngle() const {
         return CommCanGetAngle();
     }
 
-    float CanSensorProvider::GetSpeed() const {
+    Stamped<float> CanSensorProvider::GetSpeed() const {
         return CommCanGetSpeed();
     }
 
-    bool CanSensorProvider::IsSteeringDataValid() const {
-        float angle = CommCanGetAngle();
-        return !std::isnan(angle);
+    bool CanSensorProvider::IsSteeringDataValid(uint32_t maxAgeMs) const {
+        return CommCanGetAngle().IsFresh(maxAgeMs);
+    }
+
+    bool CanSensorProvider::IsSpeedDataValid(uint32_t maxAgeMs) const {
+        return CommCanGetSpeed().IsFresh(maxAgeMs);
     }
 
-    bool CanSensorProvider::IsSpeedDataValid() const {
-        float speed = CommCanGetSpeed();
-        return !std::isnan(speed);
+    Stamped<VescTelemetry> CanSensorProvider::GetTelemetry(uint8_t controllerId) const {
+        return CommCanGetTelemetry(controllerId);
     }
 
 } // namespace tritonai::gkc
\ No newline at end of file
@@ -8,8 +8,11 @@
 #pragma once
 
 #include "Sensor/sensor_reader.hpp"
+#include "Actuation/vesc_status.hpp"
+#include "Tools/stamped_value.hpp"
 #include "Tools/logger.hpp"
 #include "config.hpp"
+#include <atomic>
 
 namespace tritonai::gkc {
 
@@ -36,35 +39,60 @@ namespace tritonai::gkc {
         /**
          * @brief Populate sensor packet with CAN-based sensor readings
          * @param pkt Packet to populate with steering angle and other CAN data
+         * @param stamps Set to the CAN frame arrival time of each field
          */
-        void PopulateReading(SensorGkcPacket& pkt) override;
+        void PopulateReading(SensorGkcPacket& pkt, SensorTimestamps& stamps) override;
+
+        /**
+         * @brief Notify on every decoded steering or speed feedback frame
+         */
+        void AttachUpdateNotifier(Callback<void()> notify) override;
+
+        /**
+         * @brief Check and clear the feedback-arrived flag
+         */
+        bool TakeUpdate() override { return m_HasUpdate.exchange(false); }
         
         /**
          * @brief Get the current steering angle from CAN feedback
-         * @return Steering angle in radians, or NaN if not available
+         * @return Steering angle in radians with its arrival time, invalid if never received
          */
-        float GetSteeringAngle() const;
+        Stamped<float> GetSteeringAngle() const;
         
         /**
          * @brief Get the current speed from CAN feedback
-         * @return Speed in m/s, or NaN if not available
+         * @return Speed in m/s with its arrival time, invalid if never received
          */
-        float GetSpeed() const;
+        Stamped<float> GetSpeed() const;
         
         /**
-         * @brief Check if steering angle data has been received
-         * @return True if valid steering data is available
+         * @brief Check if steering angle data has been received recently
+         * @param maxAgeMs Oldest feedback still considered valid
+         * @return True if fresh steering data is available
          */
-        bool IsSteeringDataValid() const;
+        bool IsSteeringDataValid(uint32_t maxAgeMs = CAN_FEEDBACK_TIMEOUT_MS) const;
         
         /**
-         * @brief Check if speed data has been received
-         * @return True if valid speed data is available
+         * @brief Check if speed data has been received recently
+         * @param maxAgeMs Oldest feedback still considered valid
+         * @return True if fresh speed data is available
          */
-        bool IsSpeedDataValid() const;
+        bool IsSpeedDataValid(uint32_t maxAgeMs = CAN_FEEDBACK_TIMEOUT_MS) const;
+
+        /**
+         * @brief Get every status value last reported by a VESC
+         * @param controllerId CAN ID of the VESC, e.g. THROTTLE_CAN_ID
+         * @return Decoded telemetry, check value.Has() per status frame; invalid
+         *         if no status frame has been received from the VESC
+         */
+        Stamped<VescTelemetry> GetTelemetry(uint8_t controllerId) const;
         
     private:
         ILogger* m_Logger;
+        Callback<void()> m_Notify;
+        std::atomic<bool> m_HasUpdate{false};
+
+        void OnCanFeedback();
     };
 
 } // namespace tritonai::gkc
\ No newline at end of file
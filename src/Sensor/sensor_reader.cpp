@@ -9,6 +9,8 @@
 #include "ThisThread.h"
 #include "config.hpp"
 #include "Watchdog/watchdog.hpp"
+#include "Tools/global_profilers.hpp"
+#include "Tools/thread_monitor.hpp"
 #include <cstdio>
 #include <string>
 
@@ -20,28 +22,65 @@ namespace tritonai::gkc {
                     "SensorReader"),
         m_Logger(logger) {
         m_SensorPollThread.start(callback(this, &SensorReader::SensorPollThreadImpl));
+        g_ThreadMonitor.Register(m_SensorPollThread);
         m_Logger->SendLog(LogPacket::Severity::INFO, "SensorReader initialized");
         Attach(callback(this, &SensorReader::WatchdogCallback));
     }
 
     void SensorReader::SensorPollThreadImpl() {
+        auto lastFullPoll = Kernel::Clock::now();
+
         while (!ThisThread::flags_get()) {
+            // Wake on a pushed update or when the polled providers are due
+            auto untilPoll = m_PollInterval - std::chrono::duration_cast<std::chrono::milliseconds>(
+                Kernel::Clock::now() - lastFullPoll);
+            if (untilPoll.count() > 0) {
+                m_Flags.wait_any_for(PROVIDER_UPDATE_FLAG, untilPoll);
+                g_ThreadMonitor.RecordWake();
+            }
+
+            const bool fullPoll = Kernel::Clock::now() - lastFullPoll >= m_PollInterval;
+            if (fullPoll) {
+                lastFullPoll = Kernel::Clock::now();
+            }
+
+            SensorProfiler.StartTimer();
+            bool updated = false;
             m_ProvidersLock.lock();
             for (auto& provider : m_Providers) {
-                if (provider->IsReady()) {
-                    provider->PopulateReading(m_Packet);
+                // Always clear the pushed flag so a full poll doesn't leave it set
+                const bool pushed = provider->TakeUpdate();
+                if ((fullPoll || pushed) && provider->IsReady()) {
+                    provider->PopulateReading(m_Working.packet, m_Working.stamps);
+                    updated = true;
                 }
             }
             m_ProvidersLock.unlock();
+
+            if (updated) {
+                m_Published.Write(m_Working);
+                m_Flags.set(PACKET_UPDATED_FLAG);
+            }
+            SensorProfiler.StopTimer();
             this->IncCount(); // Increments the count of the watchdog
-            ThisThread::sleep_for(m_PollInterval);
         }
     }
 
+    void SensorReader::OnProviderUpdate() {
+        m_Flags.set(PROVIDER_UPDATE_FLAG);
+    }
+
+    bool SensorReader::WaitForUpdate(std::chrono::milliseconds timeout) {
+        return !(m_Flags.wait_any_for(PACKET_UPDATED_FLAG, timeout) & osFlagsError);
+    }
+
     void SensorReader::RegisterProvider(ISensorProvider* provider) {
         m_ProvidersLock.lock();
         m_Providers.push_back(provider);
         m_ProvidersLock.unlock();
+#ifdef SENSOR_EVENT_DRIVEN
+        provider->AttachUpdateNotifier(callback(this, &SensorReader::OnProviderUpdate));
+#endif
     }
 
     void SensorReader::RemoveProvider(ISensorProvider* provider) {
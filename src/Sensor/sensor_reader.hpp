@@ -12,12 +12,32 @@
 #include "tai_gokart_packet/gkc_packets.hpp"
 #include "Watchdog/watchable.hpp"
 #include "Tools/logger.hpp"
+#include "Tools/seqlock.hpp"
 #include <chrono>
 #include <cstdint>
 #include <vector>
 
 namespace tritonai::gkc {
 
+    /**
+    * @brief Capture time of each sensor field, see Tools/timestamp.hpp
+    *
+    * A value of 0 means the field has never been captured.
+    */
+    struct SensorTimestamps {
+        uint32_t steeringAngleUs{0};
+        uint32_t wheelSpeedUs{0};
+        uint32_t brakePressureUs{0};
+    };
+
+    /**
+    * @brief Sensor packet together with the capture time of its fields
+    */
+    struct SensorSnapshot {
+        SensorGkcPacket packet{};
+        SensorTimestamps stamps{};
+    };
+
     /**
     * @brief Interface for sensor data providers
     */
@@ -34,8 +54,23 @@ namespace tritonai::gkc {
         /**
         * @brief Populates the sensor packet with readings
         * @param pkt Packet to populate with data
+        * @param stamps Capture time of every field written to pkt
+        */
+        virtual void PopulateReading(SensorGkcPacket& pkt, SensorTimestamps& stamps) = 0;
+
+        /**
+        * @brief Register a callback to invoke when new data arrives
+        *
+        * Providers that push updates (e.g. on CAN frame arrival) call notify from
+        * their own thread; polled providers can ignore it.
+        */
+        virtual void AttachUpdateNotifier([[maybe_unused]] Callback<void()> notify) {}
+
+        /**
+        * @brief Check and clear the pending pushed-update flag
+        * @return True if new data arrived since the last call
         */
-        virtual void PopulateReading(SensorGkcPacket& pkt) = 0;
+        virtual bool TakeUpdate() { return false; }
     };
 
     /**
@@ -63,11 +98,32 @@ namespace tritonai::gkc {
         
         /**
         * @brief Get the current sensor packet
-        * @return Reference to the latest sensor readings
+        * @return Copy of the latest sensor readings, never half-updated
         */
-        const SensorGkcPacket& GetPacket() const { 
-            return m_Packet; 
+        SensorGkcPacket GetPacket() const { 
+            return m_Published.Read().packet; 
         }
+
+        /**
+        * @brief Get the capture time of each field of the current sensor packet
+        */
+        SensorTimestamps GetTimestamps() const {
+            return m_Published.Read().stamps;
+        }
+
+        /**
+        * @brief Get the current sensor packet and its timestamps in one consistent copy
+        */
+        SensorSnapshot GetSnapshot() const {
+            return m_Published.Read();
+        }
+
+        /**
+        * @brief Block until the sensor packet is updated
+        * @param timeout Max time to wait
+        * @return True if the packet was updated, false on timeout
+        */
+        bool WaitForUpdate(std::chrono::milliseconds timeout);
         
         /**
         * @brief Set the polling interval
@@ -92,13 +148,20 @@ namespace tritonai::gkc {
 
     protected:
         ILogger* m_Logger;
-        SensorGkcPacket m_Packet{};
+        // Working copy, only touched by the poll thread; readers see m_Published
+        SensorSnapshot m_Working{};
+        Seqlock<SensorSnapshot> m_Published;
         std::vector<ISensorProvider*> m_Providers{};
         Mutex m_ProvidersLock;
         std::chrono::milliseconds m_PollInterval{SEND_SENSOR_INTERVAL_MS};
 
+        static constexpr uint32_t PROVIDER_UPDATE_FLAG = 1 << 0;
+        static constexpr uint32_t PACKET_UPDATED_FLAG = 1 << 1;
+        EventFlags m_Flags;
+
         Thread m_SensorPollThread{osPriorityNormal, OS_STACK_SIZE, nullptr, "sensor_poll_thread"};
         void SensorPollThreadImpl();
+        void OnProviderUpdate();
     };
 
 } // namespace tritonai::gkc
\ No newline at end of file
@@ -0,0 +1,67 @@
+/**
+ * @file binary_log.cpp
+ * @brief Binary log ring and record formatting
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#include "Tools/binary_log.hpp"
+
+#include <cstdio>
+
+namespace tritonai::gkc {
+
+    BinaryLog g_BinaryLog;
+
+    size_t FormatLogRecord(const LogRecord& record, char* out, size_t size) {
+        if (size == 0) {
+            return 0;
+        }
+        const char* format = LOG_FORMATS[static_cast<size_t>(record.formatId)].format;
+        size_t len = 0;
+        size_t argIndex = 0;
+
+        for (size_t i = 0; format[i] != '\0' && len + 1 < size; i++) {
+            if (format[i] != '%') {
+                out[len++] = format[i];
+                continue;
+            }
+            if (format[i + 1] == '%') {
+                out[len++] = '%';
+                i++;
+                continue;
+            }
+
+            // Copy one conversion spec and print its argument with snprintf
+            char spec[16];
+            size_t specLen = 0;
+            spec[specLen++] = format[i++];
+            while (log_format::IsFlagOrWidth(format[i]) && specLen + 2 < sizeof(spec)) {
+                spec[specLen++] = format[i++];
+            }
+            const char conversion = format[i];
+            spec[specLen++] = conversion;
+            spec[specLen] = '\0';
+
+            const uint32_t arg = argIndex < record.argCount ? record.args[argIndex] : 0;
+            argIndex++;
+            int written;
+            if (log_format::IsFloatConversion(conversion)) {
+                float value;
+                memcpy(&value, &arg, sizeof(value));
+                written = snprintf(out + len, size - len, spec, static_cast<double>(value));
+            } else if (conversion == 'd' || conversion == 'i') {
+                written = snprintf(out + len, size - len, spec, static_cast<int>(static_cast<int32_t>(arg)));
+            } else {
+                written = snprintf(out + len, size - len, spec, static_cast<unsigned int>(arg));
+            }
+            if (written > 0) {
+                len += static_cast<size_t>(written) < size - len ? static_cast<size_t>(written) : size - len - 1;
+            }
+        }
+
+        out[len] = '\0';
+        return len;
+    }
+
+} // namespace tritonai::gkc
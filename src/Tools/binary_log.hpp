@@ -0,0 +1,222 @@
+/**
+ * @file binary_log.hpp
+ * @brief Deferred binary logging with interned format strings
+ *
+ * A call site records a compile-time format ID (log_formats.hpp), a timestamp
+ * and its raw arguments into a lock-free ring. Formatting happens later, in
+ * the controller's low-priority log thread for the console and on the host
+ * for the GKC_ID_BINARY_LOG packets (log_decode.py).
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#include "config.hpp"
+#include "tai_gokart_packet/gkc_packets.hpp"
+#include "Tools/log_formats.hpp"
+#include "Tools/mpsc_ring.hpp"
+#include "Tools/timestamp.hpp"
+
+namespace tritonai::gkc {
+
+    enum class LogFormatId : uint16_t {
+#define GKC_LOG_FORMAT_ID(name, severity, format) name,
+        GKC_LOG_FORMATS(GKC_LOG_FORMAT_ID)
+#undef GKC_LOG_FORMAT_ID
+        COUNT
+    };
+
+    struct LogFormat {
+        LogPacket::Severity severity;
+        const char* format;
+    };
+
+    inline constexpr LogFormat LOG_FORMATS[] = {
+#define GKC_LOG_FORMAT_ENTRY(name, severity, format) {LogPacket::Severity::severity, format},
+        GKC_LOG_FORMATS(GKC_LOG_FORMAT_ENTRY)
+#undef GKC_LOG_FORMAT_ENTRY
+    };
+
+    constexpr size_t LOG_RECORD_MAX_ARGS = 6;
+
+    /**
+     * @brief One deferred log call, arguments are integers or float bit patterns
+     */
+    struct LogRecord {
+        uint32_t stampUs;
+        LogFormatId formatId;
+        uint8_t argCount;
+        uint32_t args[LOG_RECORD_MAX_ARGS];
+    };
+
+    // Compile-time inspection of the format strings
+    namespace log_format {
+
+        constexpr bool IsFlagOrWidth(char c) {
+            return c == '-' || c == '+' || c == ' ' || c == '#' || c == '.' || (c >= '0' && c <= '9');
+        }
+
+        constexpr bool IsIntConversion(char c) {
+            return c == 'd' || c == 'i' || c == 'u' || c == 'x' || c == 'X' || c == 'c';
+        }
+
+        constexpr bool IsFloatConversion(char c) {
+            return c == 'f' || c == 'e' || c == 'g';
+        }
+
+        /**
+         * @brief Conversion character of the index-th argument, '\0' past the last one
+         *
+         * Returns '?' for an unsupported conversion so it fails the type check.
+         */
+        constexpr char GetConversion(const char* format, size_t index) {
+            size_t found = 0;
+            for (size_t i = 0; format[i] != '\0'; i++) {
+                if (format[i] != '%') {
+                    continue;
+                }
+                i++;
+                if (format[i] == '%') {
+                    continue;
+                }
+                while (IsFlagOrWidth(format[i])) {
+                    i++;
+                }
+                const char conversion = format[i];
+                if (!IsIntConversion(conversion) && !IsFloatConversion(conversion)) {
+                    return '?';
+                }
+                if (found++ == index) {
+                    return conversion;
+                }
+            }
+            return '\0';
+        }
+
+        constexpr size_t CountConversions(const char* format) {
+            size_t count = 0;
+            while (GetConversion(format, count) != '\0' && GetConversion(format, count) != '?') {
+                count++;
+            }
+            return count;
+        }
+
+        template <typename Arg>
+        constexpr bool MatchesConversion(char conversion) {
+            if constexpr (std::is_floating_point_v<Arg>) {
+                return IsFloatConversion(conversion);
+            } else {
+                return (std::is_integral_v<Arg> || std::is_enum_v<Arg>) && sizeof(Arg) <= sizeof(uint32_t) &&
+                       IsIntConversion(conversion);
+            }
+        }
+
+        // format goes unread for a call without arguments, the fold is then just true
+        template <typename... Args, size_t... Index>
+        constexpr bool MatchesFormat([[maybe_unused]] const char* format, std::index_sequence<Index...>) {
+            return (MatchesConversion<Args>(GetConversion(format, Index)) && ...);
+        }
+
+    } // namespace log_format
+
+    /**
+     * @brief Process-wide binary log ring
+     *
+     * Threading: Record from any thread, not from interrupt context (it may
+     * spin briefly against another producer). Pop from a single consumer.
+     */
+    class BinaryLog {
+    public:
+        /**
+         * @brief Record one log call, checked against its format at compile time
+         *
+         * Costs a severity check, a timer read and a ring push. Nothing is
+         * allocated or formatted; a full ring drops the record and counts it.
+         */
+        template <LogFormatId Id, typename... Args>
+        void Record(Args... args) {
+            constexpr LogFormat format = LOG_FORMATS[static_cast<size_t>(Id)];
+            static_assert(sizeof...(Args) <= LOG_RECORD_MAX_ARGS, "Too many log arguments");
+            static_assert(sizeof...(Args) == log_format::CountConversions(format.format),
+                          "Log argument count does not match the format");
+            static_assert(log_format::MatchesFormat<Args...>(format.format, std::index_sequence_for<Args...>{}),
+                          "Log argument types do not match the format conversions");
+
+            if (format.severity < m_MinSeverity.load(std::memory_order_relaxed)) {
+                return;
+            }
+
+            LogRecord record;
+            record.stampUs = GetTimestampUs();
+            record.formatId = Id;
+            record.argCount = sizeof...(Args);
+            size_t index = 0;
+            ((record.args[index++] = EncodeArg(args)), ...);
+
+            if (!m_Ring.Push(record)) {
+                m_Dropped.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        bool Pop(LogRecord& record) { return m_Ring.Pop(record); }
+
+        /**
+         * @brief Records dropped on a full ring since the last call
+         */
+        uint32_t TakeDropped() { return m_Dropped.exchange(0, std::memory_order_relaxed); }
+
+        void SetMinSeverity(LogPacket::Severity severity) {
+            m_MinSeverity.store(severity, std::memory_order_relaxed);
+        }
+
+        LogPacket::Severity GetMinSeverity() const { return m_MinSeverity.load(std::memory_order_relaxed); }
+
+    private:
+        template <typename Arg>
+        static uint32_t EncodeArg(Arg arg) {
+            if constexpr (std::is_floating_point_v<Arg>) {
+                const float value = static_cast<float>(arg);
+                uint32_t bits;
+                memcpy(&bits, &value, sizeof(bits));
+                return bits;
+            } else {
+                // Signed values keep their two's complement bits
+                return static_cast<uint32_t>(arg);
+            }
+        }
+
+        MpscRing<LogRecord, BINARY_LOG_RING_SIZE> m_Ring;
+        std::atomic<uint32_t> m_Dropped{0};
+        std::atomic<LogPacket::Severity> m_MinSeverity{BINARY_LOG_MIN_SEVERITY};
+    };
+
+    extern BinaryLog g_BinaryLog;
+
+    /**
+     * @brief Get the severity of a record's format
+     */
+    inline LogPacket::Severity GetLogSeverity(const LogRecord& record) {
+        return LOG_FORMATS[static_cast<size_t>(record.formatId)].severity;
+    }
+
+    /**
+     * @brief Format a record into text like printf would
+     * @return Length written, without the terminator (out is always terminated)
+     */
+    size_t FormatLogRecord(const LogRecord& record, char* out, size_t size);
+
+} // namespace tritonai::gkc
+
+/**
+ * @brief Record a binary log call: GKC_LOG(NAME, args...) with NAME from log_formats.hpp
+ */
+#define GKC_LOG(name, ...) \
+    ::tritonai::gkc::g_BinaryLog.Record<::tritonai::gkc::LogFormatId::name>(__VA_ARGS__)
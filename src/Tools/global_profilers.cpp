@@ -0,0 +1,26 @@
+/**
+ * @file global_profilers.cpp
+ * @brief Global profiler instances
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#include "Tools/global_profilers.hpp"
+
+namespace tritonai::gkc {
+
+    Profiler CommProfiler("Comm");
+    Profiler CommSendProfiler("CommSend");
+    Profiler ControlProfiler("Control");
+    Profiler SensorProfiler("Sensor");
+    Profiler CanProfiler("Can");
+
+    Profiler* const GlobalProfilers[GLOBAL_PROFILER_COUNT] = {
+        &CommProfiler,
+        &CommSendProfiler,
+        &ControlProfiler,
+        &SensorProfiler,
+        &CanProfiler,
+    };
+
+} // namespace tritonai::gkc
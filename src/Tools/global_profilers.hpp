@@ -11,9 +11,15 @@
 
 namespace tritonai::gkc {
 
-    // Defines global profilers for each section of the code
-    Profiler CommProfiler("Comm");
-    Profiler ControlProfiler("Control");
-    Profiler SensorProfiler("Sensor");
+    // Global profilers for each section of the code, defined in global_profilers.cpp
+    extern Profiler CommProfiler;       // parsing and dispatching received bytes
+    extern Profiler CommSendProfiler;   // encoding and queueing one outbound packet
+    extern Profiler ControlProfiler;    // one control loop step
+    extern Profiler SensorProfiler;     // one sensor poll pass
+    extern Profiler CanProfiler;        // decoding one received CAN frame
 
-} // namespace tritonai::gkc
\ No newline at end of file
+    // All of the above, in the order of GKC_ID_PROFILER_REPORT probe indices
+    constexpr size_t GLOBAL_PROFILER_COUNT = 5;
+    extern Profiler* const GlobalProfilers[GLOBAL_PROFILER_COUNT];
+
+} // namespace tritonai::gkc
@@ -0,0 +1,32 @@
+/**
+ * @file log_formats.hpp
+ * @brief Interned format strings of the binary log
+ *
+ * Each entry is X(NAME, SEVERITY, "format"). The position in the table is the
+ * format ID sent on the wire, so entries are only ever appended, and
+ * log_decode.py reads this file to decode the IDs on the host.
+ *
+ * Formats take printf conversions d i u x X c for integer arguments and f e g
+ * for float arguments, optionally with flags, width and precision but no
+ * length modifiers. Use %% for a literal percent sign.
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#pragma once
+
+#define GKC_LOG_FORMATS(X) \
+    X(HEARTBEAT_RECEIVED,       DEBUG,   "HeartbeatGkcPacket received") \
+    X(CONTROL_RECEIVED,         DEBUG,   "ControlGkcPacket received: throttle %.2f, steering %.2f, brake %.2f") \
+    X(CONTROL_NOT_ACTIVE,       INFO,    "Controller is not active, ignoring ControlGkcPacket") \
+    X(CONTROL_RC_COMMANDING,    WARNING, "RC is commanding, ignoring ControlGkcPacket") \
+    X(RC_UNINITIALIZED,         WARNING, "Controller is uninitialized, ignoring RCControlGkcPacket") \
+    X(RC_INACTIVE_HOLD,         INFO,    "RC not active while Inactive, holding brake %.2f") \
+    X(RC_AUTONOMOUS,            DEBUG,   "RCControlGkcPacket is in autonomous mode, ignoring") \
+    X(RC_RECEIVED,              INFO,    "RCControlGkcPacket received: throttle %d%%, steering %d%%, brake %d%%, " \
+                                         "autonomy_mode %u, is_active %u") \
+    X(SENSOR_SENT,              DEBUG,   "Sensor packet - Steering: %f rad, Speed: %f m/s, Brake Pressure: %f PSI") \
+    X(BRAKE_PRESSURE_READ,      DEBUG,   "Brake pressure: %d PSI (Raw: %f)") \
+    X(CAN_STEERING_MISSING,     WARNING, "CAN steering angle feedback not available - setting to 0") \
+    X(CAN_SPEED_MISSING,        WARNING, "CAN speed feedback not available - setting all wheel speeds to 0") \
+    X(SERIAL_NOT_WRITABLE,      ERROR,   "Serial not writable")
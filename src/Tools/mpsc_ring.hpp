@@ -0,0 +1,94 @@
+/**
+ * @file mpsc_ring.hpp
+ * @brief Lock-free multi-producer/single-consumer ring buffer
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace tritonai::gkc {
+
+    /**
+    * @brief Fixed-capacity lock-free ring shared by any number of producers and one consumer
+    *
+    * Bounded queue after D. Vyukov: every cell carries a sequence number that
+    * tells producers whether it is free and the consumer whether it is published.
+    * Producers claim a slot with one compare-exchange and never wait on each other.
+    * A producer preempted between claiming and publishing holds back the consumer
+    * until it resumes, but not the other producers.
+    *
+    * @tparam T Element type, copied in and out
+    * @tparam N Capacity, must be a power of two
+    */
+    template <typename T, size_t N>
+    class MpscRing {
+        static_assert(N > 0 && (N & (N - 1)) == 0, "MpscRing capacity must be a power of two");
+
+    public:
+        MpscRing() {
+            for (size_t i = 0; i < N; i++) {
+                m_Cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        /**
+        * @brief Append one element (any producer)
+        * @return False if the ring is full and the element was dropped
+        */
+        bool Push(const T& item) {
+            size_t head = m_Head.load(std::memory_order_relaxed);
+            while (true) {
+                Cell& cell = m_Cells[head & (N - 1)];
+                const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+                const ptrdiff_t diff = static_cast<ptrdiff_t>(sequence - head);
+                if (diff == 0) {
+                    // Free for this lap, claim it (head is reloaded on failure)
+                    if (m_Head.compare_exchange_weak(head, head + 1, std::memory_order_relaxed)) {
+                        cell.data = item;
+                        cell.sequence.store(head + 1, std::memory_order_release);
+                        return true;
+                    }
+                } else if (diff < 0) {
+                    // Still holds the element of the previous lap
+                    return false;
+                } else {
+                    head = m_Head.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /**
+        * @brief Remove the oldest published element (consumer side)
+        * @return False if the ring is empty or the oldest slot is not published yet
+        */
+        bool Pop(T& item) {
+            const size_t tail = m_Tail.load(std::memory_order_relaxed);
+            Cell& cell = m_Cells[tail & (N - 1)];
+            if (cell.sequence.load(std::memory_order_acquire) != tail + 1) {
+                return false;
+            }
+            item = cell.data;
+            cell.sequence.store(tail + N, std::memory_order_release);
+            m_Tail.store(tail + 1, std::memory_order_relaxed);
+            return true;
+        }
+
+        static constexpr size_t Capacity() { return N; }
+
+    private:
+        struct Cell {
+            std::atomic<size_t> sequence;
+            T data;
+        };
+
+        Cell m_Cells[N];
+        std::atomic<size_t> m_Head{0}; // next slot to claim, shared by the producers
+        std::atomic<size_t> m_Tail{0}; // only written by the consumer
+    };
+
+} // namespace tritonai::gkc
@@ -1,26 +1,136 @@
 /**
  * @file profiler.hpp
  * @brief Performance profiling functionality
- * 
+ *
  * @copyright Copyright 2025 Triton AI
  */
 
 #pragma once
 
+#include <atomic>
 #include <chrono>
 #include <cstdint>
-#include <iostream>
 #include <mbed.h>
 #include <sstream>
 #include <string>
-#include <vector>
 
-#define AVERAGE_WINDOW_SIZE 10
+#include "config.hpp"
 
 namespace tritonai::gkc {
 
+#ifdef DWT
+    /**
+    * @brief Start the core cycle counter, the profiler clock on the board
+    */
+    inline void EnableProfilerClock() {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+#if defined(__CORTEX_M) && (__CORTEX_M == 7U)
+        DWT->LAR = 0xC5ACCE55; // Cortex-M7 locks the DWT registers after reset
+#endif
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+
+    /**
+    * @brief Free-running profiler clock, CPU cycles on the board
+    */
+    inline uint32_t GetProfilerTicks() {
+        return DWT->CYCCNT;
+    }
+
+    inline uint32_t GetProfilerTickRate() {
+        return SystemCoreClock;
+    }
+#else
+    inline void EnableProfilerClock() {}
+
+    /**
+    * @brief Free-running profiler clock, nanoseconds on the host
+    */
+    inline uint32_t GetProfilerTicks() {
+        return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    inline uint32_t GetProfilerTickRate() {
+        return 1000000000;
+    }
+#endif
+
+    /**
+    * @brief Log-linear latency histogram layout
+    *
+    * Values below 2^PROFILER_SUB_BUCKET_BITS ticks have a bucket each, every
+    * octave above is split into 2^PROFILER_SUB_BUCKET_BITS buckets. A bucket
+    * is at most 1/2^PROFILER_SUB_BUCKET_BITS of its lower bound wide.
+    */
+    struct ProfilerHistogram {
+        static constexpr uint32_t SUB_BITS = PROFILER_SUB_BUCKET_BITS;
+        static constexpr uint32_t SUB_COUNT = 1u << SUB_BITS;
+        static constexpr size_t BUCKET_COUNT = (32 - SUB_BITS + 1) * SUB_COUNT;
+
+        static uint32_t GetBucket(uint32_t ticks) {
+            if (ticks < SUB_COUNT) {
+                return ticks;
+            }
+            const uint32_t msb = 31 - __builtin_clz(ticks);
+            return ((msb - SUB_BITS + 1) << SUB_BITS) + ((ticks >> (msb - SUB_BITS)) & (SUB_COUNT - 1));
+        }
+
+        static uint32_t GetLowerBound(uint32_t bucket) {
+            if (bucket < SUB_COUNT) {
+                return bucket;
+            }
+            return (SUB_COUNT + (bucket & (SUB_COUNT - 1))) << ((bucket >> SUB_BITS) - 1);
+        }
+
+        static uint32_t GetWidth(uint32_t bucket) {
+            return bucket < 2 * SUB_COUNT ? 1 : 1u << ((bucket >> SUB_BITS) - 1);
+        }
+    };
+
+    /**
+    * @brief Copy of a profiler's histogram
+    */
+    struct ProfilerSnapshot {
+        uint32_t count{0};
+        uint32_t maxTicks{0};
+        uint32_t buckets[ProfilerHistogram::BUCKET_COUNT]{};
+
+        /**
+        * @brief Middle of the bucket holding the given fraction of samples, capped by the maximum
+        * @return Ticks, 0 without samples
+        */
+        uint32_t GetPercentileTicks(float fraction) const {
+            if (count == 0) {
+                return 0;
+            }
+            const uint32_t rank = static_cast<uint32_t>(fraction * (count - 1)) + 1;
+            uint32_t seen = 0;
+            for (uint32_t i = 0; i < ProfilerHistogram::BUCKET_COUNT; i++) {
+                seen += buckets[i];
+                if (seen >= rank) {
+                    const uint32_t middle = ProfilerHistogram::GetLowerBound(i) + ProfilerHistogram::GetWidth(i) / 2;
+                    return middle < maxTicks ? middle : maxTicks;
+                }
+            }
+            return maxTicks;
+        }
+    };
+
+    /**
+    * @brief Convert profiler ticks to microseconds
+    */
+    inline std::chrono::microseconds ProfilerTicksToUs(uint32_t ticks) {
+        return std::chrono::microseconds(static_cast<uint64_t>(ticks) * 1000000 / GetProfilerTickRate());
+    }
+
     /**
     * @brief Provides functionality for profiling code performance
+    *
+    * Durations are recorded into a fixed histogram with relaxed atomics, so a
+    * profiler can be shared by several threads and interrupts, never allocates
+    * and costs a few dozen cycles per sample. Measure a scope with
+    * ScopedProfile, or a span with StartTimer and StopTimer from one thread.
     */
     class Profiler {
     public:
@@ -28,15 +138,16 @@ namespace tritonai::gkc {
         * @brief Construct a new Profiler object
         * @param name Name of the section being profiled
         */
-        Profiler(const char* name) : m_Name(name) {}
+        Profiler(const char* name) : m_Name(name) {
+            EnableProfilerClock();
+        }
 
         /**
         * @brief Start the timer
         */
         void StartTimer() {
             if (!m_Profiling) {
-                m_Timer.reset();
-                m_Timer.start();
+                m_StartTicks = GetProfilerTicks();
                 m_Profiling = true;
             }
         }
@@ -45,40 +156,53 @@ namespace tritonai::gkc {
         * @brief Stop the timer
         */
         void StopTimer() {
-            m_Timer.stop();
-            m_Profiling = false;
-            if (m_Buffer.size() == AVERAGE_WINDOW_SIZE) {
-                m_Buffer.erase(m_Buffer.begin());
+            if (m_Profiling) {
+                m_Profiling = false;
+                Record(GetProfilerTicks() - m_StartTicks);
             }
-            m_Buffer.push_back(m_Timer.elapsed_time());
         }
 
         /**
-        * @brief Get the last recorded time
-        * @return Last time measurement
+        * @brief Add one duration to the histogram
         */
-        std::chrono::microseconds GetLastTime() const { 
-            return m_Buffer.back(); 
+        void Record(uint32_t ticks) {
+            m_Buckets[ProfilerHistogram::GetBucket(ticks)].fetch_add(1, std::memory_order_relaxed);
+            m_Count.fetch_add(1, std::memory_order_relaxed);
+            m_LastTicks.store(ticks, std::memory_order_relaxed);
+            uint32_t max = m_MaxTicks.load(std::memory_order_relaxed);
+            while (ticks > max && !m_MaxTicks.compare_exchange_weak(max, ticks, std::memory_order_relaxed)) {
+            }
         }
 
         /**
-        * @brief Get the average recorded time
-        * @return Average time measurement
+        * @brief Copy the histogram
+        * @param reset Start a new histogram, samples recorded meanwhile may land in either
         */
-        std::chrono::microseconds GetAverageTime() const {
-            std::chrono::microseconds total(0);
-            for (const auto& time : m_Buffer) {
-                total += time;
+        void GetSnapshot(ProfilerSnapshot& snapshot, bool reset = false) {
+            for (size_t i = 0; i < ProfilerHistogram::BUCKET_COUNT; i++) {
+                snapshot.buckets[i] = reset ? m_Buckets[i].exchange(0, std::memory_order_relaxed)
+                                            : m_Buckets[i].load(std::memory_order_relaxed);
             }
-            return total / m_Buffer.size();
+            snapshot.count = reset ? m_Count.exchange(0, std::memory_order_relaxed)
+                                   : m_Count.load(std::memory_order_relaxed);
+            snapshot.maxTicks = reset ? m_MaxTicks.exchange(0, std::memory_order_relaxed)
+                                      : m_MaxTicks.load(std::memory_order_relaxed);
+        }
+
+        /**
+        * @brief Get the last recorded time
+        * @return Last time measurement, 0 before the first one
+        */
+        std::chrono::microseconds GetLastTime() const {
+            return ProfilerTicksToUs(m_LastTicks.load(std::memory_order_relaxed));
         }
 
         /**
         * @brief Get the name of this profiler
         * @return Name string
         */
-        std::string GetName() const { 
-            return m_Name; 
+        const char* GetName() const {
+            return m_Name;
         }
 
         /**
@@ -86,20 +210,43 @@ namespace tritonai::gkc {
         * @param newline Whether to add a newline character
         * @return Formatted string with profiler info
         */
-        std::string Dump(const bool& newline = true) const {
+        std::string Dump(const bool& newline = true) {
+            ProfilerSnapshot snapshot;
+            GetSnapshot(snapshot);
             std::stringstream ss;
             ss << "[Profiler " << GetName()
-            << "]: last_time (us): " << GetLastTime().count()
-            << ", ave_time (us): " << GetAverageTime().count()
+            << "]: count: " << snapshot.count
+            << ", p50 (us): " << ProfilerTicksToUs(snapshot.GetPercentileTicks(0.5f)).count()
+            << ", p99 (us): " << ProfilerTicksToUs(snapshot.GetPercentileTicks(0.99f)).count()
+            << ", max (us): " << ProfilerTicksToUs(snapshot.maxTicks).count()
             << (newline ? "\n" : "\r");
             return ss.str();
         }
 
     protected:
-        Timer m_Timer;
-        std::vector<std::chrono::microseconds> m_Buffer;
-        std::string m_Name;
+        const char* m_Name;
+        std::atomic<uint32_t> m_Buckets[ProfilerHistogram::BUCKET_COUNT]{};
+        std::atomic<uint32_t> m_Count{0};
+        std::atomic<uint32_t> m_MaxTicks{0};
+        std::atomic<uint32_t> m_LastTicks{0};
+        uint32_t m_StartTicks{0};
         bool m_Profiling{false};
     };
 
-} // namespace tritonai::gkc
\ No newline at end of file
+    /**
+    * @brief Records the lifetime of a scope into a profiler
+    */
+    class ScopedProfile {
+    public:
+        explicit ScopedProfile(Profiler& profiler) : m_Profiler(profiler), m_StartTicks(GetProfilerTicks()) {}
+        ~ScopedProfile() { m_Profiler.Record(GetProfilerTicks() - m_StartTicks); }
+
+        ScopedProfile(const ScopedProfile&) = delete;
+        ScopedProfile& operator=(const ScopedProfile&) = delete;
+
+    private:
+        Profiler& m_Profiler;
+        const uint32_t m_StartTicks;
+    };
+
+} // namespace tritonai::gkc
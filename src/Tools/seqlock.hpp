@@ -0,0 +1,78 @@
+/**
+ * @file seqlock.hpp
+ * @brief Lock-free single-writer publication of a value to many readers
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace tritonai::gkc {
+
+    /**
+    * @brief Sequence-counted value with two copies, readers always get a consistent snapshot
+    *
+    * The writer updates the copies one at a time and bumps the sequence before
+    * each, so the parity of the sequence tells readers which copy is currently
+    * stable. A reader that preempts a half-finished Write therefore reads the
+    * other, complete copy instead of spinning on a writer that cannot run until
+    * the reader yields. A reader only retries when a Write completes while it is
+    * copying, which on a single core needs the reader to be the lower priority
+    * thread and costs one extra copy.
+    *
+    * Neither side ever blocks or takes a lock; Read is a copy of T plus two
+    * atomic loads.
+    *
+    * Threading: exactly one writer thread; any number of readers in threads or ISRs.
+    *
+    * @tparam T Value type, must be copy-assignable
+    */
+    template <typename T>
+    class Seqlock {
+    public:
+        /**
+        * @brief Publish a new value (writer side)
+        */
+        void Write(const T& value) {
+            const uint32_t seq = m_Seq.load(std::memory_order_relaxed);
+
+            // Odd: readers use copy 1 while copy 0 is rewritten
+            m_Seq.store(seq + 1, std::memory_order_release);
+            std::atomic_thread_fence(std::memory_order_release);
+            m_Copies[0] = value;
+
+            // Even: readers use copy 0 while copy 1 is rewritten
+            m_Seq.store(seq + 2, std::memory_order_release);
+            m_Copies[1] = value;
+        }
+
+        /**
+        * @brief Take a consistent snapshot of the latest value (reader side)
+        */
+        T Read() const {
+            T snapshot;
+            uint32_t seq;
+            do {
+                seq = m_Seq.load(std::memory_order_acquire);
+                snapshot = m_Copies[seq & 1];
+                std::atomic_thread_fence(std::memory_order_acquire);
+            } while (m_Seq.load(std::memory_order_relaxed) != seq);
+            return snapshot;
+        }
+
+        /**
+        * @brief Number of completed writes
+        */
+        uint32_t GetVersion() const {
+            return m_Seq.load(std::memory_order_acquire) / 2;
+        }
+
+    private:
+        std::atomic<uint32_t> m_Seq{0};
+        T m_Copies[2]{};
+    };
+
+} // namespace tritonai::gkc
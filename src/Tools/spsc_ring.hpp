@@ -0,0 +1,108 @@
+/**
+ * @file spsc_ring.hpp
+ * @brief Lock-free single-producer/single-consumer ring buffer
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace tritonai::gkc {
+
+    /**
+    * @brief Fixed-capacity lock-free ring shared by exactly one producer and one consumer
+    *
+    * Either side may run in interrupt context. The consumer can borrow contiguous
+    * spans of the storage (PeekContiguous/Consume) so bulk data never needs copying out.
+    *
+    * @tparam T Element type
+    * @tparam N Capacity, must be a power of two
+    */
+    template <typename T, size_t N>
+    class SpscRing {
+        static_assert(N > 0 && (N & (N - 1)) == 0, "SpscRing capacity must be a power of two");
+
+    public:
+        /**
+        * @brief Append one element (producer side)
+        * @return False if the ring is full and the element was dropped
+        */
+        bool Push(const T& item) {
+            const size_t head = m_Head.load(std::memory_order_relaxed);
+            if (head - m_Tail.load(std::memory_order_acquire) >= N) {
+                return false;
+            }
+            m_Data[head & (N - 1)] = item;
+            m_Head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+        * @brief Append as many elements as fit (producer side)
+        * @return Number of elements written
+        */
+        size_t Write(const T* data, size_t len) {
+            const size_t head = m_Head.load(std::memory_order_relaxed);
+            const size_t space = N - (head - m_Tail.load(std::memory_order_acquire));
+            const size_t count = len < space ? len : space;
+            for (size_t i = 0; i < count; i++) {
+                m_Data[(head + i) & (N - 1)] = data[i];
+            }
+            m_Head.store(head + count, std::memory_order_release);
+            return count;
+        }
+
+        /**
+        * @brief Remove one element (consumer side)
+        * @return False if the ring is empty
+        */
+        bool Pop(T& item) {
+            const size_t tail = m_Tail.load(std::memory_order_relaxed);
+            if (tail == m_Head.load(std::memory_order_acquire)) {
+                return false;
+            }
+            item = m_Data[tail & (N - 1)];
+            m_Tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+        * @brief Borrow the longest contiguous run of readable elements (consumer side)
+        * @param data Set to the first readable element
+        * @return Number of elements available at data, 0 if empty
+        */
+        size_t PeekContiguous(T*& data) {
+            const size_t tail = m_Tail.load(std::memory_order_relaxed);
+            const size_t available = m_Head.load(std::memory_order_acquire) - tail;
+            const size_t offset = tail & (N - 1);
+            const size_t untilWrap = N - offset;
+            data = &m_Data[offset];
+            return available < untilWrap ? available : untilWrap;
+        }
+
+        /**
+        * @brief Release elements previously borrowed with PeekContiguous (consumer side)
+        */
+        void Consume(size_t count) {
+            m_Tail.store(m_Tail.load(std::memory_order_relaxed) + count, std::memory_order_release);
+        }
+
+        size_t Size() const {
+            return m_Head.load(std::memory_order_acquire) - m_Tail.load(std::memory_order_acquire);
+        }
+
+        size_t Space() const { return N - Size(); }
+        bool IsEmpty() const { return Size() == 0; }
+        static constexpr size_t Capacity() { return N; }
+
+    private:
+        T m_Data[N];
+        std::atomic<size_t> m_Head{0}; // only written by the producer
+        std::atomic<size_t> m_Tail{0}; // only written by the consumer
+    };
+
+} // namespace tritonai::gkc
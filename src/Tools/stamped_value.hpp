@@ -0,0 +1,59 @@
+/**
+ * @file stamped_value.hpp
+ * @brief Lock-free store of a timestamped, sequence-numbered value
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "Tools/seqlock.hpp"
+#include "Tools/timestamp.hpp"
+
+namespace tritonai::gkc {
+
+    /**
+    * @brief A value with its capture time and update count
+    */
+    template <typename T>
+    struct Stamped {
+        T value{};
+        uint32_t stampUs{0}; // capture time, see Tools/timestamp.hpp
+        uint32_t seq{0};     // number of updates so far, 0 if never updated
+
+        bool IsValid() const { return seq != 0; }
+
+        /**
+        * @brief Milliseconds since the value was captured
+        */
+        uint32_t GetAgeMs() const { return GetAgeUs(stampUs) / 1000; }
+
+        /**
+        * @brief True if the value was captured at most maxAgeMs ago
+        */
+        bool IsFresh(uint32_t maxAgeMs) const { return IsValid() && GetAgeMs() <= maxAgeMs; }
+    };
+
+    /**
+    * @brief Single-writer store readers can snapshot without locking
+    *
+    * Threading: Publish from exactly one thread, Read from anywhere.
+    */
+    template <typename T>
+    class StampedStore {
+    public:
+        void Publish(const T& value, uint32_t stampUs) {
+            m_Seq++;
+            m_Value.Write(Stamped<T>{value, stampUs, m_Seq});
+        }
+
+        Stamped<T> Read() const { return m_Value.Read(); }
+
+    private:
+        Seqlock<Stamped<T>> m_Value;
+        uint32_t m_Seq{0};
+    };
+
+} // namespace tritonai::gkc
@@ -0,0 +1,103 @@
+/**
+ * @file thread_monitor.cpp
+ * @brief Implementation of the thread monitor
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#include "Tools/thread_monitor.hpp"
+#include "Tools/timestamp.hpp"
+
+namespace tritonai::gkc {
+
+    ThreadMonitor g_ThreadMonitor;
+
+    void ThreadMonitor::Start() {
+        m_Sampler.attach(callback(this, &ThreadMonitor::Sample),
+                         std::chrono::microseconds(THREAD_MONITOR_SAMPLE_PERIOD_US));
+    }
+
+    void ThreadMonitor::Register(Thread& thread) {
+        m_RegisterLock.lock();
+        const size_t count = m_Count.load(std::memory_order_relaxed);
+        if (count < THREAD_MONITOR_MAX_THREADS) {
+            m_Entries[count].thread = &thread;
+            m_Entries[count].id = thread.get_id();
+            m_Count.store(count + 1, std::memory_order_release);
+        }
+        m_RegisterLock.unlock();
+    }
+
+    ThreadMonitor::Entry* ThreadMonitor::FindCurrent() {
+        const ThreadId current = ThisThread::get_id();
+        const size_t count = m_Count.load(std::memory_order_acquire);
+        for (size_t i = 0; i < count; i++) {
+            if (m_Entries[i].id == current) {
+                return &m_Entries[i];
+            }
+        }
+        return nullptr;
+    }
+
+    void ThreadMonitor::Sample() {
+        // Interrupt context, the current thread is the one that was interrupted
+        Entry* entry = FindCurrent();
+        if (entry != nullptr) {
+            entry->cpuSamples.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            m_OtherSamples.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void ThreadMonitor::RecordWake(uint32_t expectedUs) {
+        Entry* entry = FindCurrent();
+        if (entry == nullptr) {
+            return;
+        }
+        const uint32_t lateUs = GetTimestampUs() - expectedUs;
+        // A wake before the expected time (tick rounding) is not late
+        const uint32_t latencyUs = static_cast<int32_t>(lateUs) < 0 ? 0 : lateUs;
+
+        entry->wakeups.fetch_add(1, std::memory_order_relaxed);
+        entry->latencyCount.fetch_add(1, std::memory_order_relaxed);
+        entry->latencySumUs.fetch_add(latencyUs, std::memory_order_relaxed);
+        uint32_t max = entry->latencyMaxUs.load(std::memory_order_relaxed);
+        while (latencyUs > max &&
+               !entry->latencyMaxUs.compare_exchange_weak(max, latencyUs, std::memory_order_relaxed)) {
+        }
+    }
+
+    void ThreadMonitor::RecordWake() {
+        Entry* entry = FindCurrent();
+        if (entry != nullptr) {
+            entry->wakeups.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void ThreadMonitor::SleepFor(std::chrono::milliseconds duration) {
+        const uint32_t wakeUs = GetTimestampUs() + static_cast<uint32_t>(duration.count()) * 1000;
+        ThisThread::sleep_for(duration);
+        RecordWake(wakeUs);
+    }
+
+    size_t ThreadMonitor::TakeWindow(ThreadStats* out, size_t maxCount, uint32_t& otherSamples) {
+        const size_t count = m_Count.load(std::memory_order_acquire);
+        size_t written = 0;
+        for (size_t i = 0; i < count && written < maxCount; i++) {
+            Entry& entry = m_Entries[i];
+            ThreadStats& stats = out[written++];
+            stats.name = entry.thread->get_name();
+            stats.priority = entry.thread->get_priority();
+            stats.stackSize = entry.thread->stack_size();
+            stats.stackMaxUsed = entry.thread->max_stack();
+            stats.cpuSamples = entry.cpuSamples.exchange(0, std::memory_order_relaxed);
+            stats.wakeups = entry.wakeups.exchange(0, std::memory_order_relaxed);
+            stats.latencyCount = entry.latencyCount.exchange(0, std::memory_order_relaxed);
+            stats.latencySumUs = entry.latencySumUs.exchange(0, std::memory_order_relaxed);
+            stats.latencyMaxUs = entry.latencyMaxUs.exchange(0, std::memory_order_relaxed);
+        }
+        otherSamples = m_OtherSamples.exchange(0, std::memory_order_relaxed);
+        return written;
+    }
+
+} // namespace tritonai::gkc
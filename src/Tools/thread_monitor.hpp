@@ -0,0 +1,110 @@
+/**
+ * @file thread_monitor.hpp
+ * @brief Per-thread CPU share, stack high-water mark and wakeup latency
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "mbed.h"
+
+#include "config.hpp"
+
+namespace tritonai::gkc {
+
+    /**
+     * @brief Statistics of one thread over one report window
+     */
+    struct ThreadStats {
+        const char* name;
+        osPriority priority;
+        uint32_t stackSize;     // bytes
+        uint32_t stackMaxUsed;  // high-water mark in bytes, since the thread started
+        uint32_t cpuSamples;    // sampler ticks that found the thread running
+        uint32_t wakeups;
+        uint32_t latencyCount;  // wakeups with a known intended wake time
+        uint32_t latencySumUs;
+        uint32_t latencyMaxUs;
+    };
+
+    /**
+     * @class ThreadMonitor
+     * @brief Samples which thread runs and collects wakeup statistics
+     *
+     * CPU share is statistical: a Ticker interrupt samples the running thread
+     * every THREAD_MONITOR_SAMPLE_PERIOD_US, a period that is not a multiple
+     * of the RTOS tick so that tick-driven threads are not aliased. Samples
+     * of unregistered threads (idle, main, timer) count as "other".
+     *
+     * RTX keeps no context switch counters, so a thread counts its own
+     * wakeups with RecordWake. Each wakeup is one switch in, and when the
+     * thread knows when it should have woken, the lateness is its wakeup
+     * latency.
+     *
+     * Threading: Register and TakeWindow from any thread, RecordWake from the
+     * registered thread itself.
+     */
+    class ThreadMonitor {
+    public:
+        /**
+         * @brief Start the CPU sampler
+         */
+        void Start();
+
+        /**
+         * @brief Add a started thread, ignored once THREAD_MONITOR_MAX_THREADS are registered
+         */
+        void Register(Thread& thread);
+
+        /**
+         * @brief Count a wakeup of the calling thread
+         * @param expectedUs GetTimestampUs() of the event or deadline that should have woken the thread
+         */
+        void RecordWake(uint32_t expectedUs);
+        void RecordWake();
+
+        /**
+         * @brief ThisThread::sleep_for that records the wakeup latency
+         */
+        void SleepFor(std::chrono::milliseconds duration);
+
+        /**
+         * @brief Statistics since the last call, then start a new window
+         * @param out Receives one entry per registered thread
+         * @param otherSamples Set to the CPU samples of unregistered threads
+         * @return Number of entries written
+         */
+        size_t TakeWindow(ThreadStats* out, size_t maxCount, uint32_t& otherSamples);
+
+    private:
+        using ThreadId = decltype(ThisThread::get_id());
+
+        struct Entry {
+            Thread* thread;
+            ThreadId id;
+            std::atomic<uint32_t> cpuSamples{0};
+            std::atomic<uint32_t> wakeups{0};
+            std::atomic<uint32_t> latencyCount{0};
+            std::atomic<uint32_t> latencySumUs{0};
+            std::atomic<uint32_t> latencyMaxUs{0};
+        };
+
+        void Sample();
+        Entry* FindCurrent();
+
+        Ticker m_Sampler;
+        Entry m_Entries[THREAD_MONITOR_MAX_THREADS];
+        std::atomic<size_t> m_Count{0}; // entries below are complete
+        Mutex m_RegisterLock;
+        std::atomic<uint32_t> m_OtherSamples{0};
+    };
+
+    extern ThreadMonitor g_ThreadMonitor;
+
+} // namespace tritonai::gkc
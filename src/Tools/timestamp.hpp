@@ -0,0 +1,32 @@
+/**
+ * @file timestamp.hpp
+ * @brief Microsecond capture timestamps
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#pragma once
+
+#include <cstdint>
+#include "mbed.h"
+
+namespace tritonai::gkc {
+
+    /**
+    * @brief Free-running microsecond counter, wraps every ~71 minutes
+    *
+    * Only differences between two timestamps are meaningful; compute them with
+    * unsigned subtraction so wrap-around is handled.
+    */
+    inline uint32_t GetTimestampUs() {
+        return us_ticker_read();
+    }
+
+    /**
+    * @brief Microseconds elapsed since a timestamp
+    */
+    inline uint32_t GetAgeUs(uint32_t timestampUs) {
+        return GetTimestampUs() - timestampUs;
+    }
+
+} // namespace tritonai::gkc
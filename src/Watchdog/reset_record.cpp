@@ -0,0 +1,156 @@
+/**
+ * @file reset_record.cpp
+ * @brief Implementation of the backup SRAM reset record
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#include "Watchdog/reset_record.hpp"
+
+#include <cstring>
+
+namespace tritonai::gkc {
+
+    namespace {
+
+        constexpr uint32_t RESET_RECORD_MAGIC = 0x52535452; // "RSTR"
+
+        // Survives a system reset and, with VBAT, a power cycle. Random at
+        // the first power on, hence the magic and the inverted cause.
+        struct ResetRecord {
+            uint32_t magic;
+            uint8_t cause;
+            uint8_t causeCheck; // ~cause
+            char name[RESET_RECORD_NAME_SIZE];
+        };
+
+        ResetRecord* EnableBackupSram() {
+#if defined(D3_BKPSRAM_BASE)
+            // STM32H7: 4 KB in the D3 domain
+            HAL_PWR_EnableBkUpAccess();
+            __HAL_RCC_BKPRAM_CLK_ENABLE();
+            return reinterpret_cast<ResetRecord*>(D3_BKPSRAM_BASE);
+#elif defined(BKPSRAM_BASE)
+            // STM32F7: 4 KB on AHB1
+            HAL_PWR_EnableBkUpAccess();
+            __HAL_RCC_BKPSRAM_CLK_ENABLE();
+            return reinterpret_cast<ResetRecord*>(BKPSRAM_BASE);
+#else
+            // Host shim: a process restart loses it, like a power cycle without VBAT
+            static ResetRecord record;
+            return &record;
+#endif
+        }
+
+        ResetRecord* GetRecord() {
+            static ResetRecord* record = EnableBackupSram();
+            return record;
+        }
+
+        void StoreRecord(ResetRecord* record, ResetCause cause, const char* name) {
+            CriticalSectionLock lock;
+            record->magic = RESET_RECORD_MAGIC;
+            record->cause = static_cast<uint8_t>(cause);
+            record->causeCheck = static_cast<uint8_t>(~record->cause);
+            strncpy(record->name, name != nullptr ? name : "", sizeof(record->name) - 1);
+            record->name[sizeof(record->name) - 1] = '\0';
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+            // The backup SRAM of the H7 is cacheable, the reset must not lose the write
+            SCB_CleanDCache_by_Addr(reinterpret_cast<uint32_t*>(record), sizeof(ResetRecord));
+#endif
+        }
+
+        bool IsValid(const ResetRecord* record) {
+            return record->magic == RESET_RECORD_MAGIC &&
+                   record->causeCheck == static_cast<uint8_t>(~record->cause) &&
+                   record->cause < static_cast<uint8_t>(ResetCause::COUNT) &&
+                   memchr(record->name, '\0', sizeof(record->name)) != nullptr;
+        }
+
+        ResetCause FromHardwareReason(reset_reason_t reason) {
+            switch (reason) {
+            case RESET_REASON_POWER_ON:
+                return ResetCause::POWER_ON;
+            case RESET_REASON_PIN_RESET:
+                return ResetCause::PIN;
+            case RESET_REASON_BROWN_OUT:
+                return ResetCause::BROWN_OUT;
+            case RESET_REASON_SOFTWARE:
+                return ResetCause::SOFTWARE;
+            case RESET_REASON_WATCHDOG:
+                return ResetCause::HARDWARE_WATCHDOG;
+            case RESET_REASON_LOCKUP:
+                return ResetCause::LOCKUP;
+            default:
+                return ResetCause::UNKNOWN;
+            }
+        }
+
+    } // namespace
+
+    const char* GetResetCauseName(ResetCause cause) {
+        switch (cause) {
+        case ResetCause::POWER_ON:
+            return "power on";
+        case ResetCause::PIN:
+            return "reset pin";
+        case ResetCause::BROWN_OUT:
+            return "brown out";
+        case ResetCause::SOFTWARE:
+            return "software";
+        case ResetCause::WATCHABLE_TIMEOUT:
+            return "watchable timeout";
+        case ResetCause::HARDWARE_WATCHDOG:
+            return "hardware watchdog";
+        case ResetCause::HOST_REQUEST:
+            return "host request";
+        case ResetCause::LOCKUP:
+            return "lockup";
+        default:
+            return "unknown";
+        }
+    }
+
+    ResetReport ReadResetReport() {
+        const reset_reason_t reason = ResetReason::get();
+        ResetRecord* record = GetRecord();
+
+        ResetReport report{FromHardwareReason(reason), static_cast<uint8_t>(reason), {}};
+        if (IsValid(record)) {
+            switch (report.cause) {
+            case ResetCause::SOFTWARE:
+            case ResetCause::PIN: // NVIC_SystemReset also pulls the reset pin on STM32
+            case ResetCause::UNKNOWN:
+            case ResetCause::HARDWARE_WATCHDOG:
+                // The IWDG too: the record names the timeout the watch thread
+                // was handling when it stopped feeding it, the callback hung.
+                // Without a record the thread stalled elsewhere.
+                report.cause = static_cast<ResetCause>(record->cause);
+                memcpy(report.name, record->name, sizeof(report.name));
+                break;
+            default:
+                // Power loss, the record is from before it
+                break;
+            }
+        }
+
+        ClearPendingReset();
+        return report;
+    }
+
+    void RecordPendingReset(ResetCause cause, const char* name) {
+        StoreRecord(GetRecord(), cause, name);
+    }
+
+    void ClearPendingReset() {
+        ResetRecord* record = GetRecord();
+        if (record->magic != 0) {
+            CriticalSectionLock lock;
+            record->magic = 0;
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+            SCB_CleanDCache_by_Addr(reinterpret_cast<uint32_t*>(record), sizeof(ResetRecord));
+#endif
+        }
+    }
+
+} // namespace tritonai::gkc
@@ -0,0 +1,70 @@
+/**
+ * @file reset_record.hpp
+ * @brief Reset cause kept in backup SRAM across a reboot
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "mbed.h"
+
+#include "config.hpp"
+
+namespace tritonai::gkc {
+
+    /**
+     * @brief Why the previous boot ended, as reported to the host
+     */
+    enum class ResetCause : uint8_t {
+        UNKNOWN = 0,
+        POWER_ON = 1,
+        PIN = 2,                // reset button or debugger
+        BROWN_OUT = 3,
+        SOFTWARE = 4,           // NVIC_SystemReset without a recorded reason
+        WATCHABLE_TIMEOUT = 5,  // a Watchable missed its deadline and its callback reset
+        HARDWARE_WATCHDOG = 6,  // the IWDG was not fed, e.g. the watch thread stalled
+        HOST_REQUEST = 7,       // ResetRTCGkcPacket
+        LOCKUP = 8,             // the core locked up, e.g. a fault inside the fault handler
+        COUNT
+    };
+
+    /**
+     * @brief The reset cause of this boot and the component involved
+     */
+    struct ResetReport {
+        ResetCause cause;
+        uint8_t hardwareReason; // mbed reset_reason_t
+        char name[RESET_RECORD_NAME_SIZE]; // watchable that timed out, empty when none
+    };
+
+    /**
+     * @brief Name of a cause for logs
+     */
+    const char* GetResetCauseName(ResetCause cause);
+
+    /**
+     * @brief Combine the hardware reset flags with the backup SRAM record, then clear the record
+     *
+     * Call once, early at boot, before anything records a new reset.
+     */
+    ResetReport ReadResetReport();
+
+    /**
+     * @brief Record the reason for a reset about to happen
+     *
+     * Written before the reset or the action that may cause it, so that the
+     * record also survives the hardware watchdog firing while it runs.
+     * @param name Component involved, truncated to RESET_RECORD_NAME_SIZE - 1 characters
+     */
+    void RecordPendingReset(ResetCause cause, const char* name);
+
+    /**
+     * @brief Withdraw the pending reason once the action completed without a reset
+     */
+    void ClearPendingReset();
+
+} // namespace tritonai::gkc
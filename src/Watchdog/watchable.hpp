@@ -6,8 +6,10 @@
 #pragma once
 
 #include <stdint.h>
+#include <atomic>
 #include <iostream>
 #include <string>
+#include "Kernel.h"
 #include "mbed.h"
 
 namespace tritonai::gkc {
@@ -19,33 +21,37 @@ public:
         m_MaxInactivityLimitMs(maxInactivityLimitMs),
         m_Name(name) {}
 
-    void Activate() { m_Active = true; }
+    // Activation restarts the inactivity timeout
+    void Activate() {
+        m_LastKickMs.store(NowMs(), std::memory_order_relaxed);
+        m_Active = true;
+    }
     void Deactivate() { m_Active = false; }
-    void IncCount() { ++m_RollingCounter; }
+    // Signals activity, a lock-free timestamp store that any thread can afford on every iteration
+    void IncCount() { m_LastKickMs.store(NowMs(), std::memory_order_relaxed); }
+    uint32_t GetLastKickMs() const { return m_LastKickMs.load(std::memory_order_relaxed); }
     uint32_t GetUpdateInterval() { return m_UpdateIntervalMs; }
     void SetUpdateInterval(const uint32_t& updateIntervalMs) {
         this->m_UpdateIntervalMs = updateIntervalMs;
     }
     bool IsActivated() { return m_Active; }
     uint32_t GetMaxInactivityLimitMs() { return m_MaxInactivityLimitMs; }
-    virtual bool CheckActivity() {
-        bool activity = m_LastCheckRollingCounterVal != m_RollingCounter;
-        m_LastCheckRollingCounterVal = m_RollingCounter;
-        return activity;
-    }
     void Attach(Callback<void()> func) { m_CallbackFunc = func; }
     void WatchdogTrigger() { m_CallbackFunc(); }
     std::string GetName() { return m_Name; }
 
+    static uint32_t NowMs() {
+        return static_cast<uint32_t>(Kernel::Clock::now().time_since_epoch().count());
+    }
+
 protected:
     bool m_Active = false;
-    uint32_t m_RollingCounter = 0;
+    std::atomic<uint32_t> m_LastKickMs{0};
     uint32_t m_UpdateIntervalMs = 0;
     uint32_t m_MaxInactivityLimitMs = 0;
     Callback<void()> m_CallbackFunc;
     
 private:
-    uint32_t m_LastCheckRollingCounterVal = 0;
     std::string m_Name;
 };
 
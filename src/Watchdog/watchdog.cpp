@@ -4,6 +4,10 @@
  */
 
 #include "watchdog.hpp"
+#include "reset_record.hpp"
+#include "Tools/thread_monitor.hpp"
+#include "Tools/timestamp.hpp"
+#include <algorithm>
 #include <chrono>
 #include <functional>
 #include <iostream>
@@ -11,32 +15,56 @@
 
 namespace tritonai::gkc {
 
-    Watchdog::Watchdog(uint32_t updateIntervalMs, uint32_t maxInactivityLimitMs, 
-                    uint32_t wakeupEveryMs, ILogger* logger)
+    Watchdog::Watchdog(uint32_t updateIntervalMs, uint32_t maxInactivityLimitMs, ILogger* logger)
         : Watchable(updateIntervalMs, maxInactivityLimitMs, "Watchdog"),
-        m_WatchdogIntervalMs(wakeupEveryMs),
         m_Logger(logger)
     {
-        AddToWatchlist(this);
         Attach(callback(this, &Watchdog::WatchdogCallback));
         m_WatchThread.start(callback(this, &Watchdog::StartWatchThread));
+        g_ThreadMonitor.Register(m_WatchThread);
+        AddToWatchlist(this); // signals the thread, so after start()
     }
 
     void Watchdog::AddToWatchlist(Watchable* toWatch) {
-        m_Watchlist.push_back(WatchlistEntry(toWatch, 0));
+        m_Lock.lock();
+        m_Watchlist.push_back(toWatch);
+        m_Lock.unlock();
+        m_WatchThread.flags_set(WATCHLIST_CHANGED_FLAG);
     }
 
     void Watchdog::Arm() {
-        for (auto& entry : m_Watchlist) {
-            entry.first->Activate();
+        StartHardwareWatchdog();
+        m_Lock.lock();
+        for (Watchable* watchable : m_Watchlist) {
+            watchable->Activate();
         }
+        m_Lock.unlock();
+        m_WatchThread.flags_set(WATCHLIST_CHANGED_FLAG);
     }
 
     void Watchdog::Disarm() {
-        for (auto& entry : m_Watchlist) {
-            entry.first->Deactivate();
-            entry.second = 0;
+        m_Lock.lock();
+        for (Watchable* watchable : m_Watchlist) {
+            watchable->Deactivate();
         }
+        m_Lock.unlock();
+        m_WatchThread.flags_set(WATCHLIST_CHANGED_FLAG);
+    }
+
+    void Watchdog::StartHardwareWatchdog() {
+        if (HARDWARE_WATCHDOG_TIMEOUT_MS == 0 || m_HardwareWatchdogRunning.exchange(true)) {
+            return;
+        }
+#if defined(__HAL_DBGMCU_FREEZE_IWDG1)
+        __HAL_DBGMCU_FREEZE_IWDG1(); // keep counting only while the core runs, not at a breakpoint
+#elif defined(__HAL_DBGMCU_FREEZE_IWDG)
+        __HAL_DBGMCU_FREEZE_IWDG();
+#endif
+        if (!mbed::Watchdog::get_instance().start(HARDWARE_WATCHDOG_TIMEOUT_MS)) {
+            m_HardwareWatchdogRunning = false;
+            m_Logger->SendLog(LogPacket::Severity::ERROR, "Hardware watchdog failed to start");
+        }
+        // The watch thread is woken by the arming flag and feeds it from now on
     }
 
     void Watchdog::WatchdogCallback() {
@@ -44,42 +72,100 @@ namespace tritonai::gkc {
         NVIC_SystemReset();
     }
 
+    // Heap order for std::push_heap/pop_heap: the earliest deadline on top,
+    // compared as a signed difference so the millisecond clock may wrap
+    bool Watchdog::IsLater(const DeadlineEntry& a, const DeadlineEntry& b) {
+        return static_cast<int32_t>(a.deadlineMs - b.deadlineMs) > 0;
+    }
+
+    void Watchdog::RebuildDeadlines() {
+        m_Lock.lock();
+        m_Deadlines.clear();
+        m_Deadlines.reserve(m_Watchlist.size());
+        if (IsActivated()) {
+            for (Watchable* watchable : m_Watchlist) {
+                if (watchable->IsActivated()) {
+                    m_Deadlines.push_back({watchable,
+                                           watchable->GetLastKickMs() + watchable->GetMaxInactivityLimitMs()});
+                }
+            }
+        }
+        m_Lock.unlock();
+        std::make_heap(m_Deadlines.begin(), m_Deadlines.end(), IsLater);
+    }
+
+    void Watchdog::CheckDeadlines(uint32_t nowMs) {
+        while (!m_Deadlines.empty() && static_cast<int32_t>(nowMs - m_Deadlines.front().deadlineMs) >= 0) {
+            std::pop_heap(m_Deadlines.begin(), m_Deadlines.end(), IsLater);
+            DeadlineEntry& entry = m_Deadlines.back();
+            Watchable* watchable = entry.watchable;
+
+            const uint32_t deadlineMs = watchable->GetLastKickMs() + watchable->GetMaxInactivityLimitMs();
+            if (static_cast<int32_t>(nowMs - deadlineMs) < 0) {
+                // Kicked since the entry was queued
+                entry.deadlineMs = deadlineMs;
+            } else {
+                const std::string name = watchable->GetName();
+                m_Logger->SendLog(LogPacket::Severity::FATAL, "Watchdog triggered for " + name);
+                // Most callbacks reset; should one hang instead, the IWDG
+                // resets with this record still naming the component
+                RecordPendingReset(ResetCause::WATCHABLE_TIMEOUT, name.c_str());
+                watchable->WatchdogTrigger();
+                // Returned: the component degrades gracefully (the RC heartbeat
+                // e-stops), the timeout is handled and the IWDG stays fed
+                ClearPendingReset();
+                // A component that stays silent is triggered again every update interval
+                entry.deadlineMs = nowMs + watchable->GetUpdateInterval();
+            }
+            std::push_heap(m_Deadlines.begin(), m_Deadlines.end(), IsLater);
+        }
+    }
+
     void Watchdog::StartWatchThread() {
-        static auto lastTime = Kernel::Clock::now();
         while (true) {
-            if (IsActivated()) {
-                // m_Logger->SendLog(LogPacket::Severity::DEBUG, "Watchdog checking components");
-
-                auto timeElapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(
-                    Kernel::Clock::now() - lastTime);
-                    
-                for (auto& entry : m_Watchlist) {
-                    if (!entry.first->IsActivated()) {
-                        continue;
-                    }
-
-                    entry.second += timeElapsedMs.count();
-
-                    if (entry.second > entry.first->GetUpdateInterval()) {
-                        if (entry.first->CheckActivity()) {
-                            entry.second = 0;
-                        } else {
-                            entry.second += timeElapsedMs.count();
-                            
-                            if (entry.second > entry.first->GetMaxInactivityLimitMs()) {
-                                m_Logger->SendLog(LogPacket::Severity::FATAL, 
-                                                "Watchdog triggered for " + entry.first->GetName());
-                                entry.first->WatchdogTrigger();
-                            }
-                        }
-                    }
-                }
+            if (ThisThread::flags_get() & WATCHLIST_CHANGED_FLAG) {
+                ThisThread::flags_clear(WATCHLIST_CHANGED_FLAG);
+                RebuildDeadlines();
             }
 
             IncCount();
-            lastTime = Kernel::Clock::now();
-            ThisThread::sleep_for(std::chrono::milliseconds(m_WatchdogIntervalMs));
+            CheckDeadlines(NowMs());
+
+            // Every armed Watchable is now within its deadline or handled by
+            // its callback. The IWDG goes hungry when this loop stalls,
+            // including inside a trigger callback that never returns.
+            const bool feeding = m_HardwareWatchdogRunning.load(std::memory_order_relaxed);
+            if (feeding) {
+                mbed::Watchdog::get_instance().kick();
+            }
+
+            // Sleep until the earliest deadline or the next feed, or until the
+            // watchlist or arming changes. Kicks never shorten a deadline, so
+            // they need no wakeup.
+            uint32_t sleepMs = feeding ? HARDWARE_WATCHDOG_FEED_MS : osWaitForever;
+            if (!m_Deadlines.empty()) {
+                const uint32_t untilDeadlineMs = m_Deadlines.front().deadlineMs - NowMs();
+                if (static_cast<int32_t>(untilDeadlineMs) <= 0) {
+                    continue;
+                }
+                if (untilDeadlineMs < sleepMs) {
+                    sleepMs = untilDeadlineMs;
+                }
+            }
+            if (sleepMs == osWaitForever) {
+                ThisThread::flags_wait_any(WATCHLIST_CHANGED_FLAG, false);
+                g_ThreadMonitor.RecordWake();
+                continue;
+            }
+            const uint32_t wakeUs = GetTimestampUs() + sleepMs * 1000;
+            const uint32_t flags = ThisThread::flags_wait_any_for(WATCHLIST_CHANGED_FLAG,
+                                                                  std::chrono::milliseconds(sleepMs), false);
+            if (flags & osFlagsError) {
+                g_ThreadMonitor.RecordWake(wakeUs); // timed out at the deadline
+            } else {
+                g_ThreadMonitor.RecordWake();
+            }
         }
     }
 
-} // namespace tritonai::gkc
\ No newline at end of file
+} // namespace tritonai::gkc
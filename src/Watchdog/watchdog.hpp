@@ -5,9 +5,9 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <stdint.h>
-#include <utility>
 #include <vector>
 
 #include "Tools/logger.hpp"
@@ -18,8 +18,7 @@ namespace tritonai::gkc {
     class Watchdog : public Watchable {
     public:
         Watchdog() = delete;
-        Watchdog(uint32_t update_interval_ms, uint32_t max_inactivity_limit_ms,
-                uint32_t wakeup_every_ms, ILogger* logger);
+        Watchdog(uint32_t update_interval_ms, uint32_t max_inactivity_limit_ms, ILogger* logger);
 
         void AddToWatchlist(Watchable* to_watch);
         void Arm();
@@ -28,15 +27,29 @@ namespace tritonai::gkc {
         void WatchdogCallback(); // Watchable API
 
     protected:
-        typedef uint32_t TimeElapsed;
-        typedef std::pair<Watchable*, TimeElapsed> WatchlistEntry;
-        typedef std::vector<WatchlistEntry> Watchlist;
-        Watchlist m_Watchlist{};
+        // Deadline of one active watchable, possibly stale: kicks only move
+        // the real deadline later, so it is re-read when the entry comes due
+        struct DeadlineEntry {
+            Watchable* watchable;
+            uint32_t deadlineMs;
+        };
+
+        static constexpr uint32_t WATCHLIST_CHANGED_FLAG = 1;
+        static bool IsLater(const DeadlineEntry& a, const DeadlineEntry& b);
+
+        Mutex m_Lock;
+        std::vector<Watchable*> m_Watchlist{};   // guarded by m_Lock
+        std::vector<DeadlineEntry> m_Deadlines{}; // watch thread only, min-heap on deadlineMs
         Thread m_WatchThread{osPriorityNormal, OS_STACK_SIZE, nullptr, "watch_thread"};
-        uint32_t m_WatchdogIntervalMs;
+
+        // Set once by Arm, the IWDG cannot be stopped again
+        std::atomic<bool> m_HardwareWatchdogRunning{false};
+        void StartHardwareWatchdog();
 
         void StartWatchThread();
+        void RebuildDeadlines();
+        void CheckDeadlines(uint32_t nowMs);
         ILogger* m_Logger;
     };
 
-} // namespace tritonai::gkc
\ No newline at end of file
+} // namespace tritonai::gkc
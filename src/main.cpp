@@ -12,6 +12,9 @@
 // Global variable for controller passthrough state
 bool g_PassthroughEnabled = false;
 
+// The unit tests under test/ bring their own main()
+#ifndef PIO_UNIT_TESTING
+
 // Button callback for toggling passthrough mode
 void TogglePassthrough() {
     g_PassthroughEnabled = !g_PassthroughEnabled;
@@ -28,4 +31,6 @@ int main() {
     while (true) {
         ThisThread::sleep_for(3600000ms);
     };
-}
\ No newline at end of file
+}
+
+#endif // PIO_UNIT_TESTING
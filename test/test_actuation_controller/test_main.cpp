@@ -0,0 +1,241 @@
+/**
+ * @file test_main.cpp
+ * @brief SetpointShaper trajectories and the throttle ActuationController sends
+ *
+ * The controller cases read the speed setpoints back from the CAN bus. Its CAN
+ * receive thread never exits, so one controller is shared by all of them.
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <string>
+
+#include <unity.h>
+
+#include "mbed.h"
+#include "mbed_shim/host.hpp"
+
+#include "config.hpp"
+#include "Actuation/actuation_controller.hpp"
+#include "Actuation/setpoint_shaper.hpp"
+#include "Actuation/vesc_can_tools.hpp"
+
+using namespace tritonai::gkc;
+
+namespace {
+
+    constexpr float DT_S = CONTROL_LOOP_PERIOD_US / 1e6f;
+    constexpr float TOLERANCE = 1e-4f;
+    constexpr auto BUS_SETTLE = std::chrono::milliseconds(5); // a few frame times at CAN2_BAUDRATE
+
+    class NullLogger : public ILogger {
+    public:
+        void SendLog(const LogPacket::Severity&, const std::string&) override {}
+    };
+
+    // Most recent speed setpoint on the bus, in ERPM
+    std::atomic<int32_t> g_LastErpm{0};
+    std::atomic<uint32_t> g_ErpmFrames{0};
+
+    ActuationController& GetController() {
+        static NullLogger logger;
+        static ActuationController* controller = [] {
+            mbed_shim::SetCanListener(CAN2_RX, [](const CANMessage& msg, uint32_t) {
+                if (msg.format == CANExtended && (msg.id & 0xFF) == THROTTLE_CAN_ID &&
+                    (msg.id >> 8) == CAN_PACKET_SET_RPM && msg.len >= 4) {
+                    int32_t index = 0;
+                    g_LastErpm = BufferGetInt32(msg.data, &index);
+                    g_ErpmFrames++;
+                }
+            });
+            return new ActuationController(&logger);
+        }();
+        return *controller;
+    }
+
+    // CommCanSetSpeed's conversion, truncated as on the wire
+    int32_t SpeedToErpm(float speedMs) {
+        return static_cast<int32_t>(static_cast<float>(
+            speedMs * NUM_MOTOR_POLES * GEAR_RATIO / WHEEL_CIRCUMFERENCE_M * 60.0));
+    }
+
+    // One control tick, then the last speed setpoint that reached the bus
+    int32_t Tick(ActuationController& controller) {
+        const uint32_t frames = g_ErpmFrames;
+        controller.Update(DT_S);
+        ThisThread::sleep_for(BUS_SETTLE);
+        TEST_ASSERT_TRUE(g_ErpmFrames > frames);
+        return g_LastErpm;
+    }
+
+    // Ticks until a jerk limited ramp from standstill shows on the bus
+    constexpr int RAMP_START_TICKS = 20;
+
+    // Ramp a fresh throttle up for a number of ticks
+    int32_t RampUp(ActuationController& controller, float target, int ticks) {
+        controller.FullRelRevCurrentBrake();
+        controller.SetBrakeCmd(0.0f);
+        int32_t erpm = 0;
+        for (int i = 0; i < ticks; i++) {
+            controller.SetThrottleCmd(target);
+            erpm = Tick(controller);
+        }
+        return erpm;
+    }
+
+} // namespace
+
+void setUp() {}
+
+void tearDown() {}
+
+// Without a jerk limit the output moves at exactly the rate limit
+void test_shaper_rate_limit() {
+    SetpointShaper shaper(4.0f, 0.0f);
+    shaper.SetTarget(1.0f);
+    for (int i = 1; i <= 10; i++) {
+        TEST_ASSERT_FLOAT_WITHIN(TOLERANCE, 4.0f * DT_S * i, shaper.Update(DT_S));
+    }
+}
+
+// The rate builds up by at most the jerk limit per second, and never passes the rate limit
+void test_shaper_jerk_limit() {
+    constexpr float MAX_RATE = 4.0f;
+    constexpr float MAX_JERK = 10.0f;
+    SetpointShaper shaper(MAX_RATE, MAX_JERK);
+    shaper.SetTarget(5.0f);
+
+    float last = 0.0f;
+    float lastRate = 0.0f;
+    for (int i = 0; i < 600; i++) {
+        const float output = shaper.Update(DT_S);
+        const float rate = (output - last) / DT_S;
+        if (output != 5.0f) { // the final snap onto the target
+            TEST_ASSERT_TRUE(std::fabs(rate - lastRate) <= MAX_JERK * DT_S + TOLERANCE);
+        }
+        TEST_ASSERT_TRUE(rate <= MAX_RATE + TOLERANCE);
+        last = output;
+        lastRate = rate;
+    }
+    TEST_ASSERT_EQUAL_FLOAT(5.0f, last);
+
+    // First step is one jerk step of rate
+    SetpointShaper fresh(MAX_RATE, MAX_JERK);
+    fresh.SetTarget(5.0f);
+    TEST_ASSERT_FLOAT_WITHIN(TOLERANCE, MAX_JERK * DT_S * DT_S, fresh.Update(DT_S));
+}
+
+// The output slows down in time and stops exactly on the target
+void test_shaper_lands_without_overshoot() {
+    SetpointShaper shaper(THROTTLE_SLEW_RATE, THROTTLE_JERK_LIMIT);
+    shaper.SetTarget(2.0f);
+
+    float last = 0.0f;
+    int ticks = 0;
+    while (shaper.GetOutput() != 2.0f && ticks < 1000) {
+        const float output = shaper.Update(DT_S);
+        TEST_ASSERT_TRUE(output >= last);
+        TEST_ASSERT_TRUE(output <= 2.0f);
+        last = output;
+        ticks++;
+    }
+    TEST_ASSERT_EQUAL_FLOAT(2.0f, shaper.GetOutput());
+    TEST_ASSERT_TRUE(ticks < 1000);
+    TEST_ASSERT_EQUAL_FLOAT(2.0f, shaper.Update(DT_S));
+}
+
+// A target flipped mid-ramp turns the output around smoothly and lands on the new target
+void test_shaper_target_reversal() {
+    constexpr float MAX_JERK = 20.0f;
+    SetpointShaper shaper(2.0f, MAX_JERK);
+    shaper.SetTarget(1.0f);
+
+    float last = 0.0f;
+    float lastRate = 0.0f;
+    int ticks = 0;
+    while (shaper.GetOutput() != -1.0f && ticks < 1000) {
+        if (ticks == 40) {
+            TEST_ASSERT_TRUE(lastRate > 0.0f); // still moving toward the first target
+            shaper.SetTarget(-1.0f);
+        }
+        const float output = shaper.Update(DT_S);
+        const float rate = (output - last) / DT_S;
+        TEST_ASSERT_TRUE(output >= -1.0f);
+        // No jump in rate while turning around, except the final snap onto the target
+        if (output != -1.0f) {
+            TEST_ASSERT_TRUE(std::fabs(rate - lastRate) <= MAX_JERK * DT_S + TOLERANCE);
+        }
+        last = output;
+        lastRate = rate;
+        ticks++;
+    }
+    TEST_ASSERT_EQUAL_FLOAT(-1.0f, shaper.GetOutput());
+}
+
+// Speeding up from standstill is ramped, the first jerk step is below one ERPM
+void test_throttle_ramps_up() {
+    ActuationController& controller = GetController();
+    TEST_ASSERT_EQUAL_INT32(0, RampUp(controller, 5.0f, 1));
+    const int32_t erpm = RampUp(controller, 5.0f, RAMP_START_TICKS);
+    TEST_ASSERT_TRUE(erpm > 0);
+    TEST_ASSERT_TRUE(erpm < SpeedToErpm(5.0f) / 10);
+}
+
+// Brake and throttle together send zero speed on that same tick
+void test_brake_cuts_throttle_same_tick() {
+    ActuationController& controller = GetController();
+    TEST_ASSERT_TRUE(RampUp(controller, 5.0f, 100) > 0);
+
+    controller.SetThrottleCmd(5.0f);
+    controller.SetBrakeCmd(0.5f);
+    TEST_ASSERT_EQUAL_INT32(0, Tick(controller));
+
+    // Released again, the throttle ramps up from standstill
+    controller.SetThrottleCmd(5.0f);
+    controller.SetBrakeCmd(0.0f);
+    const int32_t erpm = Tick(controller);
+    TEST_ASSERT_TRUE(erpm < SpeedToErpm(5.0f) / 10);
+}
+
+// Letting off is sent at once, zero or a lower speed
+void test_throttle_cut_not_shaped() {
+    ActuationController& controller = GetController();
+    TEST_ASSERT_TRUE(RampUp(controller, 5.0f, 400) > 0);
+
+    controller.SetThrottleCmd(2.0f);
+    TEST_ASSERT_EQUAL_INT32(SpeedToErpm(2.0f), Tick(controller));
+    controller.SetThrottleCmd(0.0f);
+    TEST_ASSERT_EQUAL_INT32(0, Tick(controller));
+}
+
+// Reversing drops to standstill at once and ramps up the other way
+void test_throttle_reversal_restarts_ramp() {
+    ActuationController& controller = GetController();
+    TEST_ASSERT_TRUE(RampUp(controller, 5.0f, 400) > 0);
+
+    controller.SetThrottleCmd(-3.0f);
+    TEST_ASSERT_EQUAL_INT32(0, Tick(controller));
+    int32_t erpm = 0;
+    for (int i = 0; i < RAMP_START_TICKS; i++) {
+        controller.SetThrottleCmd(-3.0f);
+        erpm = Tick(controller);
+    }
+    TEST_ASSERT_TRUE(erpm < 0);
+    TEST_ASSERT_TRUE(erpm > SpeedToErpm(-3.0f) / 10);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_shaper_rate_limit);
+    RUN_TEST(test_shaper_jerk_limit);
+    RUN_TEST(test_shaper_lands_without_overshoot);
+    RUN_TEST(test_shaper_target_reversal);
+    RUN_TEST(test_throttle_ramps_up);
+    RUN_TEST(test_brake_cuts_throttle_same_tick);
+    RUN_TEST(test_throttle_cut_not_shaped);
+    RUN_TEST(test_throttle_reversal_restarts_ramp);
+    return UNITY_END();
+}
@@ -0,0 +1,367 @@
+/**
+ * @file test_main.cpp
+ * @brief CommManager framing, local packets and allocation, TxScheduler ordering
+ *
+ * CommManager owns the main UART pins and threads that never exit, so every
+ * test shares one instance and talks to it through mbed_shim's serial port.
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include <unity.h>
+
+#include "mbed.h"
+#include "mbed_shim/host.hpp"
+
+#include "config.hpp"
+#include "Comm/comm.hpp"
+#include "Comm/gkc_frame.hpp"
+#include "Comm/tx_scheduler.hpp"
+
+using namespace tritonai::gkc;
+
+// Heap allocations made by the thread that counts them
+static thread_local bool t_CountAllocations = false;
+static thread_local size_t t_Allocations = 0;
+
+void* operator new(size_t size) {
+    if (t_CountAllocations) {
+        t_Allocations++;
+    }
+    if (void* memory = malloc(size == 0 ? 1 : size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* memory) noexcept {
+    free(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+    operator delete(memory);
+}
+
+namespace {
+
+    class NullLogger : public ILogger {
+    public:
+        void SendLog(const LogPacket::Severity&, const std::string&) override {}
+    };
+
+    class NullSubscriber : public GkcPacketSubscriber {
+    public:
+        void packet_callback(const Handshake1GkcPacket&) override {}
+        void packet_callback(const Handshake2GkcPacket&) override {}
+        void packet_callback(const GetFirmwareVersionGkcPacket&) override {}
+        void packet_callback(const FirmwareVersionGkcPacket&) override {}
+        void packet_callback(const ResetRTCGkcPacket&) override {}
+        void packet_callback(const HeartbeatGkcPacket&) override {}
+        void packet_callback(const ConfigGkcPacket&) override {}
+        void packet_callback(const StateTransitionGkcPacket&) override {}
+        void packet_callback(const ControlGkcPacket&) override {}
+        void packet_callback(const SensorGkcPacket&) override {}
+        void packet_callback(const Shutdown1GkcPacket&) override {}
+        void packet_callback(const Shutdown2GkcPacket&) override {}
+        void packet_callback(const LogPacket&) override {}
+        void packet_callback(const RCControlGkcPacket&) override {}
+    };
+
+    // Exposes the packet library and the learned templates
+    class TestCommManager : public CommManager {
+    public:
+        using CommManager::CommManager;
+
+        bool HasTemplates() const { return m_HeartbeatTemplate.IsValid() && m_SensorTemplate.IsValid(); }
+        GkcBuffer EncodeWithLibrary(const GkcPacket& packet) { return *m_Factory->Send(packet); }
+    };
+
+    // Frames the firmware wrote to the main UART, as complete payloads
+    class WireCapture {
+    public:
+        WireCapture() {
+            mbed_shim::SetSerialTxListener(UART_TX_PIN, [this](const uint8_t* data, size_t len) {
+                std::lock_guard<std::mutex> lock(m_Lock);
+                m_Bytes.insert(m_Bytes.end(), data, data + len);
+                for (size_t i = 0; i < len; i++) {
+                    if (m_Parser.Push(data[i])) {
+                        const uint8_t* payload = m_Parser.GetPayload();
+                        m_Payloads.emplace_back(payload, payload + m_Parser.GetPayloadSize());
+                    }
+                }
+            });
+        }
+
+        ~WireCapture() { mbed_shim::SetSerialTxListener(UART_TX_PIN, nullptr); }
+
+        /**
+         * @brief Wait for the first payload with this packet ID
+         */
+        bool WaitFor(uint8_t packetId, std::vector<uint8_t>& payload, uint32_t timeoutMs = 500) {
+            for (uint32_t waitedMs = 0; waitedMs < timeoutMs; waitedMs++) {
+                {
+                    std::lock_guard<std::mutex> lock(m_Lock);
+                    for (const auto& candidate : m_Payloads) {
+                        if (candidate[0] == packetId) {
+                            payload = candidate;
+                            return true;
+                        }
+                    }
+                }
+                ThisThread::sleep_for(std::chrono::milliseconds(1));
+            }
+            return false;
+        }
+
+        std::vector<uint8_t> GetBytes() {
+            std::lock_guard<std::mutex> lock(m_Lock);
+            return m_Bytes;
+        }
+
+    private:
+        std::mutex m_Lock;
+        GkcFrameParser m_Parser;
+        std::vector<uint8_t> m_Bytes;
+        std::vector<std::vector<uint8_t>> m_Payloads;
+    };
+
+    TestCommManager& GetComm() {
+        static NullLogger logger;
+        static NullSubscriber subscriber;
+        static TestCommManager* comm = new TestCommManager(&subscriber, &logger);
+        return *comm;
+    }
+
+    // CRC-16/XMODEM bit by bit, as serial_test.py computes it
+    uint16_t ReferenceCrc16(const uint8_t* data, size_t len) {
+        uint16_t crc = 0;
+        for (size_t i = 0; i < len; i++) {
+            crc ^= static_cast<uint16_t>(data[i]) << 8;
+            for (int bit = 0; bit < 8; bit++) {
+                crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ 0x1021) : static_cast<uint16_t>(crc << 1);
+            }
+        }
+        return crc;
+    }
+
+    PacketBuffer MakeFrame(uint8_t packetId, uint8_t value = 0) {
+        PacketBuffer buffer;
+        const uint8_t payload[2] = {packetId, value};
+        buffer.size = EncodeFrame(payload, sizeof(payload), buffer.data, sizeof(buffer.data));
+        return buffer;
+    }
+
+    uint8_t GetId(const PacketBuffer* buffer) {
+        return GetFramePacketId(buffer->data, buffer->size);
+    }
+
+    void Report(const char* what, double value, const char* unit) {
+        char message[96];
+        snprintf(message, sizeof(message), "%s: %.1f %s", what, value, unit);
+        TEST_MESSAGE(message);
+    }
+
+} // namespace
+
+void setUp() {}
+
+void tearDown() {}
+
+// SendRaw frames a payload as 0x02 | size | payload | CRC16 LE | 0x03
+void test_send_raw_frame_on_wire() {
+    TestCommManager& comm = GetComm();
+    WireCapture wire;
+    const uint8_t payload[] = {GKC_ID_THREAD_INFO, 0x11, 0x22, 0x33};
+    comm.SendRaw(payload, sizeof(payload));
+
+    std::vector<uint8_t> received;
+    TEST_ASSERT_TRUE(wire.WaitFor(GKC_ID_THREAD_INFO, received));
+    TEST_ASSERT_EQUAL_size_t(sizeof(payload), received.size());
+    TEST_ASSERT_EQUAL_MEMORY(payload, received.data(), sizeof(payload));
+
+    // The same bytes serial_test.py expects
+    const std::vector<uint8_t> bytes = wire.GetBytes();
+    const uint16_t crc = ReferenceCrc16(payload, sizeof(payload));
+    const uint8_t expected[] = {GKC_FRAME_START, sizeof(payload), GKC_ID_THREAD_INFO, 0x11, 0x22, 0x33,
+                                static_cast<uint8_t>(crc & 0xFF), static_cast<uint8_t>(crc >> 8), GKC_FRAME_END};
+    bool found = false;
+    for (size_t i = 0; i + sizeof(expected) <= bytes.size() && !found; i++) {
+        found = memcmp(&bytes[i], expected, sizeof(expected)) == 0;
+    }
+    TEST_ASSERT_TRUE(found);
+}
+
+// Inbound firmware-local packets reach the local handler, in interrupt order
+void test_local_packet_handler() {
+    TestCommManager& comm = GetComm();
+    std::atomic<int> calls{0};
+    std::atomic<uint8_t> severity{0xFF};
+    comm.SetLocalPacketHandler([&](const uint8_t* payload, size_t len) {
+        if (len == 2 && payload[0] == GKC_ID_LOG_CONFIG) {
+            severity = payload[1];
+            calls++;
+        }
+    });
+
+    const uint8_t payload[] = {GKC_ID_LOG_CONFIG, 3};
+    uint8_t frame[sizeof(payload) + GKC_FRAME_OVERHEAD];
+    const size_t size = EncodeFrame(payload, sizeof(payload), frame, sizeof(frame));
+    // Split mid-frame, the parser keeps its state across reads
+    mbed_shim::SerialWrite(UART_TX_PIN, frame, 3);
+    ThisThread::sleep_for(std::chrono::milliseconds(2));
+    mbed_shim::SerialWrite(UART_TX_PIN, frame + 3, size - 3);
+    for (int i = 0; i < 200 && calls.load() == 0; i++) {
+        ThisThread::sleep_for(std::chrono::milliseconds(1));
+    }
+    comm.SetLocalPacketHandler(nullptr);
+
+    TEST_ASSERT_EQUAL_INT(1, calls.load());
+    TEST_ASSERT_EQUAL_UINT8(3, severity.load());
+}
+
+// The periodic packets are framed from a learned template, byte for byte
+// what the packet library would send, without touching the heap
+void test_heartbeat_and_sensor_send_allocate_nothing() {
+    TestCommManager& comm = GetComm();
+    if (!comm.HasTemplates()) {
+        TEST_IGNORE_MESSAGE("packet library layout not learnable, Send falls back to the library");
+    }
+
+    HeartbeatGkcPacket heartbeat;
+    heartbeat.rolling_counter = 0x5A;
+    heartbeat.state = GkcLifecycle::Active;
+    SensorGkcPacket sensor;
+    sensor.values.wheel_speed_fl = 1.5f;
+    sensor.values.brake_pressure = 42.25f;
+    sensor.values.steering_angle_rad = -0.125f;
+
+    // The library's encoder allocates, which is what the count must catch
+    t_Allocations = 0;
+    t_CountAllocations = true;
+    comm.Send(static_cast<const GkcPacket&>(heartbeat));
+    t_CountAllocations = false;
+    TEST_ASSERT_GREATER_THAN(0, t_Allocations);
+    ThisThread::sleep_for(std::chrono::milliseconds(20));
+
+    WireCapture wire;
+    t_Allocations = 0;
+    t_CountAllocations = true;
+    comm.Send(heartbeat);
+    comm.Send(sensor);
+    t_CountAllocations = false;
+    TEST_ASSERT_EQUAL_size_t(0, t_Allocations);
+
+    const GkcBuffer heartbeatFrame = comm.EncodeWithLibrary(heartbeat);
+    const GkcBuffer sensorFrame = comm.EncodeWithLibrary(sensor);
+    std::vector<uint8_t> received;
+    TEST_ASSERT_TRUE(wire.WaitFor(heartbeatFrame[GKC_FRAME_HEADER_SIZE], received));
+    TEST_ASSERT_EQUAL_size_t(heartbeatFrame[1], received.size());
+    TEST_ASSERT_EQUAL_MEMORY(&heartbeatFrame[GKC_FRAME_HEADER_SIZE], received.data(), received.size());
+    TEST_ASSERT_TRUE(wire.WaitFor(sensorFrame[GKC_FRAME_HEADER_SIZE], received));
+    TEST_ASSERT_EQUAL_size_t(sensorFrame[1], received.size());
+    TEST_ASSERT_EQUAL_MEMORY(&sensorFrame[GKC_FRAME_HEADER_SIZE], received.data(), received.size());
+}
+
+// Strict priority: safety, control, sensor, log
+void test_scheduler_priority_order() {
+    TxScheduler scheduler(BAUD_RATE);
+    PacketBuffer log = MakeFrame(GKC_ID_LOG);
+    PacketBuffer sensor = MakeFrame(GKC_ID_SENSOR);
+    PacketBuffer reply = MakeFrame(GKC_ID_FIRMWARE_VERSION);
+    PacketBuffer heartbeat = MakeFrame(GKC_ID_HEARTBEAT);
+    TEST_ASSERT_NULL(scheduler.Enqueue(&log));
+    TEST_ASSERT_NULL(scheduler.Enqueue(&sensor));
+    TEST_ASSERT_NULL(scheduler.Enqueue(&reply));
+    TEST_ASSERT_NULL(scheduler.Enqueue(&heartbeat));
+
+    TEST_ASSERT_EQUAL_HEX8(GKC_ID_HEARTBEAT, GetId(scheduler.TryDequeue(SEND_FRAME_MAX_SIZE)));
+    TEST_ASSERT_EQUAL_HEX8(GKC_ID_FIRMWARE_VERSION, GetId(scheduler.TryDequeue(SEND_FRAME_MAX_SIZE)));
+    TEST_ASSERT_EQUAL_HEX8(GKC_ID_SENSOR, GetId(scheduler.TryDequeue(SEND_FRAME_MAX_SIZE)));
+    TEST_ASSERT_EQUAL_HEX8(GKC_ID_LOG, GetId(scheduler.TryDequeue(SEND_FRAME_MAX_SIZE)));
+    TEST_ASSERT_NULL(scheduler.TryDequeue(SEND_FRAME_MAX_SIZE));
+}
+
+// A newer heartbeat takes the queued one's place, the older is handed back
+void test_scheduler_heartbeat_latest_wins() {
+    TxScheduler scheduler(BAUD_RATE);
+    PacketBuffer older = MakeFrame(GKC_ID_HEARTBEAT, 1);
+    PacketBuffer reply = MakeFrame(GKC_ID_STATE_TRANSITION);
+    PacketBuffer newer = MakeFrame(GKC_ID_HEARTBEAT, 2);
+    TEST_ASSERT_NULL(scheduler.Enqueue(&older));
+    TEST_ASSERT_NULL(scheduler.Enqueue(&reply));
+    TEST_ASSERT_TRUE(scheduler.Enqueue(&newer) == &older);
+    TEST_ASSERT_EQUAL_UINT32(1, scheduler.GetDroppedCount(TxClass::SAFETY));
+
+    // Keeps the position of the packet it replaced
+    TEST_ASSERT_TRUE(scheduler.TryDequeue(SEND_FRAME_MAX_SIZE) == &newer);
+    TEST_ASSERT_TRUE(scheduler.TryDequeue(SEND_FRAME_MAX_SIZE) == &reply);
+}
+
+// A full safety queue never evicts a one-shot reply
+void test_scheduler_full_safety_queue_keeps_replies() {
+    TxScheduler scheduler(BAUD_RATE);
+    PacketBuffer heartbeat = MakeFrame(GKC_ID_HEARTBEAT);
+    PacketBuffer replies[TX_QUEUE_DEPTH_SAFETY];
+    TEST_ASSERT_NULL(scheduler.Enqueue(&heartbeat));
+    for (size_t i = 0; i + 1 < TX_QUEUE_DEPTH_SAFETY; i++) {
+        replies[i] = MakeFrame(GKC_ID_STATE_TRANSITION, static_cast<uint8_t>(i));
+        TEST_ASSERT_NULL(scheduler.Enqueue(&replies[i]));
+    }
+
+    // Full: the last reply makes room by dropping the heartbeat
+    replies[TX_QUEUE_DEPTH_SAFETY - 1] = MakeFrame(GKC_ID_RESET_CAUSE);
+    TEST_ASSERT_TRUE(scheduler.Enqueue(&replies[TX_QUEUE_DEPTH_SAFETY - 1]) == &heartbeat);
+
+    // Full of replies: the newest is rejected, the queued ones stay
+    PacketBuffer extra = MakeFrame(GKC_ID_SHUTDOWN1);
+    TEST_ASSERT_TRUE(scheduler.Enqueue(&extra) == &extra);
+    PacketBuffer lateHeartbeat = MakeFrame(GKC_ID_HEARTBEAT);
+    TEST_ASSERT_TRUE(scheduler.Enqueue(&lateHeartbeat) == &lateHeartbeat);
+    for (size_t i = 0; i < TX_QUEUE_DEPTH_SAFETY; i++) {
+        TEST_ASSERT_TRUE(scheduler.TryDequeue(SEND_FRAME_MAX_SIZE) == &replies[i]);
+    }
+}
+
+// Cost of queueing and taking one frame, the send thread's per-packet overhead
+void test_scheduler_benchmark() {
+    constexpr int ITERATIONS = 200000;
+    TxScheduler scheduler(BAUD_RATE);
+    PacketBuffer frames[2] = {MakeFrame(GKC_ID_LOG), MakeFrame(GKC_ID_SENSOR)};
+
+    Timer timer;
+    timer.start();
+    for (int i = 0; i < ITERATIONS; i++) {
+        scheduler.Enqueue(&frames[0]);
+        scheduler.Enqueue(&frames[1]);
+        scheduler.TryDequeue(SEND_FRAME_MAX_SIZE);
+        scheduler.TryDequeue(SEND_FRAME_MAX_SIZE);
+    }
+    timer.stop();
+    Report("TxScheduler enqueue + dequeue", timer.elapsed_time().count() * 1000.0 / (2 * ITERATIONS), "ns");
+    TEST_ASSERT_NULL(scheduler.TryDequeue(SEND_FRAME_MAX_SIZE));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_send_raw_frame_on_wire);
+    RUN_TEST(test_local_packet_handler);
+    RUN_TEST(test_heartbeat_and_sensor_send_allocate_nothing);
+    RUN_TEST(test_scheduler_priority_order);
+    RUN_TEST(test_scheduler_heartbeat_latest_wins);
+    RUN_TEST(test_scheduler_full_safety_queue_keeps_replies);
+    RUN_TEST(test_scheduler_benchmark);
+    return UNITY_END();
+}
@@ -0,0 +1,203 @@
+/**
+ * @file test_main.cpp
+ * @brief ControlLoop source arbitration, source timeouts and the jitter histogram
+ *
+ * The loop runs on the shim's microsecond Ticker at CONTROL_LOOP_PERIOD_US, and
+ * the source timeouts are the configured ones. Its thread never exits, so one
+ * loop is shared by all cases and every case starts with all sources released.
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+#include <unity.h>
+
+#include "mbed.h"
+
+#include "config.hpp"
+#include "Controller/control_loop.hpp"
+
+using namespace tritonai::gkc;
+
+namespace {
+
+    // A few ticks, for a submitted setpoint to be applied
+    constexpr auto APPLIED = std::chrono::microseconds(4 * CONTROL_LOOP_PERIOD_US);
+    constexpr auto MARGIN = std::chrono::milliseconds(50);
+
+    std::mutex g_OutputLock;
+    ActuationSetpoint g_LastOutput;
+    std::atomic<uint32_t> g_Outputs{0};
+
+    void CaptureOutput(const ActuationSetpoint& setpoint) {
+        std::lock_guard<std::mutex> lock(g_OutputLock);
+        g_LastOutput = setpoint;
+        g_Outputs++;
+    }
+
+    ActuationSetpoint GetLastOutput() {
+        std::lock_guard<std::mutex> lock(g_OutputLock);
+        return g_LastOutput;
+    }
+
+    ControlLoop& GetLoop() {
+        static ControlLoop* loop = [] {
+            ControlLoop* started = new ControlLoop(callback(CaptureOutput));
+            started->Start();
+            return started;
+        }();
+        return *loop;
+    }
+
+    void ReleaseAll(ControlLoop& loop) {
+        loop.Release(SetpointSource::SAFETY);
+        loop.Release(SetpointSource::RC);
+        loop.Release(SetpointSource::AUTONOMY);
+    }
+
+    void Wait(std::chrono::microseconds duration) {
+        std::this_thread::sleep_for(duration);
+    }
+
+    uint32_t BucketSum(const ControlJitterStats& stats) {
+        uint32_t sum = 0;
+        for (size_t i = 0; i < ControlJitterStats::BUCKET_COUNT; i++) {
+            sum += stats.buckets[i];
+        }
+        return sum;
+    }
+
+} // namespace
+
+void setUp() {
+    ReleaseAll(GetLoop());
+    Wait(APPLIED);
+}
+
+void tearDown() {}
+
+// SAFETY wins over RC, RC over AUTONOMY, releasing one falls back to the next
+void test_source_priority() {
+    ControlLoop& loop = GetLoop();
+    loop.Submit(SetpointSource::AUTONOMY, ActuationSetpoint{3.0f, 0.1f, 0.0f});
+    Wait(APPLIED);
+    TEST_ASSERT_EQUAL(SetpointSource::AUTONOMY, loop.GetActiveSource());
+
+    loop.Submit(SetpointSource::RC, ActuationSetpoint{2.0f, -0.1f, 0.0f});
+    Wait(APPLIED);
+    TEST_ASSERT_EQUAL(SetpointSource::RC, loop.GetActiveSource());
+    TEST_ASSERT_EQUAL_FLOAT(2.0f, GetLastOutput().throttle);
+
+    loop.Submit(SetpointSource::SAFETY, ActuationSetpoint{0.0f, 0.0f, 1.0f});
+    Wait(APPLIED);
+    TEST_ASSERT_EQUAL(SetpointSource::SAFETY, loop.GetActiveSource());
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, GetLastOutput().brake);
+
+    // A lower source submitting again does not take over
+    loop.Submit(SetpointSource::AUTONOMY, ActuationSetpoint{3.0f, 0.1f, 0.0f});
+    Wait(APPLIED);
+    TEST_ASSERT_EQUAL(SetpointSource::SAFETY, loop.GetActiveSource());
+
+    loop.Release(SetpointSource::SAFETY);
+    Wait(APPLIED);
+    TEST_ASSERT_EQUAL(SetpointSource::RC, loop.GetActiveSource());
+
+    loop.Release(SetpointSource::RC);
+    Wait(APPLIED);
+    TEST_ASSERT_EQUAL(SetpointSource::AUTONOMY, loop.GetActiveSource());
+    TEST_ASSERT_EQUAL_FLOAT(0.1f, GetLastOutput().steering);
+}
+
+// RC and AUTONOMY expire after their timeouts, SAFETY is held until released
+void test_source_timeouts() {
+    ControlLoop& loop = GetLoop();
+    loop.Submit(SetpointSource::AUTONOMY, ActuationSetpoint{3.0f, 0.1f, 0.0f});
+    Wait(std::chrono::milliseconds(CONTROL_AUTONOMY_SETPOINT_TIMEOUT_MS) - MARGIN);
+    TEST_ASSERT_EQUAL(SetpointSource::AUTONOMY, loop.GetActiveSource());
+    Wait(2 * MARGIN);
+    TEST_ASSERT_EQUAL(SetpointSource::COUNT, loop.GetActiveSource());
+
+    loop.Submit(SetpointSource::RC, ActuationSetpoint{2.0f, 0.0f, 0.0f});
+    Wait(std::chrono::milliseconds(CONTROL_RC_SETPOINT_TIMEOUT_MS) - MARGIN);
+    TEST_ASSERT_EQUAL(SetpointSource::RC, loop.GetActiveSource());
+    Wait(2 * MARGIN);
+    TEST_ASSERT_EQUAL(SetpointSource::COUNT, loop.GetActiveSource());
+
+    loop.Submit(SetpointSource::SAFETY, ActuationSetpoint{0.0f, 0.0f, 1.0f});
+    Wait(std::chrono::milliseconds(CONTROL_RC_SETPOINT_TIMEOUT_MS + CONTROL_AUTONOMY_SETPOINT_TIMEOUT_MS));
+    TEST_ASSERT_EQUAL(SetpointSource::SAFETY, loop.GetActiveSource());
+}
+
+// Without a fresh source, throttle is cut while steering and brake hold their last values
+void test_no_fresh_source_holds_steering_and_brake() {
+    ControlLoop& loop = GetLoop();
+    loop.Submit(SetpointSource::AUTONOMY, ActuationSetpoint{3.0f, 0.25f, 0.4f});
+    Wait(APPLIED);
+    TEST_ASSERT_EQUAL_FLOAT(3.0f, GetLastOutput().throttle);
+
+    loop.Release(SetpointSource::AUTONOMY);
+    Wait(APPLIED);
+    TEST_ASSERT_EQUAL(SetpointSource::COUNT, loop.GetActiveSource());
+    const ActuationSetpoint held = GetLastOutput();
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, held.throttle);
+    TEST_ASSERT_EQUAL_FLOAT(0.25f, held.steering);
+    TEST_ASSERT_EQUAL_FLOAT(0.4f, held.brake);
+
+    // Still output every tick
+    const uint32_t outputs = g_Outputs;
+    Wait(APPLIED);
+    TEST_ASSERT_TRUE(g_Outputs > outputs);
+}
+
+// Every tick lands in one bucket, and readers never see a half-written histogram
+void test_jitter_histogram() {
+    ControlLoop& loop = GetLoop();
+    const ControlJitterStats before = loop.GetJitterStats();
+    TEST_ASSERT_EQUAL_UINT32(before.ticks, BucketSum(before));
+
+    std::atomic<bool> stop{false};
+    std::atomic<uint32_t> reads{0};
+    std::atomic<uint32_t> torn{0};
+    std::thread reader([&] {
+        while (!stop) {
+            const ControlJitterStats stats = loop.GetJitterStats();
+            if (BucketSum(stats) != stats.ticks) {
+                torn++;
+            }
+            reads++;
+        }
+    });
+
+    constexpr auto RUN = std::chrono::milliseconds(500);
+    Wait(RUN);
+    stop = true;
+    reader.join();
+
+    const ControlJitterStats after = loop.GetJitterStats();
+    const uint32_t ticks = after.ticks - before.ticks;
+    const uint32_t expected = std::chrono::microseconds(RUN).count() / CONTROL_LOOP_PERIOD_US;
+    char message[128];
+    snprintf(message, sizeof(message), "%u ticks in %lld ms, max jitter %u us, %u missed, %u reads",
+             ticks, static_cast<long long>(RUN.count()), after.maxJitterUs, after.missedTicks, reads.load());
+    TEST_MESSAGE(message);
+
+    TEST_ASSERT_EQUAL_UINT32(0, torn.load());
+    TEST_ASSERT_TRUE(reads > 0);
+    TEST_ASSERT_EQUAL_UINT32(after.ticks, BucketSum(after));
+    TEST_ASSERT_TRUE(ticks + after.missedTicks - before.missedTicks >= expected * 9 / 10);
+    TEST_ASSERT_TRUE(ticks <= expected + 2);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_source_priority);
+    RUN_TEST(test_source_timeouts);
+    RUN_TEST(test_no_fresh_source_holds_steering_and_brake);
+    RUN_TEST(test_jitter_histogram);
+    return UNITY_END();
+}
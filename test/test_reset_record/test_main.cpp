@@ -0,0 +1,188 @@
+/**
+ * @file test_main.cpp
+ * @brief Reset cause and watchable name recorded across an emulated reboot
+ *
+ * Each case runs in a child process, since a reset ends it and the IWDG
+ * cannot be stopped. The child's reset handler boots again as far as
+ * ReadResetReport, with the reset reason the hardware would report, and
+ * hands the report to the parent. The parent uses no shim threads, so
+ * forking it is safe.
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <unity.h>
+
+#include "mbed.h"
+#include "mbed_shim/host.hpp"
+
+#include "config.hpp"
+#include "Watchdog/reset_record.hpp"
+#include "Watchdog/watchdog.hpp"
+
+using namespace tritonai::gkc;
+
+namespace {
+
+    constexpr uint32_t LIMIT_MS = 50;
+    constexpr uint32_t RETRIGGER_MS = 20;
+    // Longer than any case takes: the IWDG needs HARDWARE_WATCHDOG_TIMEOUT_MS
+    constexpr auto CHILD_TIMEOUT = std::chrono::milliseconds(4 * HARDWARE_WATCHDOG_TIMEOUT_MS);
+
+    class NullLogger : public ILogger {
+    public:
+        void SendLog(const LogPacket::Severity&, const std::string&) override {}
+    };
+
+    // Can stop its watch thread, as priority inversion would
+    class StallableWatchdog : public tritonai::gkc::Watchdog {
+    public:
+        using Watchdog::Watchdog;
+
+        // The watch thread blocks on the lock when it rebuilds its deadlines
+        void Stall() {
+            m_Lock.lock();
+            m_WatchThread.flags_set(WATCHLIST_CHANGED_FLAG);
+        }
+    };
+
+    // A watchable that never kicks, so its callback runs after LIMIT_MS
+    class SilentWatchable : public Watchable {
+    public:
+        SilentWatchable(const char* name, Callback<void()> onTrigger) : Watchable(RETRIGGER_MS, LIMIT_MS, name) {
+            Attach(onTrigger);
+        }
+    };
+
+    int g_ReportPipe = -1;
+
+    // What the next boot reports, written to the parent
+    void Reboot() {
+        mbed_shim::SetResetReason(mbed_shim::HasWatchdogExpired() ? RESET_REASON_WATCHDOG : RESET_REASON_SOFTWARE);
+        const ResetReport report = ReadResetReport();
+        const ssize_t written = write(g_ReportPipe, &report, sizeof(report));
+        std::_Exit(written == static_cast<ssize_t>(sizeof(report)) ? 0 : 1);
+    }
+
+    /**
+     * @brief Run a case in a child process until it resets
+     * @param body Sets up the armed watchdog, the child then waits for the reset
+     * @param report The report after the reset
+     * @return False when the child never reset
+     */
+    bool RunUntilReset(void (*body)(StallableWatchdog& watchdog), ResetReport& report) {
+        int fds[2];
+        if (pipe(fds) != 0) {
+            return false;
+        }
+
+        const pid_t pid = fork();
+        if (pid == 0) {
+            close(fds[0]);
+            g_ReportPipe = fds[1];
+            mbed_shim::SetResetHandler(Reboot);
+
+            static NullLogger logger;
+            StallableWatchdog* watchdog = new StallableWatchdog(100, 1000, &logger);
+            body(*watchdog);
+            ThisThread::sleep_for(CHILD_TIMEOUT);
+            std::_Exit(2);
+        }
+
+        close(fds[1]);
+        size_t received = 0;
+        ssize_t n = 0;
+        while (received < sizeof(report) &&
+               (n = read(fds[0], reinterpret_cast<uint8_t*>(&report) + received, sizeof(report) - received)) > 0) {
+            received += static_cast<size_t>(n);
+        }
+        close(fds[0]);
+        int status = 0;
+        waitpid(pid, &status, 0);
+        return received == sizeof(report) && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    }
+
+    void Hang() {
+        while (true) {
+            ThisThread::sleep_for(std::chrono::seconds(1));
+        }
+    }
+
+    void Return() {}
+
+} // namespace
+
+void setUp() {}
+
+void tearDown() {}
+
+// The watch thread stops feeding the IWDG, nothing was recorded
+void test_stalled_watch_thread() {
+    ResetReport report;
+    TEST_ASSERT_TRUE(RunUntilReset([](StallableWatchdog& watchdog) {
+        watchdog.Arm();
+        ThisThread::sleep_for(std::chrono::milliseconds(2 * HARDWARE_WATCHDOG_FEED_MS));
+        watchdog.Stall();
+    }, report));
+    TEST_ASSERT_EQUAL_UINT8(RESET_REASON_WATCHDOG, report.hardwareReason);
+    TEST_ASSERT_EQUAL(ResetCause::HARDWARE_WATCHDOG, report.cause);
+    TEST_ASSERT_EQUAL_STRING("", report.name);
+}
+
+// A trigger callback that never returns: the IWDG resets, the record names the watchable
+void test_hanging_callback() {
+    ResetReport report;
+    TEST_ASSERT_TRUE(RunUntilReset([](StallableWatchdog& watchdog) {
+        watchdog.AddToWatchlist(new SilentWatchable("Steering", Hang));
+        watchdog.Arm();
+    }, report));
+    TEST_ASSERT_EQUAL_UINT8(RESET_REASON_WATCHDOG, report.hardwareReason);
+    TEST_ASSERT_EQUAL(ResetCause::WATCHABLE_TIMEOUT, report.cause);
+    TEST_ASSERT_EQUAL_STRING("Steering", report.name);
+}
+
+// A trigger callback that resets, the name truncated to the record
+void test_resetting_callback() {
+    ResetReport report;
+    TEST_ASSERT_TRUE(RunUntilReset([](StallableWatchdog& watchdog) {
+        watchdog.AddToWatchlist(new SilentWatchable("AVeryLongWatchableNameThatIsTruncated", NVIC_SystemReset));
+        watchdog.Arm();
+    }, report));
+    TEST_ASSERT_EQUAL_UINT8(RESET_REASON_SOFTWARE, report.hardwareReason);
+    TEST_ASSERT_EQUAL(ResetCause::WATCHABLE_TIMEOUT, report.cause);
+    TEST_ASSERT_EQUAL_STRING(std::string("AVeryLongWatchableNameThatIsTruncated")
+                                 .substr(0, RESET_RECORD_NAME_SIZE - 1).c_str(), report.name);
+}
+
+// A callback that returns clears the record and the IWDG stays fed, a later
+// reset is not blamed on the watchable
+void test_returning_callback_clears_record() {
+    ResetReport report;
+    TEST_ASSERT_TRUE(RunUntilReset([](StallableWatchdog& watchdog) {
+        watchdog.AddToWatchlist(new SilentWatchable("RCHeartbeat", Return));
+        watchdog.Arm();
+        // Retriggered every RETRIGGER_MS for longer than the IWDG timeout
+        ThisThread::sleep_for(std::chrono::milliseconds(HARDWARE_WATCHDOG_TIMEOUT_MS + 500));
+        NVIC_SystemReset();
+    }, report));
+    TEST_ASSERT_EQUAL_UINT8(RESET_REASON_SOFTWARE, report.hardwareReason);
+    TEST_ASSERT_EQUAL(ResetCause::SOFTWARE, report.cause);
+    TEST_ASSERT_EQUAL_STRING("", report.name);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_stalled_watch_thread);
+    RUN_TEST(test_hanging_callback);
+    RUN_TEST(test_resetting_callback);
+    RUN_TEST(test_returning_callback_clears_record);
+    return UNITY_END();
+}
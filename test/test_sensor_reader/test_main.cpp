@@ -0,0 +1,145 @@
+/**
+ * @file test_main.cpp
+ * @brief SensorReader polling, provider removal and pushed updates
+ *
+ * SensorReader's poll thread never exits, so every test leaks its reader
+ * instead of destroying it under the running thread.
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#include <atomic>
+#include <chrono>
+
+#include <unity.h>
+
+#include "mbed.h"
+
+#include "config.hpp"
+#include "Sensor/sensor_reader.hpp"
+
+using namespace tritonai::gkc;
+
+namespace {
+
+    class NullLogger : public ILogger {
+    public:
+        void SendLog(const LogPacket::Severity&, const std::string&) override {}
+    };
+
+    NullLogger g_Logger;
+
+    // Writes a counter into the brake pressure, stamped with the read time
+    class FakeProvider : public ISensorProvider {
+    public:
+        bool IsReady() override { return m_Ready; }
+
+        void PopulateReading(SensorGkcPacket& pkt, SensorTimestamps& stamps) override {
+            pkt.values.brake_pressure = static_cast<float>(++m_Reads);
+            stamps.brakePressureUs = us_ticker_read();
+        }
+
+        void AttachUpdateNotifier(Callback<void()> notify) override { m_Notify = notify; }
+
+        bool TakeUpdate() override { return m_Pushed.exchange(false); }
+
+        // Push a reading like a CAN feedback provider does
+        void Push() {
+            m_Pushed = true;
+            if (m_Notify) {
+                m_Notify();
+            }
+        }
+
+        uint32_t GetReads() const { return m_Reads; }
+        void SetReady(bool ready) { m_Ready = ready; }
+
+    private:
+        std::atomic<bool> m_Ready{true};
+        std::atomic<bool> m_Pushed{false};
+        std::atomic<uint32_t> m_Reads{0};
+        Callback<void()> m_Notify;
+    };
+
+} // namespace
+
+void setUp() {}
+
+void tearDown() {}
+
+// A ready provider is read every poll interval and published with its stamps
+void test_polled_provider_is_published() {
+    SensorReader* reader = new SensorReader(&g_Logger);
+    FakeProvider* provider = new FakeProvider();
+    reader->SetPollInterval(std::chrono::milliseconds(10));
+    const uint32_t startUs = us_ticker_read();
+    reader->RegisterProvider(provider);
+
+    TEST_ASSERT_TRUE(reader->WaitForUpdate(std::chrono::milliseconds(100)));
+    const SensorSnapshot snapshot = reader->GetSnapshot();
+    TEST_ASSERT_TRUE(snapshot.packet.values.brake_pressure >= 1.0f);
+    TEST_ASSERT_TRUE(static_cast<int32_t>(snapshot.stamps.brakePressureUs - startUs) >= 0);
+    TEST_ASSERT_EQUAL_UINT32(0, snapshot.stamps.steeringAngleUs); // never captured
+
+    ThisThread::sleep_for(std::chrono::milliseconds(100));
+    TEST_ASSERT_UINT32_WITHIN(5, 10, provider->GetReads());
+}
+
+// A provider that is not ready is skipped and nothing is published
+void test_provider_not_ready_is_skipped() {
+    SensorReader* reader = new SensorReader(&g_Logger);
+    FakeProvider* provider = new FakeProvider();
+    provider->SetReady(false);
+    reader->SetPollInterval(std::chrono::milliseconds(5));
+    reader->RegisterProvider(provider);
+
+    TEST_ASSERT_FALSE(reader->WaitForUpdate(std::chrono::milliseconds(50)));
+    TEST_ASSERT_EQUAL_UINT32(0, provider->GetReads());
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, reader->GetPacket().values.brake_pressure);
+}
+
+// A removed provider is no longer read
+void test_removed_provider_is_not_read() {
+    SensorReader* reader = new SensorReader(&g_Logger);
+    FakeProvider* provider = new FakeProvider();
+    reader->SetPollInterval(std::chrono::milliseconds(5));
+    reader->RegisterProvider(provider);
+    TEST_ASSERT_TRUE(reader->WaitForUpdate(std::chrono::milliseconds(100)));
+
+    reader->RemoveProvider(provider);
+    ThisThread::sleep_for(std::chrono::milliseconds(10)); // a poll in progress finishes
+    const uint32_t reads = provider->GetReads();
+    ThisThread::sleep_for(std::chrono::milliseconds(50));
+    TEST_ASSERT_EQUAL_UINT32(reads, provider->GetReads());
+}
+
+// With SENSOR_EVENT_DRIVEN, a push is published without waiting for the poll
+void test_pushed_update_wakes_the_reader() {
+#ifndef SENSOR_EVENT_DRIVEN
+    TEST_IGNORE_MESSAGE("SENSOR_EVENT_DRIVEN is not defined, providers are only polled");
+#else
+    SensorReader* reader = new SensorReader(&g_Logger);
+    FakeProvider* provider = new FakeProvider();
+    reader->RegisterProvider(provider);
+    TEST_ASSERT_TRUE(reader->WaitForUpdate(std::chrono::milliseconds(100)));
+
+    // After the poll already scheduled, the thread sleeps 500 ms between polls
+    reader->SetPollInterval(std::chrono::milliseconds(500));
+    ThisThread::sleep_for(std::chrono::milliseconds(2 * SEND_SENSOR_INTERVAL_MS));
+    reader->WaitForUpdate(std::chrono::milliseconds(0));
+
+    const uint32_t pushUs = us_ticker_read();
+    provider->Push();
+    TEST_ASSERT_TRUE(reader->WaitForUpdate(std::chrono::milliseconds(50)));
+    TEST_ASSERT_LESS_THAN_UINT32(50000, us_ticker_read() - pushUs);
+#endif
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_polled_provider_is_published);
+    RUN_TEST(test_provider_not_ready_is_skipped);
+    RUN_TEST(test_removed_provider_is_not_read);
+    RUN_TEST(test_pushed_update_wakes_the_reader);
+    return UNITY_END();
+}
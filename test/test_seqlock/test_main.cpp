@@ -0,0 +1,201 @@
+/**
+ * @file test_main.cpp
+ * @brief Seqlock stress: torn reads under a concurrent writer, and readers preempting it
+ *
+ * A snapshot is consistent when every word holds the same write counter.
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include <unity.h>
+
+#include "mbed.h"
+
+#include "Tools/seqlock.hpp"
+
+using namespace tritonai::gkc;
+
+namespace {
+
+    constexpr size_t WORDS = 32; // 128 bytes, larger than a SensorSnapshot
+    constexpr int READER_THREADS = 3;
+    constexpr auto STRESS_TIME = std::chrono::milliseconds(500);
+
+    // Called halfway through a copy, to run a reader while the writer is mid-update
+    thread_local void (*t_MidCopyHook)() = nullptr;
+
+    struct Payload {
+        uint32_t words[WORDS];
+
+        Payload() {
+            Fill(0);
+        }
+
+        Payload(const Payload& other) = default;
+
+        Payload& operator=(const Payload& other) {
+            for (size_t i = 0; i < WORDS; i++) {
+                words[i] = other.words[i];
+                if (i == WORDS / 2 && t_MidCopyHook != nullptr) {
+                    void (*hook)() = t_MidCopyHook;
+                    t_MidCopyHook = nullptr; // the reader's own copies run through here too
+                    hook();
+                }
+            }
+            return *this;
+        }
+
+        void Fill(uint32_t value) {
+            for (uint32_t& word : words) {
+                word = value;
+            }
+        }
+
+        bool IsConsistent() const {
+            for (uint32_t word : words) {
+                if (word != words[0]) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+
+    Seqlock<Payload> g_Preempted;
+    Payload g_PreemptedRead;
+
+    void ReadPreempted() {
+        g_PreemptedRead = g_Preempted.Read();
+    }
+
+    void Report(const char* what, double value, const char* unit) {
+        char message[96];
+        snprintf(message, sizeof(message), "%s: %.1f %s", what, value, unit);
+        TEST_MESSAGE(message);
+    }
+
+} // namespace
+
+void setUp() {}
+
+void tearDown() {}
+
+// Reader threads racing a writer never see a torn or older value
+void test_concurrent_readers_see_consistent_snapshots() {
+    Seqlock<Payload> seqlock;
+    std::atomic<bool> running{true};
+    std::atomic<uint64_t> reads{0};
+    std::atomic<uint64_t> torn{0};
+    std::atomic<uint64_t> backwards{0};
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < READER_THREADS; i++) {
+        readers.emplace_back([&] {
+            uint32_t last = 0;
+            uint64_t count = 0;
+            while (running.load(std::memory_order_relaxed)) {
+                const Payload snapshot = seqlock.Read();
+                if (!snapshot.IsConsistent()) {
+                    torn++;
+                } else if (snapshot.words[0] < last) {
+                    backwards++;
+                } else {
+                    last = snapshot.words[0];
+                }
+                count++;
+            }
+            reads += count;
+        });
+    }
+
+    uint32_t writes = 0;
+    Payload value;
+    const auto start = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() - start < STRESS_TIME) {
+        value.Fill(++writes);
+        seqlock.Write(value);
+    }
+    running = false;
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+
+    const double ns = std::chrono::duration<double, std::nano>(STRESS_TIME).count();
+    Report("writes", writes, "");
+    Report("reads", static_cast<double>(reads.load()), "");
+    Report("time per read, per reader thread", ns * READER_THREADS / static_cast<double>(reads.load()), "ns");
+    TEST_ASSERT_EQUAL_UINT32(writes, seqlock.GetVersion());
+    TEST_ASSERT_GREATER_THAN(0, static_cast<long long>(reads.load()));
+    TEST_ASSERT_EQUAL(0, static_cast<long long>(torn.load()));
+    TEST_ASSERT_EQUAL(0, static_cast<long long>(backwards.load()));
+}
+
+// A reader that runs while the writer is halfway through a copy, as an ISR or
+// a higher priority thread on the single core would, returns at once with a
+// complete value: the previous one during the first copy, the new one during
+// the second. It would hang here if it waited for the writer.
+void test_reader_preempting_the_writer() {
+    Payload first;
+    first.Fill(1);
+    g_Preempted.Write(first);
+
+    Payload second;
+    second.Fill(2);
+    t_MidCopyHook = ReadPreempted; // the first copy of this Write
+    g_Preempted.Write(second);
+    TEST_ASSERT_TRUE(g_PreemptedRead.IsConsistent());
+    TEST_ASSERT_EQUAL_UINT32(1, g_PreemptedRead.words[0]);
+
+    // Into the second copy: the hook fires on the first, re-arms for the second
+    Payload third;
+    third.Fill(3);
+    t_MidCopyHook = [] {
+        t_MidCopyHook = ReadPreempted;
+    };
+    g_Preempted.Write(third);
+    TEST_ASSERT_TRUE(g_PreemptedRead.IsConsistent());
+    TEST_ASSERT_EQUAL_UINT32(3, g_PreemptedRead.words[0]);
+
+    TEST_ASSERT_EQUAL_UINT32(3, g_Preempted.Read().words[0]);
+}
+
+// An interrupt-context reader against a writer thread
+void test_isr_reader() {
+    static Seqlock<Payload> seqlock;
+    static std::atomic<uint32_t> isrReads{0};
+    static std::atomic<uint32_t> isrTorn{0};
+
+    Ticker ticker;
+    ticker.attach([] {
+        if (!seqlock.Read().IsConsistent()) {
+            isrTorn++;
+        }
+        isrReads++;
+    }, std::chrono::microseconds(50));
+
+    Payload value;
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 1; std::chrono::steady_clock::now() - start < STRESS_TIME / 5; i++) {
+        value.Fill(i);
+        seqlock.Write(value);
+    }
+    ticker.detach();
+
+    Report("interrupt context reads", isrReads.load(), "");
+    TEST_ASSERT_GREATER_THAN_UINT32(0, isrReads.load());
+    TEST_ASSERT_EQUAL_UINT32(0, isrTorn.load());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_concurrent_readers_see_consistent_snapshots);
+    RUN_TEST(test_reader_preempting_the_writer);
+    RUN_TEST(test_isr_reader);
+    return UNITY_END();
+}
@@ -0,0 +1,186 @@
+/**
+ * @file test_main.cpp
+ * @brief Timing of the host shim's timers, serial line and CAN bus
+ *
+ * The bounds are loose enough for a loaded CI machine; the measured values
+ * are printed so that regressions in the shim's timing show up in the log.
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#include <atomic>
+#include <cstdio>
+#include <thread>
+
+#include <unity.h>
+
+#include "mbed.h"
+#include "mbed_shim/host.hpp"
+
+namespace {
+
+    // Pins no firmware module under test uses
+    constexpr PinName TEST_UART_TX = PA_0;
+    constexpr PinName TEST_UART_RX = PA_1;
+    constexpr PinName TEST_CAN_RD = PD_0;
+    constexpr PinName TEST_CAN_TD = PD_1;
+
+    void Report(const char* what, double value, const char* unit) {
+        char message[96];
+        snprintf(message, sizeof(message), "%s: %.1f %s", what, value, unit);
+        TEST_MESSAGE(message);
+    }
+
+} // namespace
+
+void setUp() {}
+
+void tearDown() {}
+
+// A 5 ms Ticker keeps its phase, so the tick count follows the clock
+void test_ticker_period() {
+    constexpr uint32_t PERIOD_US = 5000;
+    constexpr uint32_t TICKS = 200;
+    std::atomic<uint32_t> ticks{0};
+    std::atomic<uint32_t> maxLateUs{0};
+    const uint32_t startUs = us_ticker_read();
+
+    Ticker ticker;
+    ticker.attach([&] {
+        const uint32_t tick = ++ticks;
+        const uint32_t lateUs = us_ticker_read() - (startUs + tick * PERIOD_US);
+        if (static_cast<int32_t>(lateUs) > static_cast<int32_t>(maxLateUs.load())) {
+            maxLateUs = lateUs;
+        }
+    }, std::chrono::microseconds(PERIOD_US));
+    ThisThread::sleep_for(std::chrono::milliseconds(TICKS * PERIOD_US / 1000 + PERIOD_US / 2000));
+    ticker.detach();
+
+    Report("ticks in 1 s", ticks.load(), "");
+    Report("max tick jitter", maxLateUs.load(), "us");
+    TEST_ASSERT_UINT32_WITHIN(2, TICKS, ticks.load());
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(PERIOD_US, maxLateUs.load());
+}
+
+// Timeout is not rounded to the 1 ms RTOS tick
+void test_timeout_below_one_tick() {
+    constexpr uint32_t DELAY_US = 300;
+    EventFlags flags;
+    Timeout timeout;
+    const uint32_t startUs = us_ticker_read();
+    std::atomic<uint32_t> firedUs{0};
+
+    timeout.attach([&] {
+        firedUs = us_ticker_read();
+        flags.set(1);
+    }, std::chrono::microseconds(DELAY_US));
+    TEST_ASSERT_FALSE(flags.wait_any_for(1, std::chrono::milliseconds(100)) & osFlagsError);
+
+    const uint32_t elapsedUs = firedUs.load() - startUs;
+    Report("300 us Timeout fired after", elapsedUs, "us");
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(DELAY_US, elapsedUs);
+    TEST_ASSERT_LESS_THAN_UINT32(1000, elapsedUs);
+}
+
+// Bytes leave at 10 bits per byte and are delivered as they complete
+void test_serial_line_time() {
+    constexpr size_t SIZE = 100;
+    UnbufferedSerial serial(TEST_UART_TX, TEST_UART_RX, 115200);
+    std::atomic<size_t> received{0};
+    std::atomic<uint32_t> lastUs{0};
+    mbed_shim::SetSerialTxListener(TEST_UART_TX, [&](const uint8_t*, size_t len) {
+        received += len;
+        lastUs = us_ticker_read();
+    });
+
+    uint8_t data[SIZE] = {};
+    const uint32_t startUs = us_ticker_read();
+    size_t written = 0;
+    while (written < SIZE) {
+        // The 16 byte FIFO takes what it can, like an unbuffered write in a loop
+        if (serial.writable()) {
+            written += serial.write(data + written, 1);
+        }
+    }
+    for (int i = 0; i < 100 && received.load() < SIZE; i++) {
+        ThisThread::sleep_for(std::chrono::milliseconds(1));
+    }
+    mbed_shim::SetSerialTxListener(TEST_UART_TX, nullptr);
+
+    const uint32_t elapsedUs = lastUs.load() - startUs;
+    const uint32_t lineUs = SIZE * 10 * 1000000 / 115200;
+    Report("100 B at 115200 baud", elapsedUs, "us");
+    TEST_ASSERT_EQUAL_size_t(SIZE, received.load());
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(lineUs, elapsedUs);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(lineUs + 2000, elapsedUs);
+}
+
+// A frame completes on the bus after its wire time
+void test_can_frame_time() {
+    CAN sender(TEST_CAN_RD, TEST_CAN_TD, 500000);
+    std::atomic<uint32_t> doneUs{0};
+    mbed_shim::SetCanListener(TEST_CAN_RD, [&](const CANMessage&, uint32_t stampUs) { doneUs = stampUs; });
+
+    const uint8_t data[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    const uint32_t startUs = us_ticker_read();
+    TEST_ASSERT_EQUAL_INT(1, sender.write(CANMessage(0x1234, data, 8, CANData, CANExtended)));
+    for (int i = 0; i < 100 && doneUs.load() == 0; i++) {
+        ThisThread::sleep_for(std::chrono::milliseconds(1));
+    }
+    mbed_shim::SetCanListener(TEST_CAN_RD, nullptr);
+
+    // 67 + 64 bits at 500 kbit/s, no bit stuffing
+    const uint32_t wireUs = (67 + 64) * 2;
+    const uint32_t elapsedUs = doneUs.load() - startUs;
+    Report("8 byte extended frame on the bus after", elapsedUs, "us");
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(wireUs, elapsedUs);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(wireUs + 2000, elapsedUs);
+}
+
+// Only frames that pass a filter reach the RX FIFO and raise RxIrq
+void test_can_filter_and_rx_irq() {
+    CAN sender(TEST_CAN_RD, TEST_CAN_TD, 500000);
+    CAN receiver(TEST_CAN_RD, TEST_CAN_TD, 500000);
+    std::atomic<uint32_t> rxIrqs{0};
+    receiver.filter(0x100, 0x7F0, CANStandard);
+    receiver.attach([&] { rxIrqs++; }, CAN::RxIrq);
+
+    const uint8_t data[2] = {0xAB, 0xCD};
+    sender.write(CANMessage(0x105, data, 2)); // passes the filter
+    sender.write(CANMessage(0x205, data, 2)); // filtered out
+    ThisThread::sleep_for(std::chrono::milliseconds(10));
+    receiver.attach(nullptr, CAN::RxIrq);
+
+    CANMessage msg;
+    TEST_ASSERT_EQUAL_INT(1, receiver.read(msg));
+    TEST_ASSERT_EQUAL_UINT32(0x105, msg.id);
+    TEST_ASSERT_EQUAL_UINT8(0xCD, msg.data[1]);
+    TEST_ASSERT_EQUAL_INT(0, receiver.read(msg));
+    TEST_ASSERT_EQUAL_UINT32(1, rxIrqs.load());
+}
+
+// Interrupt context runs in time order, after the requested delay
+void test_raise_irq_delay() {
+    std::atomic<uint32_t> order{0};
+    std::atomic<uint32_t> first{0};
+    std::atomic<uint32_t> second{0};
+    const uint32_t startUs = us_ticker_read();
+    mbed_shim::RaiseIrq([&] { second = ++order; }, 2000);
+    mbed_shim::RaiseIrq([&] { first = ++order; }, 500);
+    ThisThread::sleep_for(std::chrono::milliseconds(10));
+
+    TEST_ASSERT_EQUAL_UINT32(1, first.load());
+    TEST_ASSERT_EQUAL_UINT32(2, second.load());
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(2000, us_ticker_read() - startUs);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_ticker_period);
+    RUN_TEST(test_timeout_below_one_tick);
+    RUN_TEST(test_serial_line_time);
+    RUN_TEST(test_can_frame_time);
+    RUN_TEST(test_can_filter_and_rx_irq);
+    RUN_TEST(test_raise_irq_delay);
+    return UNITY_END();
+}
@@ -0,0 +1,150 @@
+/**
+ * @file test_main.cpp
+ * @brief GkcStateMachine transitions, handler results and the status LED
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#include <unity.h>
+
+#include "mbed.h"
+#include "mbed_shim/host.hpp"
+
+#include "StateMachine/state_machine.hpp"
+
+using namespace tritonai::gkc;
+
+namespace {
+
+    // Thrown by the reset handler, so NVIC_SystemReset does not end the test
+    struct ResetRequested {};
+
+    // Handlers return a scripted result and record the state they ran in
+    class ScriptedStateMachine : public GkcStateMachine {
+    public:
+        StateTransitionResult result{StateTransitionResult::SUCCESS};
+        GkcLifecycle handlerState{GkcLifecycle::Uninitialized};
+        int handlerCalls{0};
+
+    protected:
+        StateTransitionResult OnInitialize(const GkcLifecycle& lastState) override { return Run(lastState); }
+        StateTransitionResult OnDeactivate(const GkcLifecycle& lastState) override { return Run(lastState); }
+        StateTransitionResult OnActivate(const GkcLifecycle& lastState) override { return Run(lastState); }
+        StateTransitionResult OnEmergencyStop(const GkcLifecycle& lastState) override { return Run(lastState); }
+        StateTransitionResult OnReinitialize(const GkcLifecycle& lastState) override { return Run(lastState); }
+
+    private:
+        StateTransitionResult Run(const GkcLifecycle& lastState) {
+            handlerState = lastState;
+            handlerCalls++;
+            return result;
+        }
+    };
+
+} // namespace
+
+void setUp() {}
+
+void tearDown() {}
+
+// Uninitialized -> Inactive -> Active -> Inactive, LED on only while Active
+void test_lifecycle_and_led() {
+    ScriptedStateMachine machine;
+    TEST_ASSERT_EQUAL(GkcLifecycle::Uninitialized, machine.GetState());
+    TEST_ASSERT_EQUAL_INT(1, mbed_shim::GetPin(LED3));
+
+    TEST_ASSERT_EQUAL(StateTransitionResult::SUCCESS, machine.Initialize());
+    TEST_ASSERT_EQUAL(GkcLifecycle::Initializing, machine.handlerState);
+    TEST_ASSERT_EQUAL(GkcLifecycle::Inactive, machine.GetState());
+
+    TEST_ASSERT_EQUAL(StateTransitionResult::SUCCESS, machine.Activate());
+    TEST_ASSERT_EQUAL(GkcLifecycle::Active, machine.GetState());
+    TEST_ASSERT_EQUAL_INT(0, mbed_shim::GetPin(LED3));
+
+    TEST_ASSERT_EQUAL(StateTransitionResult::SUCCESS, machine.Deactivate());
+    TEST_ASSERT_EQUAL(GkcLifecycle::Inactive, machine.GetState());
+    TEST_ASSERT_EQUAL_INT(1, mbed_shim::GetPin(LED3));
+}
+
+// Transitions from the wrong state fail without calling the handler
+void test_invalid_transitions() {
+    ScriptedStateMachine machine;
+    TEST_ASSERT_EQUAL(StateTransitionResult::FAILURE_INVALID_TRANSITION, machine.Activate());
+    TEST_ASSERT_EQUAL(StateTransitionResult::FAILURE_INVALID_TRANSITION, machine.Deactivate());
+    TEST_ASSERT_EQUAL(StateTransitionResult::FAILURE_INVALID_TRANSITION, machine.EmergencyStop());
+    TEST_ASSERT_EQUAL_INT(0, machine.handlerCalls);
+
+    machine.Initialize();
+    TEST_ASSERT_EQUAL(StateTransitionResult::FAILURE_INVALID_TRANSITION, machine.Initialize());
+    TEST_ASSERT_EQUAL(StateTransitionResult::FAILURE_INVALID_TRANSITION, machine.Reinitialize());
+    TEST_ASSERT_EQUAL(StateTransitionResult::FAILURE_INVALID_TRANSITION, machine.Deactivate());
+    TEST_ASSERT_EQUAL(GkcLifecycle::Inactive, machine.GetState());
+}
+
+// A failing handler leaves the state where it was
+void test_failed_transition_keeps_state() {
+    ScriptedStateMachine machine;
+    machine.result = StateTransitionResult::FAILURE;
+    TEST_ASSERT_EQUAL(StateTransitionResult::FAILURE, machine.Initialize());
+    TEST_ASSERT_EQUAL(GkcLifecycle::Uninitialized, machine.GetState());
+
+    machine.result = StateTransitionResult::SUCCESS;
+    machine.Initialize();
+    machine.result = StateTransitionResult::FAILURE;
+    TEST_ASSERT_EQUAL(StateTransitionResult::FAILURE, machine.Activate());
+    TEST_ASSERT_EQUAL(GkcLifecycle::Inactive, machine.GetState());
+}
+
+// A handler asking for an emergency stop ends in Emergency
+void test_handler_emergency_stop() {
+    ScriptedStateMachine machine;
+    machine.Initialize();
+    machine.result = StateTransitionResult::EMERGENCY_STOP;
+    TEST_ASSERT_EQUAL(StateTransitionResult::EMERGENCY_STOP, machine.Activate());
+    TEST_ASSERT_EQUAL(GkcLifecycle::Emergency, machine.GetState());
+    TEST_ASSERT_EQUAL_INT(1, mbed_shim::GetPin(LED3));
+}
+
+// EmergencyStop runs its handler in Emergency; success recovers to Inactive
+void test_emergency_stop_recovers_to_inactive() {
+    ScriptedStateMachine machine;
+    machine.Initialize();
+    machine.Activate();
+
+    machine.result = StateTransitionResult::FAILURE;
+    TEST_ASSERT_EQUAL(StateTransitionResult::FAILURE, machine.EmergencyStop());
+    TEST_ASSERT_EQUAL(GkcLifecycle::Emergency, machine.handlerState);
+    TEST_ASSERT_EQUAL(GkcLifecycle::Emergency, machine.GetState());
+
+    machine.result = StateTransitionResult::SUCCESS;
+    TEST_ASSERT_EQUAL(StateTransitionResult::SUCCESS, machine.EmergencyStop());
+    TEST_ASSERT_EQUAL(GkcLifecycle::Inactive, machine.GetState());
+}
+
+// An emergency stop handler error resets the MCU
+void test_emergency_stop_error_resets() {
+    ScriptedStateMachine machine;
+    machine.Initialize();
+    machine.result = StateTransitionResult::ERROR;
+
+    bool reset = false;
+    mbed_shim::SetResetHandler([] { throw ResetRequested(); });
+    try {
+        machine.EmergencyStop();
+    } catch (const ResetRequested&) {
+        reset = true;
+    }
+    mbed_shim::SetResetHandler(nullptr);
+    TEST_ASSERT_TRUE(reset);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_lifecycle_and_led);
+    RUN_TEST(test_invalid_transitions);
+    RUN_TEST(test_failed_transition_keeps_state);
+    RUN_TEST(test_handler_emergency_stop);
+    RUN_TEST(test_emergency_stop_recovers_to_inactive);
+    RUN_TEST(test_emergency_stop_error_resets);
+    return UNITY_END();
+}
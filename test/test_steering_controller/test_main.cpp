@@ -0,0 +1,252 @@
+/**
+ * @file test_main.cpp
+ * @brief SteeringController on a second-order steering plant, in both modes
+ *
+ * The plant is the steering VESC's position loop, an underdamped second-order
+ * response of the motor angle to its SET_POS setpoint, loaded by a centering
+ * spring so it settles short of the setpoint. It runs in simulated time and
+ * reports the wheel angle to OnFeedback every FEEDBACK_PERIOD_US, as STATUS_4
+ * would. Setpoints are read back from the CAN bus. The CAN receive thread
+ * never exits, so CAN is initialized once for all cases.
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include <unity.h>
+
+#include "mbed.h"
+#include "mbed_shim/host.hpp"
+
+#include "config.hpp"
+#include "Actuation/steering_controller.hpp"
+#include "Actuation/vesc_can_tools.hpp"
+
+using namespace tritonai::gkc;
+
+namespace {
+
+    constexpr uint32_t FEEDBACK_PERIOD_US = 10000;
+    constexpr uint32_t PLANT_STEPS_PER_FEEDBACK = 10;
+    constexpr float NATURAL_FREQ = 30.0f;  // rad/s, motor angle to its setpoint
+    constexpr float DAMPING = 0.45f;
+    constexpr float SPRING_SHARE = 0.1f;   // centering load, the VESC alone settles 9% short
+    constexpr float STEP_TARGET = 0.2f;    // wheel rad
+    constexpr float SETTLE_BAND = 0.01f;   // wheel rad
+    constexpr int RUN_FEEDBACKS = 200;     // 2 s
+    constexpr auto FRAME_TIMEOUT = std::chrono::milliseconds(50);
+
+    // Most recent steering setpoint on the bus, motor rad without the encoder offset
+    std::atomic<float> g_MotorSetpoint{0.0f};
+    std::atomic<uint32_t> g_SetpointFrames{0};
+
+    void InitCanOnce() {
+        static bool initialized = [] {
+            mbed_shim::SetCanListener(CAN2_RX, [](const CANMessage& msg, uint32_t) {
+                if (msg.format == CANExtended && (msg.id & 0xFF) == STEER_CAN_ID &&
+                    (msg.id >> 8) == CAN_PACKET_SET_POS && msg.len >= 4) {
+                    // CommCanSetPos sends the negated angle in millionths of a degree
+                    int32_t index = 0;
+                    const float deg = -BufferGetInt32(msg.data, &index) / 1e6f;
+                    g_MotorSetpoint = deg * static_cast<float>(M_PI) / 180.0f - ENCODER_OFFSET;
+                    g_SetpointFrames++;
+                }
+            });
+            InitializeCan();
+            return true;
+        }();
+        (void)initialized;
+    }
+
+    // Waits for a setpoint frame after frames were seen, false if none came
+    bool WaitForSetpoint(uint32_t frames) {
+        const auto deadline = std::chrono::steady_clock::now() + FRAME_TIMEOUT;
+        while (g_SetpointFrames == frames) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+            ThisThread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+
+    class SteeringPlant {
+    public:
+        void Step(float motorSetpoint, float dtS) {
+            const float accel = NATURAL_FREQ * NATURAL_FREQ *
+                                    (motorSetpoint - m_Motor - SPRING_SHARE * m_Motor) -
+                                2.0f * DAMPING * NATURAL_FREQ * m_Rate;
+            m_Rate += accel * dtS;
+            m_Motor += m_Rate * dtS;
+        }
+
+        float GetWheelAngle() const { return MapMotor2Steer(m_Motor); }
+
+    private:
+        float m_Motor{0.0f};
+        float m_Rate{0.0f};
+    };
+
+    struct StepResponse {
+        float overshoot;  // wheel rad past the target
+        float settleS;    // time after which the angle stays within SETTLE_BAND of its final value
+        float finalError; // wheel rad
+    };
+
+    /**
+     * @brief Step the target from 0 and run the loop for RUN_FEEDBACKS feedback periods
+     */
+    StepResponse RunStep(SteeringController& controller, float target) {
+        SteeringPlant plant;
+        uint32_t stampUs = 1000000;
+        uint32_t frames = g_SetpointFrames;
+        controller.Command(target);
+        TEST_ASSERT_TRUE(WaitForSetpoint(frames));
+
+        std::vector<float> wheelAngles;
+        const float dtS = FEEDBACK_PERIOD_US / 1e6f / PLANT_STEPS_PER_FEEDBACK;
+        for (int i = 0; i < RUN_FEEDBACKS; i++) {
+            const float setpoint = g_MotorSetpoint;
+            for (uint32_t k = 0; k < PLANT_STEPS_PER_FEEDBACK; k++) {
+                plant.Step(setpoint, dtS);
+            }
+            stampUs += FEEDBACK_PERIOD_US;
+
+            const float wheel = plant.GetWheelAngle();
+            wheelAngles.push_back(wheel);
+
+            frames = g_SetpointFrames;
+            controller.OnFeedback(wheel, stampUs);
+            if (controller.GetMode() == SteeringMode::MCU_PID) {
+                TEST_ASSERT_TRUE(WaitForSetpoint(frames));
+            }
+        }
+
+        StepResponse response{0.0f, 0.0f, wheelAngles.back() - target};
+        for (size_t i = 0; i < wheelAngles.size(); i++) {
+            response.overshoot = std::fmax(response.overshoot, wheelAngles[i] - target);
+            if (std::fabs(wheelAngles[i] - wheelAngles.back()) > SETTLE_BAND) {
+                response.settleS = (i + 1) * FEEDBACK_PERIOD_US / 1e6f;
+            }
+        }
+        return response;
+    }
+
+    void Report(const char* mode, const StepResponse& response) {
+        char message[128];
+        snprintf(message, sizeof(message), "%s: overshoot %.4f rad, settled within %.2f rad after %.2f s, final error %.4f rad",
+                 mode, response.overshoot, SETTLE_BAND, response.settleS, response.finalError);
+        TEST_MESSAGE(message);
+    }
+
+} // namespace
+
+void setUp() {
+    InitCanOnce();
+}
+
+void tearDown() {}
+
+// The VESC loop alone: the plant's own overshoot, and it settles short of the target
+void test_vesc_position_step() {
+    SteeringController controller;
+    controller.SetMode(SteeringMode::VESC_POSITION);
+    const StepResponse response = RunStep(controller, STEP_TARGET);
+    Report("VESC_POSITION", response);
+
+    TEST_ASSERT_TRUE(response.overshoot < 0.25f * STEP_TARGET);
+    TEST_ASSERT_TRUE(response.settleS < 0.5f);
+    TEST_ASSERT_TRUE(response.finalError < -SETTLE_BAND / 2);
+    TEST_ASSERT_TRUE(response.finalError > -SPRING_SHARE * STEP_TARGET);
+}
+
+// The MCU loop removes the spring's offset within the same overshoot and settling bounds
+void test_mcu_pid_step() {
+    SteeringController controller;
+    controller.SetMode(SteeringMode::MCU_PID);
+    const StepResponse response = RunStep(controller, STEP_TARGET);
+    Report("MCU_PID", response);
+
+    TEST_ASSERT_TRUE(response.overshoot < 0.25f * STEP_TARGET);
+    TEST_ASSERT_TRUE(response.settleS < 0.5f);
+    TEST_ASSERT_TRUE(std::fabs(response.finalError) < 0.1f * SETTLE_BAND);
+}
+
+// Feedback before any target sends nothing, a target keeps being driven without new commands
+void test_feedback_without_new_target() {
+    SteeringController controller;
+    controller.SetMode(SteeringMode::MCU_PID);
+
+    uint32_t frames = g_SetpointFrames;
+    controller.OnFeedback(0.05f, 1000000);
+    TEST_ASSERT_FALSE(WaitForSetpoint(frames));
+
+    frames = g_SetpointFrames;
+    controller.Command(STEP_TARGET);
+    TEST_ASSERT_TRUE(WaitForSetpoint(frames));
+
+    // Standing short of the target, the integral keeps adding to the correction
+    float last = 0.0f;
+    for (int i = 0; i < 5; i++) {
+        frames = g_SetpointFrames;
+        controller.OnFeedback(STEP_TARGET - 0.02f, 2000000 + i * FEEDBACK_PERIOD_US);
+        TEST_ASSERT_TRUE(WaitForSetpoint(frames));
+        const float setpoint = g_MotorSetpoint;
+        TEST_ASSERT_TRUE(setpoint > MapSteer2Motor(STEP_TARGET));
+        if (i > 1) {
+            TEST_ASSERT_TRUE(setpoint > last);
+        }
+        last = setpoint;
+    }
+}
+
+// New gains take effect on the next feedback, and the loop restarts without a kick
+void test_gains_updated_while_running() {
+    SteeringController controller;
+    controller.SetMode(SteeringMode::MCU_PID);
+
+    SteeringPlant plant;
+    uint32_t frames = g_SetpointFrames;
+    controller.Command(STEP_TARGET);
+    TEST_ASSERT_TRUE(WaitForSetpoint(frames));
+    uint32_t stampUs = 1000000;
+    for (int i = 0; i < RUN_FEEDBACKS / 2; i++) {
+        const float setpoint = g_MotorSetpoint;
+        for (uint32_t k = 0; k < PLANT_STEPS_PER_FEEDBACK; k++) {
+            plant.Step(setpoint, FEEDBACK_PERIOD_US / 1e6f / PLANT_STEPS_PER_FEEDBACK);
+        }
+        stampUs += FEEDBACK_PERIOD_US;
+        frames = g_SetpointFrames;
+        controller.OnFeedback(plant.GetWheelAngle(), stampUs);
+        TEST_ASSERT_TRUE(WaitForSetpoint(frames));
+    }
+
+    // Feedforward only: the setpoint is the mapped target, the integral is gone
+    controller.SetGains(SteeringGains{0.0f, 0.0f, 0.0f, 1.0f, STEERING_PID_I_LIMIT});
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, controller.GetGains().kp);
+    frames = g_SetpointFrames;
+    controller.OnFeedback(plant.GetWheelAngle(), stampUs + FEEDBACK_PERIOD_US);
+    TEST_ASSERT_TRUE(WaitForSetpoint(frames));
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, MapSteer2Motor(STEP_TARGET), g_MotorSetpoint);
+
+    // Proportional only, straight after a big jump in the measurement: no derivative kick
+    controller.SetGains(SteeringGains{1.0f, 0.0f, 1.0f, 1.0f, STEERING_PID_I_LIMIT});
+    frames = g_SetpointFrames;
+    controller.OnFeedback(STEP_TARGET - 0.05f, stampUs + 2 * FEEDBACK_PERIOD_US);
+    TEST_ASSERT_TRUE(WaitForSetpoint(frames));
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, MapSteer2Motor(STEP_TARGET + 0.05f), g_MotorSetpoint);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_vesc_position_step);
+    RUN_TEST(test_mcu_pid_step);
+    RUN_TEST(test_feedback_without_new_target);
+    RUN_TEST(test_gains_updated_while_running);
+    return UNITY_END();
+}
@@ -0,0 +1,158 @@
+/**
+ * @file test_main.cpp
+ * @brief Steering calibration tables against the piecewise-linear STEERING_MAPPING
+ *
+ * The reference is the std::map lookup MapSteer2Motor used before the tables,
+ * so edits to STEERING_MAPPING or STEERING_LUT_SIZE are checked for
+ * monotonicity and for how far the resampled table strays from the points.
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iterator>
+#include <map>
+
+#include <unity.h>
+
+#include "config.hpp"
+#include "Actuation/vesc_can_tools.hpp"
+
+using namespace tritonai::gkc;
+
+namespace {
+
+    constexpr float POINTS[][2] = STEERING_MAPPING;
+    constexpr size_t POINT_COUNT = sizeof(POINTS) / sizeof(POINTS[0]);
+    constexpr float MAX_STEER = POINTS[POINT_COUNT - 1][1];
+    constexpr float MAX_MOTOR = POINTS[POINT_COUNT - 1][0];
+    constexpr int SWEEP_STEPS = 20000;
+
+#ifdef STEERING_LUT_CUBIC
+    constexpr float MAX_MAPPING_ERROR = 5e-2f; // the cubic leaves the straight segments
+    constexpr float MAX_ROUND_TRIP_ERROR = 4e-3f;
+#else
+    constexpr float MAX_MAPPING_ERROR = 1e-2f; // resampling cuts the corners at the points
+    constexpr float MAX_ROUND_TRIP_ERROR = 2e-3f;
+#endif
+
+    // MapSteer2Motor as it was, valid for |steerAngle| <= MAX_STEER only
+    float ReferenceSteer2Motor(float steerAngle) {
+        std::map<float, float> mapping = STEERING_MAPPING;
+        int sign = steerAngle >= 0 ? 1 : -1;
+
+        for (auto it = mapping.begin(); it != mapping.end(); it++) {
+            if ((std::next(it))->second >= sign * steerAngle) {
+                return sign * MapRange<float, float>(sign * steerAngle, it->second, std::next(it)->second,
+                                                     it->first, std::next(it)->first);
+            }
+        }
+        return 0;
+    }
+
+    void Report(const char* what, double value, const char* unit) {
+        char message[96];
+        snprintf(message, sizeof(message), "%s: %.3g %s", what, value, unit);
+        TEST_MESSAGE(message);
+    }
+
+    template <typename F>
+    double CallsPerSecond(F map, float range) {
+        constexpr int ITERATIONS = 1000000;
+        volatile float sink = 0.0f;
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < ITERATIONS; i++) {
+            sink = map(range * (static_cast<float>(i % 2001) / 1000.0f - 1.0f));
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        (void)sink;
+        return ITERATIONS / elapsed.count();
+    }
+
+} // namespace
+
+void setUp() {}
+
+void tearDown() {}
+
+// Both tables only ever increase, so a larger command never steers less
+void test_tables_are_monotonic() {
+    float lastMotor = MapSteer2Motor(-MAX_STEER);
+    float lastSteer = MapMotor2Steer(-MAX_MOTOR);
+    for (int i = 1; i <= SWEEP_STEPS; i++) {
+        const float t = 2.0f * static_cast<float>(i) / SWEEP_STEPS - 1.0f;
+        const float motor = MapSteer2Motor(t * MAX_STEER);
+        const float steer = MapMotor2Steer(t * MAX_MOTOR);
+        TEST_ASSERT_TRUE(motor >= lastMotor);
+        TEST_ASSERT_TRUE(steer >= lastSteer);
+        lastMotor = motor;
+        lastSteer = steer;
+    }
+}
+
+// Zero maps to zero, negative angles mirror positive ones
+void test_tables_are_odd_symmetric() {
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, MapSteer2Motor(0.0f));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, MapMotor2Steer(0.0f));
+    for (int i = 1; i <= 100; i++) {
+        const float steer = MAX_STEER * static_cast<float>(i) / 100.0f;
+        TEST_ASSERT_EQUAL_FLOAT(-MapSteer2Motor(steer), MapSteer2Motor(-steer));
+    }
+}
+
+// Within the calibration, the table stays close to the old piecewise-linear map
+void test_table_matches_reference_mapping() {
+    float maxError = 0.0f;
+    for (int i = 0; i <= SWEEP_STEPS; i++) {
+        const float steer = MAX_STEER * (2.0f * static_cast<float>(i) / SWEEP_STEPS - 1.0f);
+        maxError = std::fmax(maxError, std::fabs(MapSteer2Motor(steer) - ReferenceSteer2Motor(steer)));
+    }
+    Report("max error against the std::map mapping", maxError, "rad");
+    TEST_ASSERT_TRUE(maxError <= MAX_MAPPING_ERROR);
+
+    // The calibration points themselves
+    for (size_t k = 0; k < POINT_COUNT; k++) {
+        TEST_ASSERT_FLOAT_WITHIN(MAX_MAPPING_ERROR, POINTS[k][0], MapSteer2Motor(POINTS[k][1]));
+        TEST_ASSERT_FLOAT_WITHIN(MAX_MAPPING_ERROR, POINTS[k][1], MapMotor2Steer(POINTS[k][0]));
+    }
+}
+
+// The feedback path reports back the angle that was commanded
+void test_round_trip() {
+    float maxError = 0.0f;
+    for (int i = 0; i <= SWEEP_STEPS; i++) {
+        const float steer = MAX_STEER * (2.0f * static_cast<float>(i) / SWEEP_STEPS - 1.0f);
+        maxError = std::fmax(maxError, std::fabs(MapMotor2Steer(MapSteer2Motor(steer)) - steer));
+    }
+    Report("max steer -> motor -> steer error", maxError, "rad");
+    TEST_ASSERT_TRUE(maxError <= MAX_ROUND_TRIP_ERROR);
+}
+
+// Angles beyond the calibration clamp to its last point
+void test_out_of_range_clamps() {
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, MAX_MOTOR, MapSteer2Motor(2.0f * MAX_STEER));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, -MAX_MOTOR, MapSteer2Motor(-2.0f * MAX_STEER));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, MAX_STEER, MapMotor2Steer(10.0f * MAX_MOTOR));
+}
+
+// Lookups per second, against the std::map mapping it replaced
+void test_benchmark() {
+    const double before = CallsPerSecond(ReferenceSteer2Motor, MAX_STEER);
+    const double after = CallsPerSecond(MapSteer2Motor, MAX_STEER);
+    Report("std::map MapSteer2Motor", before, "calls/s");
+    Report("table MapSteer2Motor", after, "calls/s");
+    TEST_ASSERT_TRUE(after > before);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_tables_are_monotonic);
+    RUN_TEST(test_tables_are_odd_symmetric);
+    RUN_TEST(test_table_matches_reference_mapping);
+    RUN_TEST(test_round_trip);
+    RUN_TEST(test_out_of_range_clamps);
+    RUN_TEST(test_benchmark);
+    return UNITY_END();
+}
@@ -0,0 +1,215 @@
+/**
+ * @file test_main.cpp
+ * @brief UartLink rings, and its receive thread against the busy-polling one it replaced
+ *
+ * The benchmark runs each receive loop on its own port while a peer sends
+ * control-sized frames. It measures the receive thread's CPU time and the
+ * time from the peer writing a frame to its parse, interrupt dispatch
+ * included. Host threads are not prioritized, so it shows the CPU a spinning
+ * thread takes but not how it starves others of its priority on the board.
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <mutex>
+#include <vector>
+
+#include <unity.h>
+
+#include "mbed.h"
+#include "mbed_shim/host.hpp"
+
+#include "config.hpp"
+#include "Comm/gkc_frame.hpp"
+#include "Comm/uart_link.hpp"
+
+using namespace tritonai::gkc;
+
+namespace {
+
+    constexpr size_t OLD_RECV_BUFFER_SIZE = 32; // read size of the busy-polling loop
+    constexpr int BENCH_FRAMES = 200;
+    constexpr auto BENCH_PERIOD = std::chrono::milliseconds(5);
+
+    struct RxResult {
+        std::vector<uint32_t> latenciesUs;
+        double cpuUs{0.0};
+        double wallUs{0.0};
+    };
+
+    // Written by the peer before each frame, read when the frame is parsed
+    std::atomic<uint32_t> g_SentUs{0};
+    std::atomic<bool> g_Stop{false};
+
+    double ThreadCpuUs() {
+        timespec now;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+        return now.tv_sec * 1e6 + now.tv_nsec / 1e3;
+    }
+
+    void OnBytes(GkcFrameParser& parser, const uint8_t* data, size_t len, RxResult& result) {
+        for (size_t i = 0; i < len; i++) {
+            if (parser.Push(data[i])) {
+                result.latenciesUs.push_back(us_ticker_read() - g_SentUs.load());
+            }
+        }
+    }
+
+    // CommManager::RecvCallback before the interrupt-driven path
+    void BusyPollLoop(BufferedSerial* serial, RxResult* result) {
+        GkcFrameParser parser;
+        uint8_t buffer[OLD_RECV_BUFFER_SIZE];
+        const double cpuStart = ThreadCpuUs();
+        while (!g_Stop) {
+            if (serial->readable()) {
+                const ssize_t count = serial->read(buffer, sizeof(buffer));
+                if (count > 0) {
+                    OnBytes(parser, buffer, static_cast<size_t>(count), *result);
+                }
+            }
+        }
+        result->cpuUs = ThreadCpuUs() - cpuStart;
+    }
+
+    // CommManager::RecvCallback now
+    void UartLinkLoop(UartLink* link, RxResult* result) {
+        GkcFrameParser parser;
+        const double cpuStart = ThreadCpuUs();
+        while (!g_Stop) {
+            if (!link->WaitReadable(std::chrono::milliseconds(WAIT_READ_MS))) {
+                continue;
+            }
+            uint8_t* data;
+            size_t count;
+            while ((count = link->PeekRx(data)) > 0) {
+                OnBytes(parser, data, count, *result);
+                link->ConsumeRx(count);
+            }
+        }
+        result->cpuUs = ThreadCpuUs() - cpuStart;
+    }
+
+    // Sends BENCH_FRAMES control-sized frames while the loop runs
+    void RunPeer(PinName port, Thread& receiver, RxResult& result) {
+        const uint8_t payload[13] = {GKC_ID_CONTROL, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+        uint8_t frame[sizeof(payload) + GKC_FRAME_OVERHEAD];
+        const size_t size = EncodeFrame(payload, sizeof(payload), frame, sizeof(frame));
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < BENCH_FRAMES; i++) {
+            ThisThread::sleep_for(BENCH_PERIOD);
+            g_SentUs = us_ticker_read();
+            mbed_shim::SerialWrite(port, frame, size);
+        }
+        ThisThread::sleep_for(BENCH_PERIOD);
+        g_Stop = true;
+        receiver.join();
+        result.wallUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        g_Stop = false;
+    }
+
+    uint32_t Percentile(std::vector<uint32_t> values, double percent) {
+        std::sort(values.begin(), values.end());
+        return values[static_cast<size_t>(percent / 100.0 * (values.size() - 1) + 0.5)];
+    }
+
+    void Report(const char* name, const RxResult& result) {
+        char message[160];
+        snprintf(message, sizeof(message), "%s: receive thread %.1f%% of a core, RX to frame p50 %u us, p99 %u us, max %u us",
+                 name, 100.0 * result.cpuUs / result.wallUs, Percentile(result.latenciesUs, 50),
+                 Percentile(result.latenciesUs, 99), Percentile(result.latenciesUs, 100));
+        TEST_MESSAGE(message);
+    }
+
+} // namespace
+
+void setUp() {}
+
+void tearDown() {}
+
+// Bytes come out in order, across the wrap of the ring and split writes
+void test_rx_in_order_across_wrap() {
+    UartLink link(PA_0, PA_1, BAUD_RATE);
+    uint8_t sent[3 * RECV_BUFFER_SIZE];
+    for (size_t i = 0; i < sizeof(sent); i++) {
+        sent[i] = static_cast<uint8_t>(i * 7);
+    }
+
+    std::vector<uint8_t> received;
+    for (size_t offset = 0; offset < sizeof(sent); offset += RECV_BUFFER_SIZE / 2) {
+        mbed_shim::SerialWrite(PA_0, sent + offset, RECV_BUFFER_SIZE / 2);
+        while (received.size() < offset + RECV_BUFFER_SIZE / 2 && link.WaitReadable(std::chrono::milliseconds(100))) {
+            uint8_t* data;
+            const size_t count = link.PeekRx(data);
+            received.insert(received.end(), data, data + count);
+            link.ConsumeRx(count);
+        }
+    }
+    TEST_ASSERT_EQUAL_size_t(sizeof(sent), received.size());
+    TEST_ASSERT_EQUAL_MEMORY(sent, received.data(), sizeof(sent));
+    TEST_ASSERT_EQUAL_UINT32(0, link.GetRxOverflowCount());
+    TEST_ASSERT_FALSE(link.WaitReadable(std::chrono::milliseconds(5)));
+}
+
+// More than the TX ring holds leaves the line in order
+void test_tx_reaches_line() {
+    UartLink link(PB_6, PB_7, BAUD_RATE);
+    std::mutex lock;
+    std::vector<uint8_t> line;
+    mbed_shim::SetSerialTxListener(PB_6, [&](const uint8_t* data, size_t len) {
+        std::lock_guard<std::mutex> guard(lock);
+        line.insert(line.end(), data, data + len);
+    });
+
+    std::vector<uint8_t> sent(SEND_BUFFER_SIZE + 100);
+    for (size_t i = 0; i < sent.size(); i++) {
+        sent[i] = static_cast<uint8_t>(i);
+    }
+    TEST_ASSERT_EQUAL_size_t(sent.size(), link.Write(sent.data(), sent.size()));
+    link.WaitTxIdle(std::chrono::milliseconds(1000));
+    mbed_shim::SetSerialTxListener(PB_6, nullptr);
+
+    std::lock_guard<std::mutex> guard(lock);
+    TEST_ASSERT_EQUAL_size_t(sent.size(), line.size());
+    TEST_ASSERT_EQUAL_MEMORY(sent.data(), line.data(), sent.size());
+}
+
+// The waiting receive thread uses a fraction of the CPU of the polling one,
+// and every frame still arrives
+void test_receive_benchmark() {
+    RxResult polled;
+    {
+        BufferedSerial serial(PC_6, PC_7, BAUD_RATE);
+        serial.set_blocking(false);
+        Thread receiver(osPriorityAboveNormal, OS_STACK_SIZE, nullptr, "busy_poll");
+        receiver.start([&] { BusyPollLoop(&serial, &polled); });
+        RunPeer(PC_6, receiver, polled);
+    }
+
+    RxResult waited;
+    {
+        UartLink link(PD_0, PD_1, BAUD_RATE);
+        Thread receiver(osPriorityAboveNormal, OS_STACK_SIZE, nullptr, "uart_link");
+        receiver.start([&] { UartLinkLoop(&link, &waited); });
+        RunPeer(PD_0, receiver, waited);
+    }
+
+    Report("busy-polling BufferedSerial", polled);
+    Report("UartLink", waited);
+    TEST_ASSERT_EQUAL_size_t(BENCH_FRAMES, polled.latenciesUs.size());
+    TEST_ASSERT_EQUAL_size_t(BENCH_FRAMES, waited.latenciesUs.size());
+    TEST_ASSERT_TRUE(waited.cpuUs * 10 < polled.cpuUs);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_rx_in_order_across_wrap);
+    RUN_TEST(test_tx_reaches_line);
+    RUN_TEST(test_receive_benchmark);
+    return UNITY_END();
+}
@@ -0,0 +1,122 @@
+/**
+ * @file test_main.cpp
+ * @brief Watchdog deadlines: silent, kicked and disarmed watchables
+ *
+ * The watch thread never exits, so the tests share one armed Watchdog and
+ * each adds its own watchables. Disarming ends that, so it runs last.
+ *
+ * @copyright Copyright 2025 Triton AI
+ */
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+#include <unity.h>
+
+#include "mbed.h"
+
+#include "Watchdog/watchdog.hpp"
+
+using namespace tritonai::gkc;
+
+namespace {
+
+    constexpr uint32_t LIMIT_MS = 50;
+    constexpr uint32_t RETRIGGER_MS = 20;
+    constexpr uint32_t TOLERANCE_MS = 15; // host scheduling
+
+    class NullLogger : public ILogger {
+    public:
+        void SendLog(const LogPacket::Severity&, const std::string&) override {}
+    };
+
+    // Counts its triggers instead of resetting
+    class TestWatchable : public Watchable {
+    public:
+        explicit TestWatchable(const char* name) : Watchable(RETRIGGER_MS, LIMIT_MS, name) {
+            Attach(callback(this, &TestWatchable::OnTrigger));
+        }
+
+        uint32_t GetTriggers() const { return m_Triggers; }
+        uint32_t GetFirstTriggerMs() const { return m_FirstTriggerMs; }
+
+    private:
+        void OnTrigger() {
+            if (m_Triggers++ == 0) {
+                m_FirstTriggerMs = NowMs();
+            }
+        }
+
+        std::atomic<uint32_t> m_Triggers{0};
+        std::atomic<uint32_t> m_FirstTriggerMs{0};
+    };
+
+    // Not mbed::Watchdog, the IWDG it feeds
+    tritonai::gkc::Watchdog& GetWatchdog() {
+        static NullLogger logger;
+        static tritonai::gkc::Watchdog* watchdog = [] {
+            auto* created = new tritonai::gkc::Watchdog(100, 1000, &logger);
+            created->Arm();
+            return created;
+        }();
+        return *watchdog;
+    }
+
+    // Watched from now on, as if it had been registered before Arm
+    TestWatchable* Watch(const char* name) {
+        TestWatchable* watchable = new TestWatchable(name);
+        watchable->Activate();
+        GetWatchdog().AddToWatchlist(watchable);
+        return watchable;
+    }
+
+} // namespace
+
+void setUp() {}
+
+void tearDown() {}
+
+// A silent watchable triggers at its limit, then every update interval
+void test_silent_watchable_triggers() {
+    TestWatchable* watchable = Watch("Silent");
+    const uint32_t startMs = Watchable::NowMs();
+
+    ThisThread::sleep_for(std::chrono::milliseconds(LIMIT_MS + TOLERANCE_MS));
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(1, watchable->GetTriggers());
+    TEST_ASSERT_UINT32_WITHIN(TOLERANCE_MS, LIMIT_MS, watchable->GetFirstTriggerMs() - startMs);
+
+    ThisThread::sleep_for(std::chrono::milliseconds(5 * RETRIGGER_MS));
+    TEST_ASSERT_UINT32_WITHIN(2, 6, watchable->GetTriggers());
+}
+
+// Kicks move the deadline, a watchable kicked in time never triggers
+void test_kicked_watchable_does_not_trigger() {
+    TestWatchable* watchable = Watch("Kicked");
+    for (int i = 0; i < 10; i++) {
+        ThisThread::sleep_for(std::chrono::milliseconds(LIMIT_MS / 2));
+        watchable->IncCount();
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, watchable->GetTriggers());
+
+    // Then it goes silent
+    ThisThread::sleep_for(std::chrono::milliseconds(LIMIT_MS + TOLERANCE_MS));
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(1, watchable->GetTriggers());
+}
+
+// Disarm deactivates every watchable, none triggers afterwards
+void test_disarmed_watchable_does_not_trigger() {
+    TestWatchable* watchable = Watch("Disarmed");
+    GetWatchdog().Disarm();
+    ThisThread::sleep_for(std::chrono::milliseconds(3 * LIMIT_MS));
+    TEST_ASSERT_FALSE(watchable->IsActivated());
+    TEST_ASSERT_EQUAL_UINT32(0, watchable->GetTriggers());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_silent_watchable_triggers);
+    RUN_TEST(test_kicked_watchable_does_not_trigger);
+    RUN_TEST(test_disarmed_watchable_does_not_trigger);
+    return UNITY_END();
+}